@@ -20,6 +20,7 @@
 #define AS7341_STAT 0x71
 #define AS7341_STAT_READY 0x01
 #define AS7341_STAT_WAIT_SYNC 0x02
+#define AS7341_ITIME_L 0x63
 #define AS7341_EDGE 0x72
 #define AS7341_GPIO 0x73
 #define AS7341_GPIO_PD_INT 0x01
@@ -70,6 +71,7 @@
 #define AS7341_STATUS_3 0xA4
 #define AS7341_STATUS_5 0xA6
 #define AS7341_STATUS_6 0xA7
+#define AS7341_STATUS_6_FIFO_OV 0x80
 #define AS7341_CFG_0 0xA9
 #define AS7341_CFG_0_WLONG 0x04
 #define AS7341_CFG_0_REG_BANK 0x10
@@ -98,6 +100,7 @@
 #define AS7341_FD_TIME_1 0xD8
 #define AS7341_FD_TIME_2 0xDA
 #define AS7341_FD_CFG0 0xD7
+#define AS7341_FD_CFG0_FIFO_WRITE_FD 0x80
 #define AS7341_FD_STATUS 0xDB
 #define AS7341_FD_STATUS_FD_100HZ 0x01
 #define AS7341_FD_STATUS_FD_120HZ 0x02
@@ -107,18 +110,75 @@
 #define AS7341_FD_STATUS_FD_MEAS_VALID 0x20
 #define AS7341_INTENAB 0xF9
 #define AS7341_INTENAB_SP_IEN 0x08
+#define AS7341_INT_PIN_NONE -1
 #define AS7341_CONTROL 0xFA
+#define AS7341_CONTROL_CLEAR_FIFO 0x02
 #define AS7341_FIFO_MAP 0xFC
 #define AS7341_FIFO_LVL 0xFD
 #define AS7341_FDATA 0xFE
 #define AS7341_FDATA_L 0xFE
 #define AS7341_FDATA_H 0xFF
+#define AS7341_FIFO_SIZE 128 // Entries of 16 bit
+#define AS7341_FIFO_BURST 64 // Entries per burst read: 128 bytes, the whole Wire buffer
+#define AS7341_FD_GAIN_MAX 10
+
+// Timing (datasheet minimums; everything else is completion-driven)
+#define AS7341_PON_SETTLE_US 200      // Oscillator start-up after PON
+#define AS7341_SMUX_TIMEOUT_MS 20     // SMUX command normally completes well within 1 ms
+#define AS7341_SMUX_POLL_US 100       // ENABLE.SMUXEN poll interval
+#define AS7341_AVALID_TIMEOUT_MS 1000 // Upper bound on one spectral cycle
+#define AS7341_AVALID_POLL_US 500     // STATUS_2.AVALID poll interval after integration
+#define AS7341_FD_POLL_US 10000       // FD_STATUS poll interval
+#define AS7341_FD_TIME_STEP_NS 1388   // One FD_TIME step (FD sample period = (FD_TIME + 1) steps)
+#define AS7341_IRQ_SPIN_US 20         // Wake-up granularity while waiting on the INT line
+#define AS7341_WTIME_STEP_US 2780     // One WTIME step, x16 with CFG_0.WLONG
+#define AS7341_SYNC_POLL_US 1000      // STAT.WAIT_SYNC poll interval while armed
+#define AS7341_SYNC_PULSE_US 2        // Low time of a sync pulse from the trigger pin
+
+// Register shadow cache covers the configuration registers from CONFIG upwards
+#define AS7341_SHADOW_BASE 0x70
+#define AS7341_SHADOW_SIZE (0x100 - AS7341_SHADOW_BASE)
+
+// Non-blocking measurement states returned by poll()
+#define AS7341_MEASURE_IDLE 0
+#define AS7341_MEASURE_SMUX 1
+#define AS7341_MEASURE_INTEGRATING 2
+#define AS7341_MEASURE_READY 3
+#define AS7341_MEASURE_TIMEOUT 4
+#define AS7341_MEASURE_WAIT_SYNC 5 // SYNS/SYND: armed, waiting for the sync edge
+
+// Events reported to the timing callback
+#define AS7341_TIMING_SMUX 0        // SMUX command issued until it completed
+#define AS7341_TIMING_INTEGRATION 1 // Integration started until its data was seen ready
+#define AS7341_TIMING_READOUT 2     // result(): the channel read-out
+#define AS7341_TIMING_REG_READ 3    // One read transaction
+#define AS7341_TIMING_REG_WRITE 4   // One write transaction
+#define AS7341_TIMING_EVENTS 5
+
+typedef void (*AS7341TimingFn)(void *arg, uint8_t event, uint32_t micros);
 
 // SMUX configurations
 extern const uint8_t SMUX_F1F4CN[20];
 extern const uint8_t SMUX_F5F8CN[20];
 extern const uint8_t SMUX_FD[20];
 
+// Complete measurement configuration. AS7341::apply() writes only the
+// registers whose value differs from what the device already holds.
+struct SensorConfig
+{
+    uint8_t gain;            // AGAIN code 0-10 (0.5x - 512x)
+    uint8_t atime;           // Integration steps - 1
+    uint16_t astep;          // Step length in 2.78 us units - 1
+    uint8_t wtime;           // Wait between cycles with WEN, 2.78 ms units - 1
+    uint16_t ledCurrent;     // LED drive in mA (4-258); on/off stays with enableLED()
+    uint8_t mode;            // AS7341_MODE_SPM, _SYNS or _SYND
+    uint16_t thresholdLow;   // Spectral interrupt thresholds
+    uint16_t thresholdHigh;
+    uint8_t persistence;     // APERS, 0 = interrupt on every cycle
+
+    SensorConfig();
+};
+
 class AS7341
 {
 public:
@@ -126,14 +186,48 @@ public:
     bool begin();
     bool isConnected();
     void setMeasureMode(uint8_t mode);
+    uint8_t getMeasureMode();
     void setGain(uint8_t gain);
     void setATime(uint8_t atime);
     void setAStep(uint16_t astep);
     void startMeasure(const char *selection);
+
+    // Apply a whole configuration at once. Returns the number of registers
+    // written; 0 when the device already matched.
+    uint8_t apply(const SensorConfig &config);
+
+    // Non-blocking measurement: beginMeasure(), then poll() until it returns
+    // AS7341_MEASURE_READY and collect the six channels with result()
+    void beginMeasure(const char *selection);
+    uint8_t poll();
+    bool result(uint16_t *data, uint8_t *astatus = NULL);
+    uint32_t nextPollMicros();
+
+    // Free-running mode: with WEN set the sensor keeps cycling through
+    // integration and wait on its own. continueMeasure() waits for the next
+    // cycle of the running measurement without reprogramming the SMUX.
+    void continueMeasure();
+    void setWaitMicros(uint32_t us);
+    uint32_t getWaitMicros();
+
+    // External sync (SYNS/SYND). The integration starts on a falling edge at
+    // the sensor's GPIO pin; in SYND it ends on the n-th following edge set
+    // with setSyncEdges(). The edge can come from an external strobe, from a
+    // second device, or from an MCU pin registered with setSyncTriggerPin()
+    // and pulsed by triggerSync() in step with the light source. With that
+    // pin in SYND, poll() issues the following edges itself, spread evenly
+    // over the programmed ATIME x ASTEP.
+    void setSyncEdges(uint8_t edges);
+    void setSyncTimeout(uint32_t ms); // 0 waits for the sync edge indefinitely
+    void setSyncTriggerPin(int pin);
+    void triggerSync();
+    bool waitingForSync();
+    uint32_t getSyncIntegrationMicros(); // SYND: integration time measured by the sensor
+    uint32_t getSyncCaptures();
     uint16_t getChannelData(uint8_t channel);
     void getSpectralData(uint16_t *data);
     void enableLED(bool enable);
-    void setLEDCurrent(uint8_t current);
+    void setLEDCurrent(uint16_t current);
 
     // Additional methods from Python implementation
     void disable();
@@ -142,12 +236,24 @@ public:
     void setSmux(bool flag);
     uint8_t getFlickerFrequency();
     void setFlickerDetection(bool flag);
+
+    // Raw flicker waveform: the FD engine samples the flicker photodiode
+    // every (FD_TIME + 1) x 1.388 us and queues the samples in the 128-entry
+    // FIFO. beginFlickerCapture() returns the sample rate actually set;
+    // readFifo() pops up to AS7341_FIFO_BURST entries in one transfer.
+    float beginFlickerCapture(float sampleRateHz, uint8_t gain);
+    void endFlickerCapture();
+    uint8_t getFifoLevel();
+    uint8_t readFifo(uint16_t *data, uint8_t count);
+    bool fifoOverflow();
     void setGpioInput(bool enable);
     bool getGpioValue();
     void setGpioOutput(bool inverted);
     void setGpioInverted(bool flag);
     void setGpioMask(uint8_t mask);
     float getIntegrationTime();
+    uint8_t getATime();
+    uint16_t getAStep();
     uint8_t getAgain();
     float getAgainFactor();
     void setAgainFactor(float factor);
@@ -161,6 +267,33 @@ public:
     void setThresholds(uint16_t lo, uint16_t hi);
     void getSynsInt();
 
+    // Drop all shadowed register values (e.g. after an external reset)
+    void invalidateCache();
+
+    // Measurements whose SMUX setup was skipped because the selection was
+    // still loaded from the previous one
+    uint32_t getSmuxSkips();
+
+    // Time actually spent blocked (sleeping or polling) by the driver
+    uint32_t getLastBlockedMicros();
+    uint32_t getTotalBlockedMicros();
+
+    // I2C clock of the bus the sensor is on (Hz)
+    uint32_t getBusClock();
+
+    // Measurement completion signalled on the INT line instead of polling
+    // STATUS_2. The pin must be wired to the sensor's open-drain INT output.
+    void enableMeasurementInterrupt(int pin);
+    void disableMeasurementInterrupt();
+    bool interruptPending();
+    uint32_t getInterruptWakeups();
+    uint32_t getInterruptTimeouts();
+    uint32_t getCompletionPolls();
+
+    // Durations of measurement phases and bus transactions, in micros(),
+    // for latency statistics. NULL (the default) turns the timing off.
+    void setTimingCallback(AS7341TimingFn fn, void *arg);
+
 private:
     TwoWire *_wire;
     uint8_t _address;
@@ -169,16 +302,97 @@ private:
     uint8_t _currentGain;
     uint8_t _currentATime;
 
+    // Write-through shadow of the configuration registers
+    uint8_t _shadow[AS7341_SHADOW_SIZE];
+    uint8_t _shadowValid[AS7341_SHADOW_SIZE / 8];
+
+    // SMUX configuration currently loaded (NULL: unknown)
+    const uint8_t *_smuxLoaded;
+    uint32_t _smuxSkips;
+
+    // Blocked time bookkeeping
+    uint32_t _callBlockedUs;
+    uint32_t _lastBlockedUs;
+    uint32_t _totalBlockedUs;
+    uint8_t _callDepth;
+
+    // Non-blocking measurement state
+    uint8_t _measureState;
+    unsigned long _measureStart;
+    unsigned long _nextPollAt;
+    uint32_t _integrationUs;
+
+    // External sync
+    uint8_t _syncEdges;
+    uint8_t _syncEdgesSeen;
+    uint32_t _syncTimeoutMs;
+    int _syncTriggerPin;
+    uint32_t _syncIntegrationUs;
+    uint32_t _syncCaptures;
+    void syncStarted(unsigned long edgeAt);
+
+    // Completion interrupt
+    int _interruptPin;
+    volatile bool _interruptPending;
+    uint32_t _interruptWakeups;
+    uint32_t _interruptTimeouts;
+    uint32_t _completionPolls;
+    bool _interruptMissed;
+    static void onInterrupt(void *arg);
+
+    // Timing callback
+    AS7341TimingFn _timing;
+    void *_timingArg;
+    void timed(uint8_t event, unsigned long start);
+
+    // Scope guard placed at the top of every public call that may block.
+    // Nested calls fold into the outermost one.
+    struct BlockingScope
+    {
+        BlockingScope(AS7341 *device);
+        ~BlockingScope();
+        AS7341 *_device;
+    };
+
+    // Reports the duration of the enclosing block to the timing callback
+    struct TimingScope
+    {
+        TimingScope(AS7341 *device, uint8_t event);
+        ~TimingScope();
+        AS7341 *_device;
+        uint8_t _event;
+        unsigned long _start;
+    };
+
     // I2C communication methods
     uint8_t readByte(uint8_t reg);
     uint16_t readWord(uint8_t reg);
-    void readAllChannels(uint16_t *data);
+    uint8_t readAllChannels(uint16_t *data);
     bool writeByte(uint8_t reg, uint8_t value);
     bool writeWord(uint8_t reg, uint16_t value);
     bool writeBurst(uint8_t reg, const uint8_t *data, uint8_t length);
+    uint8_t writeDirty(const uint8_t *regs, const uint8_t *values, uint8_t count);
     void modifyReg(uint8_t reg, uint8_t mask, bool flag);
+
+    // Shadowed register access
+    uint8_t readReg(uint8_t reg);
+    bool writeReg(uint8_t reg, uint8_t value);
+    bool isShadowed(uint8_t reg);
+    uint8_t volatileBits(uint8_t reg);
+    bool shadowKnown(uint8_t reg);
+    bool shadowMatches(uint8_t reg, uint8_t value);
+    void updateShadow(uint8_t reg, uint8_t value);
+    void invalidateReg(uint8_t reg);
+
+    // Timing layer
+    void sleepMicros(uint32_t us);
+    bool waitForBits(uint8_t reg, uint8_t mask, bool set, uint32_t timeoutMs, uint32_t pollUs, uint8_t *value = NULL);
+    bool waitSmuxComplete();
+    void startIntegration();
+    uint32_t integrationMicros();
     void setBank(uint8_t bank);
     void channelSelect(const char *selection);
+    static const uint8_t *smuxConfig(const char *selection);
 };
 
 #endif
@@ -0,0 +1,435 @@
+#include "Acquisition.h"
+
+static const char *const halfSelection[2] = {"F1F4CN", "F5F8CN"};
+
+Acquisition::Acquisition(AS7341 &sensor)
+{
+    _sensor = &sensor;
+    _state = ACQ_IDLE;
+    _ledEnabled = true;
+    _ledCurrent = 25; // mA
+    _syncTrigger = false;
+    _continuous = false;
+    _periodMs = 1000;
+    _waitTrimUs = 0;
+    _lastPublishUs = 0;
+    _half = 0;
+    _continued = false;
+    _discard = false;
+    _runAtime = 0;
+    _runAstep = 0;
+    _discarded = 0;
+    memset(&_frame, 0, sizeof(_frame));
+    memset(&_empty, 0, sizeof(_empty));
+    _sequence = 0;
+    _errors = 0;
+    _darks = NULL;
+    _darkCorrected = false;
+    _flicker = NULL;
+    _flickerIntervalMs = 0;
+    _flickerRequested = false;
+    _resumeAt = 0;
+}
+
+void Acquisition::setLED(bool enable, uint16_t current)
+{
+    _ledEnabled = enable;
+    _ledCurrent = current;
+}
+
+void Acquisition::setDarkFrames(DarkFrames *darks)
+{
+    _darks = darks;
+}
+
+void Acquisition::setFlicker(FlickerAnalyzer *flicker, uint32_t intervalMs)
+{
+    if (_flicker != NULL && _flicker != flicker)
+    {
+        _flicker->cancel();
+    }
+    _flicker = flicker;
+    _flickerIntervalMs = intervalMs;
+}
+
+void Acquisition::refreshFlicker()
+{
+    _flickerRequested = true;
+}
+
+bool Acquisition::flickerPending()
+{
+    return _flicker != NULL && (_flicker->busy() || flickerDue());
+}
+
+void Acquisition::setSyncTrigger(bool enable)
+{
+    _syncTrigger = enable;
+}
+
+void Acquisition::setContinuous(bool enable, uint32_t periodMs)
+{
+    if (!enable && _continuous && busy())
+    {
+        stop();
+    }
+    _continuous = enable;
+    setPeriod(periodMs);
+}
+
+void Acquisition::setPeriod(uint32_t periodMs)
+{
+    if (periodMs != _periodMs)
+    {
+        _waitTrimUs = 0;
+    }
+    _periodMs = periodMs < ACQ_MIN_PERIOD_MS ? ACQ_MIN_PERIOD_MS : periodMs;
+    if (_continuous && busy())
+    {
+        programWait();
+    }
+}
+
+bool Acquisition::continuous()
+{
+    return _continuous;
+}
+
+uint32_t Acquisition::period()
+{
+    return _periodMs;
+}
+
+bool Acquisition::start()
+{
+    if (busy())
+    {
+        return false;
+    }
+    if (_flicker != NULL)
+    {
+        _flicker->cancel();
+    }
+
+    if (_ledEnabled)
+    {
+        _sensor->enableLED(true);
+        _sensor->setLEDCurrent(_ledCurrent);
+    }
+
+    if (_continuous)
+    {
+        _waitTrimUs = 0;
+        _lastPublishUs = 0;
+        programWait();
+    }
+    _sensor->setWen(_continuous);
+
+    // One-shot captures always start with F1-F4 + Clear + NIR
+    beginHalf(_continuous ? _half : 0);
+    _state = ACQ_SMUX_1;
+    return true;
+}
+
+void Acquisition::stop()
+{
+    if (!busy())
+    {
+        return;
+    }
+    if (_state == ACQ_FLICKER)
+    {
+        _flicker->cancel();
+    }
+    _sensor->setSpectralMeasurement(false);
+    _sensor->setWen(false);
+    if (_ledEnabled)
+    {
+        _sensor->enableLED(false);
+    }
+    _state = ACQ_IDLE;
+}
+
+bool Acquisition::update()
+{
+    switch (_state)
+    {
+    case ACQ_IDLE:
+        serviceFlicker();
+        break;
+
+    case ACQ_FLICKER:
+        if (_flicker->busy())
+        {
+            _flicker->update();
+        }
+        else if ((long)(micros() - _resumeAt) >= 0)
+        {
+            resumeAfterFlicker();
+        }
+        break;
+
+    case ACQ_SMUX_1:
+    case ACQ_INTEGRATE_1:
+        track(ACQ_SMUX_1, ACQ_INTEGRATE_1, ACQ_READ_1);
+        break;
+
+    case ACQ_WAIT:
+        track(ACQ_WAIT, ACQ_WAIT, ACQ_READ_1);
+        break;
+
+    case ACQ_READ_1:
+        readHalf();
+        // A first phase restarted by continueMeasure() integrated with
+        // whatever was programmed when it began. If the settings changed
+        // after the restart its exposure is unknown: drop the frame.
+        _discard = _continued && (_sensor->getATime() != _runAtime || _sensor->getAStep() != _runAstep);
+        beginHalf(_half ^ 1);
+        _state = ACQ_SMUX_2;
+        break;
+
+    case ACQ_SMUX_2:
+    case ACQ_INTEGRATE_2:
+        track(ACQ_SMUX_2, ACQ_INTEGRATE_2, ACQ_READ_2);
+        break;
+
+    case ACQ_READ_2:
+        readHalf();
+        if (_ledEnabled && !_continuous)
+        {
+            _sensor->enableLED(false);
+        }
+        _state = ACQ_PUBLISH;
+        break;
+
+    case ACQ_PUBLISH:
+        if (_discard)
+        {
+            _discarded++;
+        }
+        else
+        {
+            publish();
+        }
+        if (_continuous && beginFlickerGap())
+        {
+            _state = ACQ_FLICKER;
+        }
+        else if (_continuous)
+        {
+            retime();
+            // The sensor is still running on the second half; let the wait
+            // timer pace the next frame and start it from that half
+            _runAtime = _sensor->getATime();
+            _runAstep = _sensor->getAStep();
+            _sensor->continueMeasure();
+            _continued = true;
+            _state = ACQ_WAIT;
+        }
+        else
+        {
+            _state = ACQ_IDLE;
+        }
+        return !_discard;
+
+    default:
+        break;
+    }
+    return false;
+}
+
+void Acquisition::beginHalf(uint8_t half)
+{
+    _half = half;
+    _continued = false;
+
+    // Settings are only changed between frames, so this is what both
+    // phases integrate with (free: served from the register shadow)
+    _frame.atime = _sensor->getATime();
+    _frame.astep = _sensor->getAStep();
+    _frame.mode = _sensor->getMeasureMode();
+    _sensor->beginMeasure(halfSelection[half]);
+}
+
+void Acquisition::readHalf()
+{
+    _sensor->result(_frame.adc[_half], &_frame.astatus[_half]);
+    _frame.phaseMicros[_half] = micros();
+}
+
+void Acquisition::programWait()
+{
+    // Two integrations per frame, the wait timer fills the remainder
+    uint32_t integrationUs = _sensor->getIntegrationTime() * 1000;
+    long waitUs = (long)(_periodMs * 1000) - 2 * (long)integrationUs + _waitTrimUs;
+    _sensor->setWaitMicros(waitUs > 0 ? waitUs : 0);
+}
+
+void Acquisition::retime()
+{
+    // The SMUX switch and readouts add to every frame; steer the wait
+    // timer by half the measured error so the cadence settles on the period
+    unsigned long now = micros();
+    if (_lastPublishUs != 0)
+    {
+        long errorUs = (long)(_periodMs * 1000) - (long)(now - _lastPublishUs);
+        long limitUs = _periodMs * 1000;
+        _waitTrimUs += errorUs / 2;
+        _waitTrimUs = _waitTrimUs > limitUs ? limitUs : (_waitTrimUs < -limitUs ? -limitUs : _waitTrimUs);
+        programWait();
+    }
+    _lastPublishUs = now;
+}
+
+void Acquisition::publish()
+{
+    _frame.sequence = ++_sequence;
+    _darkCorrected = _darks != NULL && _darks->correct(_frame);
+    _frames.push(_frame);
+}
+
+bool Acquisition::flickerDue()
+{
+    if (_flicker == NULL || _flicker->busy())
+    {
+        return false;
+    }
+    long age = _flicker->age();
+    return _flickerRequested || (_flickerIntervalMs > 0 && (age < 0 || (uint32_t)age >= _flickerIntervalMs));
+}
+
+void Acquisition::serviceFlicker()
+{
+    // Between one-shot frames the sensor is free
+    if (_flicker == NULL)
+    {
+        return;
+    }
+    if (_flicker->busy())
+    {
+        _flicker->update();
+    }
+    else if (flickerDue())
+    {
+        _flickerRequested = false;
+        _flicker->start();
+    }
+}
+
+bool Acquisition::beginFlickerGap()
+{
+    // The next frame has to be published one period after this one. Its
+    // first phase takes as long as this frame's second one did (SMUX,
+    // integration and readout), so that is when it must start; the
+    // flicker capture only runs if it fits before. Synced frames start on
+    // external edges and have no gap to plan with.
+    if (!flickerDue() || _sensor->getMeasureMode() != AS7341_MODE_SPM)
+    {
+        return false;
+    }
+    unsigned long now = micros();
+    long phaseUs = (long)(now - _frame.phaseMicros[_half ^ 1]);
+    long gapUs = (long)(_periodMs * 1000) - 2 * phaseUs;
+    if (gapUs < (long)(_flicker->durationMicros() + ACQ_FLICKER_GUARD_US))
+    {
+        return false;
+    }
+
+    // Stop the free-running cycle; the ambient light is what flickers
+    if (_ledEnabled)
+    {
+        _sensor->enableLED(false);
+    }
+    _flickerRequested = false;
+    _flicker->start();
+    _resumeAt = now + gapUs;
+    return true;
+}
+
+void Acquisition::resumeAfterFlicker()
+{
+    // The SMUX now routes the flicker pixel, so this frame pays for its
+    // SMUX setup. The gap threw the cadence off by design: skip one retime.
+    if (_ledEnabled)
+    {
+        _sensor->enableLED(true);
+        _sensor->setLEDCurrent(_ledCurrent);
+    }
+    _lastPublishUs = 0;
+    beginHalf(_half);
+    _state = ACQ_SMUX_1;
+}
+
+void Acquisition::track(uint8_t smuxState, uint8_t integrateState, uint8_t readState)
+{
+    switch (_sensor->poll())
+    {
+    case AS7341_MEASURE_SMUX:
+        _state = smuxState;
+        break;
+    case AS7341_MEASURE_INTEGRATING:
+        _state = integrateState;
+        break;
+    case AS7341_MEASURE_WAIT_SYNC:
+        // SYNS/SYND: the integration starts with the external edge
+        _state = integrateState;
+        if (_syncTrigger)
+        {
+            _sensor->triggerSync();
+        }
+        break;
+    case AS7341_MEASURE_READY:
+        _state = readState;
+        break;
+    default:
+        abort();
+        break;
+    }
+}
+
+void Acquisition::abort()
+{
+    _errors++;
+    stop();
+}
+
+bool Acquisition::busy()
+{
+    return _state != ACQ_IDLE;
+}
+
+uint8_t Acquisition::state()
+{
+    return _state;
+}
+
+uint32_t Acquisition::discarded()
+{
+    return _discarded;
+}
+
+uint32_t Acquisition::errors()
+{
+    return _errors;
+}
+
+const SpectralFrame &Acquisition::latest()
+{
+    const SpectralFrame *frame = _frames.latest();
+    return frame != NULL ? *frame : _empty;
+}
+
+uint32_t Acquisition::sequence()
+{
+    return _sequence;
+}
+
+bool Acquisition::darkCorrected()
+{
+    return _darkCorrected;
+}
+
+FrameRing &Acquisition::frames()
+{
+    return _frames;
+}
@@ -0,0 +1,114 @@
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+#include "SpectralFrame.h"
+#include "DarkFrames.h"
+#include "FlickerAnalyzer.h"
+
+// Acquisition states. Phase 1 and 2 are the two SMUX halves of a frame in
+// the order they are captured; in continuous mode that order alternates.
+#define ACQ_IDLE 0
+#define ACQ_SMUX_1 1      // First phase SMUX command running
+#define ACQ_INTEGRATE_1 2 // First phase integration
+#define ACQ_READ_1 3      // First phase readout, then program the other half
+#define ACQ_SMUX_2 4      // Second phase SMUX command running
+#define ACQ_INTEGRATE_2 5 // Second phase integration
+#define ACQ_READ_2 6      // Second phase readout
+#define ACQ_PUBLISH 7     // Map both phases to the spectrum
+#define ACQ_WAIT 8        // Continuous: sensor wait timer, then next integration
+#define ACQ_FLICKER 9     // Continuous: flicker capture in the gap before the next frame
+
+#define ACQ_MIN_PERIOD_MS 10
+#define ACQ_FLICKER_GUARD_US 5000 // Slack for the flicker capture to finish in its gap
+
+// Two-phase spectral capture run as a state machine from loop().
+// Each update() call does at most one short I2C step, so the web server,
+// buttons and display keep running while the sensor integrates.
+//
+// In continuous mode the sensor free-runs with WEN set and the wait timer
+// spaces frames to the requested period. Each frame reuses the SMUX half
+// left programmed by the previous frame and switches only once, so a frame
+// costs one SMUX command instead of two. Settings applied while it runs
+// take effect from the next frame; a frame whose first phase may already
+// have been integrating when they were written is dropped.
+//
+// A flicker analyser can be attached as a background job. Its result is
+// refreshed whenever it gets older than the set interval: while idle after
+// a one-shot frame, or in continuous mode in the wait between two frames
+// if the wait is long enough to hold it. Frames are never delayed; a new
+// capture cancels a flicker capture that is still running.
+class Acquisition
+{
+public:
+    Acquisition(AS7341 &sensor);
+
+    void setLED(bool enable, uint16_t current);
+    void setSyncTrigger(bool enable); // SYNS: pulse the sensor's trigger pin once armed
+    // Dark references subtracted from every published frame (NULL: raw frames)
+    void setDarkFrames(DarkFrames *darks);
+    void setFlicker(FlickerAnalyzer *flicker, uint32_t intervalMs);
+    void refreshFlicker(); // Due at the next opportunity, whatever its age
+    bool flickerPending();
+    void setContinuous(bool enable, uint32_t periodMs);
+    void setPeriod(uint32_t periodMs);
+    bool continuous();
+    uint32_t period();
+
+    bool start(); // Returns false if a capture is already running
+    void stop();
+    bool update(); // Returns true when a new spectrum has been published
+    bool busy();
+    uint8_t state();
+    uint32_t errors();
+    uint32_t discarded(); // Continuous frames dropped for a settings change mid-frame
+
+    // Last published frame (all zero before the first capture)
+    const SpectralFrame &latest();
+    uint32_t sequence();
+    bool darkCorrected(); // A dark reference was subtracted from the latest frame
+    FrameRing &frames();
+
+private:
+    AS7341 *_sensor;
+    uint8_t _state;
+    bool _ledEnabled;
+    uint16_t _ledCurrent;
+    bool _syncTrigger;
+    bool _continuous;
+    uint32_t _periodMs;
+    long _waitTrimUs;            // Correction for the readout and SMUX time per frame
+    unsigned long _lastPublishUs;
+    uint8_t _half; // SMUX half currently programmed: 0 = F1F4CN, 1 = F5F8CN
+    bool _continued;     // First phase restarted by continueMeasure(), not beginHalf()
+    bool _discard;       // The frame being captured will not be published
+    uint8_t _runAtime;   // Settings at that restart
+    uint16_t _runAstep;
+    uint32_t _discarded;
+    SpectralFrame _frame; // Being captured
+    SpectralFrame _empty;
+    uint32_t _sequence;
+    uint32_t _errors;
+    FrameRing _frames;
+    DarkFrames *_darks;
+    bool _darkCorrected;
+    FlickerAnalyzer *_flicker;
+    uint32_t _flickerIntervalMs;
+    bool _flickerRequested;
+    unsigned long _resumeAt; // Start of the frame after a flicker gap
+
+    void beginHalf(uint8_t half);
+    void readHalf();
+    void programWait();
+    void retime();
+    void publish();
+    void track(uint8_t smuxState, uint8_t integrateState, uint8_t readState);
+    void abort();
+    bool flickerDue();
+    void serviceFlicker();
+    bool beginFlickerGap();
+    void resumeAfterFlicker();
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "AutoExposure.h"
+
+AutoExposure::AutoExposure()
+{
+    setTarget(AE_DEFAULT_TARGET);
+    _atimeMin = 0;
+    _atimeMax = 255;
+    reset();
+}
+
+void AutoExposure::setTarget(float fill)
+{
+    _target = fill;
+    // Gain moves in factors of two, so the next capture lands in
+    // [target / 2, target]; accept a little below that
+    _low = fill * 0.45f;
+}
+
+void AutoExposure::setATimeLimits(uint8_t atimeMin, uint8_t atimeMax)
+{
+    _atimeMin = atimeMin;
+    _atimeMax = atimeMax < atimeMin ? atimeMin : atimeMax;
+}
+
+void AutoExposure::reset()
+{
+    _converged = false;
+    _limited = false;
+    _iterations = 0;
+    _lastFill = 0;
+}
+
+float AutoExposure::gainFactor(uint8_t code)
+{
+    return code == 0 ? 0.5f : (float)(1UL << (code - 1));
+}
+
+bool AutoExposure::update(const SpectralFrame &frame, SensorConfig &config)
+{
+    // After convergence the count restarts with the next change of scene
+    if (_converged)
+    {
+        _iterations = 0;
+    }
+    _iterations++;
+
+    uint32_t steps = (frame.atime + 1UL) * (frame.astep + 1UL);
+    uint32_t fullScale = steps < 65535 ? steps : 65535;
+
+    // Light per unit gain and step, from the brightest ADC of either phase.
+    // The gain comes from ASTATUS, i.e. what the sensor actually used.
+    float rate = 0;
+    uint16_t peak = 0;
+    for (uint8_t phase = 0; phase < SPECTRAL_PHASES; phase++)
+    {
+        uint16_t phasePeak = 0;
+        for (uint8_t adc = 0; adc < SPECTRAL_ADCS; adc++)
+        {
+            phasePeak = frame.adc[phase][adc] > phasePeak ? frame.adc[phase][adc] : phasePeak;
+        }
+        float phaseRate = (phasePeak > 0 ? phasePeak : 1) / (gainFactor(frame.gain(phase)) * steps);
+        rate = phaseRate > rate ? phaseRate : rate;
+        peak = phasePeak > peak ? phasePeak : peak;
+    }
+
+    bool saturated = frame.saturated() || peak >= fullScale;
+    _lastFill = (float)peak / fullScale;
+    if (!saturated && _lastFill >= _low && _lastFill <= AE_HIGH_LIMIT)
+    {
+        _converged = true;
+        _limited = false;
+        return true;
+    }
+    _converged = false;
+
+    if (saturated)
+    {
+        // The counts only give a lower bound on the light level
+        rate *= AE_SATURATION_STEP;
+    }
+
+    // Longest integration in budget first: in the uncapped range the fill
+    // level only depends on gain, longer integrations add counts (SNR)
+    // until the 16-bit limit is reached
+    uint8_t atime = _atimeMax;
+    uint16_t astep = config.astep;
+    uint8_t code = 0;
+    while (true)
+    {
+        uint32_t newSteps = (atime + 1UL) * (astep + 1UL);
+        uint32_t newScale = newSteps < 65535 ? newSteps : 65535;
+        float desired = _target * newScale;
+
+        // Largest gain whose predicted peak stays at or below the target
+        code = 0;
+        while (code < AE_MAX_GAIN_CODE && rate * gainFactor(code + 1) * newSteps <= desired)
+        {
+            code++;
+        }
+
+        // Too bright even at 0.5x: shorten the integration while that
+        // still lowers the fill (only true above the 16-bit cap)
+        float fill = rate * gainFactor(code) * newSteps / newScale;
+        if (code > 0 || fill <= AE_HIGH_LIMIT || atime <= _atimeMin || newSteps <= 65535)
+        {
+            break;
+        }
+        atime--;
+    }
+
+    // Another capture with the same settings would not tell us more
+    _limited = code == frame.gain(SPECTRAL_PHASE_F1F4) && atime == frame.atime;
+    config.gain = code;
+    config.atime = atime;
+    return false;
+}
+
+bool AutoExposure::converged()
+{
+    return _converged;
+}
+
+bool AutoExposure::limited()
+{
+    return _limited;
+}
+
+uint8_t AutoExposure::iterations()
+{
+    return _iterations;
+}
+
+float AutoExposure::lastFill()
+{
+    return _lastFill;
+}
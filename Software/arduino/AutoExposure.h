@@ -0,0 +1,50 @@
+#ifndef AUTO_EXPOSURE_H
+#define AUTO_EXPOSURE_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+#include "SpectralFrame.h"
+
+#define AE_DEFAULT_TARGET 0.5f   // Peak count as a fraction of full scale
+#define AE_HIGH_LIMIT 0.9f       // Above this the frame is too close to saturation
+#define AE_SATURATION_STEP 8.0f  // Assumed overexposure when ASTATUS reports ASAT
+#define AE_MAX_GAIN_CODE 10      // 512x
+
+// Predictive auto-exposure. Each captured frame gives the light level per
+// unit gain and integration step; from that the next gain/ATIME is chosen
+// so the brightest ADC lands near the target fill level. A frame in range
+// needs no further capture, an unsaturated one usually converges on the
+// next capture, a saturated one within two or three.
+class AutoExposure
+{
+public:
+    AutoExposure();
+
+    void setTarget(float fill);
+    // ATIME range allowed; the upper bound caps the capture time
+    void setATimeLimits(uint8_t atimeMin, uint8_t atimeMax);
+    void reset(); // Start counting iterations for a new scene
+
+    // Evaluates a frame and writes the next gain/ATIME into config.
+    // Returns true when the frame was already within range.
+    bool update(const SpectralFrame &frame, SensorConfig &config);
+
+    bool converged();
+    bool limited(); // Out of range but already at the gain/ATIME limits
+    uint8_t iterations(); // Captures used by the current (or last) convergence
+    float lastFill();
+
+private:
+    float _target;
+    float _low;
+    uint8_t _atimeMin;
+    uint8_t _atimeMax;
+    bool _converged;
+    bool _limited;
+    uint8_t _iterations;
+    float _lastFill;
+
+    static float gainFactor(uint8_t code);
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "BasicCounts.h"
+
+BasicCounts::BasicCounts()
+{
+    _atime = 0;
+    _astep = 0;
+    _valid = false;
+    _scale = 0;
+    _shift = 0;
+}
+
+void BasicCounts::setTiming(uint8_t atime, uint16_t astep)
+{
+    if (_valid && atime == _atime && astep == _astep)
+    {
+        return;
+    }
+    _atime = atime;
+    _astep = astep;
+    _valid = true;
+
+    // 1 / integration time in ms = 100000 / (278 * steps). Keep as many
+    // fraction bits as fit in 31 bits; at least two, for 0.5x and rounding.
+    uint64_t den = 278ULL * (atime + 1UL) * (astep + 1UL);
+    _shift = 2;
+    while (_shift < 30 && ((100000ULL << (BASIC_COUNTS_FRAC_BITS + _shift + 1)) + den / 2) / den < 0x80000000ULL)
+    {
+        _shift++;
+    }
+    _scale = ((100000ULL << (BASIC_COUNTS_FRAC_BITS + _shift)) + den / 2) / den;
+}
+
+uint32_t BasicCounts::normalise(uint16_t counts, uint8_t gain) const
+{
+    // Dividing by 2^(gain - 1) is a right shift; 0.5x shifts one less.
+    // A reading never exceeds the step count, so the result stays below
+    // 720 basic counts (0.5x) and fits easily.
+    uint8_t shift = gain == 0 ? _shift - 1 : _shift + gain - 1;
+    uint64_t scaled = (uint64_t)counts * _scale;
+    return (uint32_t)((scaled + (1ULL << (shift - 1))) >> shift);
+}
+
+void BasicCounts::normalise(const SpectralFrame &frame, uint32_t basic[SPECTRAL_PHASES][SPECTRAL_ADCS])
+{
+    setTiming(frame.atime, frame.astep);
+    for (uint8_t phase = 0; phase < SPECTRAL_PHASES; phase++)
+    {
+        uint8_t gain = frame.gain(phase);
+        for (uint8_t adc = 0; adc < SPECTRAL_ADCS; adc++)
+        {
+            basic[phase][adc] = normalise(frame.adc[phase][adc], gain);
+        }
+    }
+}
+
+float BasicCounts::toFloat(uint32_t basic)
+{
+    return basic * (1.0f / BASIC_COUNTS_ONE);
+}
@@ -0,0 +1,38 @@
+#ifndef BASIC_COUNTS_H
+#define BASIC_COUNTS_H
+
+#include <Arduino.h>
+#include "SpectralFrame.h"
+
+#define BASIC_COUNTS_FRAC_BITS 16 // Results are Q16.16
+#define BASIC_COUNTS_ONE (1UL << BASIC_COUNTS_FRAC_BITS)
+
+// Converts raw ADC counts to basic counts: counts per millisecond of
+// integration at 1x gain, the unit readings taken with different settings
+// are compared in. Gain is a power of two and applied as a shift; the
+// integration time enters as a reciprocal that is only recomputed when
+// ATIME/ASTEP change, so a conversion is one multiply and one shift.
+class BasicCounts
+{
+public:
+    BasicCounts();
+
+    void setTiming(uint8_t atime, uint16_t astep);
+
+    // Q16.16 basic counts for a reading at the given gain code (0 = 0.5x)
+    uint32_t normalise(uint16_t counts, uint8_t gain) const;
+
+    // Every ADC of a frame, each phase at the gain its ASTATUS reports
+    void normalise(const SpectralFrame &frame, uint32_t basic[SPECTRAL_PHASES][SPECTRAL_ADCS]);
+
+    static float toFloat(uint32_t basic);
+
+private:
+    uint8_t _atime;
+    uint16_t _astep;
+    bool _valid;
+    uint32_t _scale; // Basic counts per raw count at 1x, scaled by 2^(16 + _shift)
+    uint8_t _shift;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "Colorimetry.h"
+#include <math.h>
+
+Colorimetry::Colorimetry()
+{
+    memset(&_result, 0, sizeof(_result));
+    _rawY = 0.0f;
+    _luxPerY = COLOR_DEFAULT_LUX_PER_Y;
+    _cached = false;
+}
+
+void Colorimetry::begin()
+{
+    _nvs.begin(COLOR_NVS_NAMESPACE, false);
+    float scale;
+    if (_nvs.getBytes("lux", &scale, sizeof(scale)) == sizeof(scale) && scale > 0.0f)
+    {
+        _luxPerY = scale;
+    }
+}
+
+const ColorResult &Colorimetry::compute(const SpectralFrame &frame)
+{
+    if (_cached && frame.sequence == _result.sequence)
+    {
+        return _result;
+    }
+
+    uint32_t basic[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    _basic.normalise(frame, basic);
+    float xyz[3] = {0.0f, 0.0f, 0.0f};
+    for (uint8_t c = 0; c < COLOR_CHANNELS; c++)
+    {
+        uint32_t value = c < 4 ? basic[SPECTRAL_PHASE_F1F4][c]
+                               : (c < 8 ? basic[SPECTRAL_PHASE_F5F8][c - 4] : basic[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR]);
+        float channel = BasicCounts::toFloat(value);
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            xyz[i] += colorXyzMatrix[i][c] * channel;
+        }
+    }
+
+    _result.sequence = frame.sequence;
+    _result.saturated = frame.saturated();
+    _rawY = xyz[1];
+    _result.X = xyz[0] * _luxPerY;
+    _result.Y = xyz[1] * _luxPerY;
+    _result.Z = xyz[2] * _luxPerY;
+    _result.lux = _result.Y > 0.0f ? _result.Y : 0.0f;
+
+    // The reconstruction can swing slightly negative in the dark; no
+    // chromaticity then
+    float sum = xyz[0] + xyz[1] + xyz[2];
+    float den = xyz[0] + 15.0f * xyz[1] + 3.0f * xyz[2];
+    _result.valid = xyz[0] > 0.0f && xyz[1] > 0.0f && xyz[2] >= 0.0f;
+    if (_result.valid)
+    {
+        _result.x = xyz[0] / sum;
+        _result.y = xyz[1] / sum;
+        _result.u = 4.0f * xyz[0] / den;
+        _result.v = 6.0f * xyz[1] / den;
+        _result.cct = cct(_result.u, _result.v, &_result.duv);
+    }
+    else
+    {
+        _result.x = _result.y = _result.u = _result.v = 0.0f;
+        _result.cct = _result.duv = 0.0f;
+    }
+
+    _cached = true;
+    return _result;
+}
+
+const ColorResult &Colorimetry::result()
+{
+    return _result;
+}
+
+bool Colorimetry::calibrate(float lux)
+{
+    if (!_cached || _rawY <= 0.0f || lux <= 0.0f)
+    {
+        return false;
+    }
+    _luxPerY = lux / _rawY;
+    _nvs.putBytes("lux", &_luxPerY, sizeof(_luxPerY));
+    _cached = false; // Rescaled on the next compute()
+    return true;
+}
+
+void Colorimetry::resetCalibration()
+{
+    _luxPerY = COLOR_DEFAULT_LUX_PER_Y;
+    _nvs.remove("lux");
+    _cached = false;
+}
+
+float Colorimetry::luxScale()
+{
+    return _luxPerY;
+}
+
+float Colorimetry::cct(float u, float v, float *duv)
+{
+    // Signed distance along the locus tangent to each isotemperature line
+    // (the normal through a locus point) is positive until the point is
+    // passed; interpolate mired and Duv between the two lines either side
+    float previous = 0.0f;
+    for (uint8_t i = 0; i < COLOR_LOCUS_POINTS; i++)
+    {
+        const float *line = colorLocus[i];
+        float du = u - line[1];
+        float dv = v - line[2];
+        float along = du * line[3] + dv * line[4];
+        if (i > 0 && previous >= 0.0f && along < 0.0f)
+        {
+            const float *last = colorLocus[i - 1];
+            float f = previous / (previous - along);
+            float offsetLast = (v - last[2]) * last[3] - (u - last[1]) * last[4];
+            float offset = dv * line[3] - du * line[4];
+            *duv = offsetLast + f * (offset - offsetLast);
+            float mired = last[0] + f * (line[0] - last[0]);
+            if (fabsf(*duv) > COLOR_MAX_DUV || mired <= 0.0f)
+            {
+                return 0.0f;
+            }
+            return 1e6f / mired;
+        }
+        previous = along;
+    }
+    *duv = 0.0f;
+    return 0.0f;
+}
@@ -0,0 +1,64 @@
+#ifndef COLORIMETRY_H
+#define COLORIMETRY_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "SpectralFrame.h"
+#include "BasicCounts.h"
+#include "ColorimetryTables.h"
+
+#define COLOR_DEFAULT_LUX_PER_Y 12.0f  // Rough figure for an uncalibrated unit
+#define COLOR_MAX_DUV 0.05f            // Further from the locus CCT is undefined
+#define COLOR_NVS_NAMESPACE "color"
+
+struct ColorResult
+{
+    float X;   // Tristimulus values, scaled so that Y is in lux
+    float Y;
+    float Z;
+    float x;   // CIE 1931 chromaticity
+    float y;
+    float u;   // CIE 1960 UCS (u' = u, v' = 1.5 v)
+    float v;
+    float cct; // Correlated colour temperature (K), 0 when undefined
+    float duv; // Distance from the Planckian locus in (u, v), positive above it
+    float lux;
+    uint32_t sequence;
+    bool valid;     // The frame had light on it
+    bool saturated; // Some channels clipped, so the colour is off
+};
+
+// Colorimetry per frame: one 3 x 9 matrix (ColorimetryTables.h, generated
+// by host/gen_colorimetry.py) takes the basic counts straight to XYZ, and
+// the CCT comes from interpolating between tabulated isotemperature lines
+// of the Planckian locus. The result is kept until a newer frame is asked
+// for. Lux needs a per-unit scale; calibrate() sets it against a reference
+// meter and keeps it in NVS.
+class Colorimetry
+{
+public:
+    Colorimetry();
+
+    void begin(); // Loads the lux calibration
+
+    const ColorResult &compute(const SpectralFrame &frame);
+    const ColorResult &result();
+
+    // Scales lux so that the last result reads 'lux'; false if it had no light
+    bool calibrate(float lux);
+    void resetCalibration();
+    float luxScale();
+
+    // CCT (K, 0 if out of range) and Duv of a CIE 1960 chromaticity
+    static float cct(float u, float v, float *duv);
+
+private:
+    BasicCounts _basic;
+    ColorResult _result;
+    float _rawY; // Y of the last result in basic counts
+    float _luxPerY;
+    bool _cached;
+    Preferences _nvs;
+};
+
+#endif
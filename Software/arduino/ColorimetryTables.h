@@ -0,0 +1,126 @@
+// Generated by Software/host/gen_colorimetry.py - do not edit.
+//
+// F1-F8, NIR basic counts to CIE 1931 XYZ through the 380-1000 nm
+// reconstruction, and the Planckian locus in CIE 1960 (u, v) every
+// 10 mired up to 1000 K with its unit tangent (towards higher mired).
+#ifndef COLORIMETRY_TABLES_H
+#define COLORIMETRY_TABLES_H
+
+#include <Arduino.h>
+
+#define COLOR_CHANNELS 9
+#define COLOR_MIRED_STEP 10
+#define COLOR_LOCUS_POINTS 101
+
+const float colorXyzMatrix[3][COLOR_CHANNELS] PROGMEM = {
+    {6.391167e-02f, 4.111484e-01f, 8.279438e-02f, 1.287647e-02f, 3.813303e-01f, 9.815238e-01f, 5.880253e-01f, -2.527802e-02f, 1.508074e-09f}, // X
+    {-1.178640e-02f, 5.610828e-02f, 1.861843e-02f, 6.132622e-01f, 9.733426e-01f, 6.257070e-01f, 2.248193e-01f, -6.178992e-03f, 7.869255e-10f}, // Y
+    {3.040223e-01f, 2.019565e+00f, 8.891924e-01f, -4.390240e-02f, 5.061129e-02f, -2.516844e-02f, 8.486930e-03f, -2.660922e-03f, 1.481776e-10f}, // Z
+};
+
+// mired, u, v, du, dv
+const float colorLocus[COLOR_LOCUS_POINTS][5] PROGMEM = {
+    {0, 0.180240f, 0.263503f, 0.235104f, 0.971970f},
+    {10, 0.180827f, 0.265878f, 0.245053f, 0.969510f},
+    {20, 0.181492f, 0.268441f, 0.257434f, 0.966296f},
+    {30, 0.182242f, 0.271175f, 0.272003f, 0.962296f},
+    {40, 0.183085f, 0.274063f, 0.288707f, 0.957418f},
+    {50, 0.184028f, 0.277081f, 0.307460f, 0.951561f},
+    {60, 0.185075f, 0.280207f, 0.328147f, 0.944627f},
+    {70, 0.186232f, 0.283414f, 0.350617f, 0.936519f},
+    {80, 0.187501f, 0.286676f, 0.374694f, 0.927149f},
+    {90, 0.188885f, 0.289971f, 0.400178f, 0.916438f},
+    {100, 0.190385f, 0.293273f, 0.426848f, 0.904324f},
+    {110, 0.191999f, 0.296562f, 0.454469f, 0.890763f},
+    {120, 0.193726f, 0.299818f, 0.482797f, 0.875732f},
+    {130, 0.195564f, 0.303025f, 0.511584f, 0.859233f},
+    {140, 0.197509f, 0.306168f, 0.540583f, 0.841290f},
+    {150, 0.199556f, 0.309236f, 0.569555f, 0.821953f},
+    {160, 0.201702f, 0.312219f, 0.598271f, 0.801294f},
+    {170, 0.203941f, 0.315109f, 0.626518f, 0.779407f},
+    {180, 0.206268f, 0.317900f, 0.654103f, 0.756406f},
+    {190, 0.208679f, 0.320589f, 0.680854f, 0.732420f},
+    {200, 0.211168f, 0.323172f, 0.706623f, 0.707590f},
+    {210, 0.213729f, 0.325647f, 0.731289f, 0.682068f},
+    {220, 0.216358f, 0.328014f, 0.754753f, 0.656009f},
+    {230, 0.219050f, 0.330274f, 0.776943f, 0.629571f},
+    {240, 0.221800f, 0.332426f, 0.797812f, 0.602906f},
+    {250, 0.224604f, 0.334472f, 0.817333f, 0.576166f},
+    {260, 0.227457f, 0.336415f, 0.835501f, 0.549490f},
+    {270, 0.230354f, 0.338256f, 0.852328f, 0.523008f},
+    {280, 0.233293f, 0.339998f, 0.867841f, 0.496841f},
+    {290, 0.236268f, 0.341643f, 0.882083f, 0.471094f},
+    {300, 0.239277f, 0.343195f, 0.895103f, 0.445859f},
+    {310, 0.242316f, 0.344657f, 0.906961f, 0.421216f},
+    {320, 0.245381f, 0.346032f, 0.917719f, 0.397229f},
+    {330, 0.248469f, 0.347322f, 0.927448f, 0.373953f},
+    {340, 0.251578f, 0.348532f, 0.936215f, 0.351428f},
+    {350, 0.254705f, 0.349664f, 0.944091f, 0.329685f},
+    {360, 0.257846f, 0.350722f, 0.951145f, 0.308744f},
+    {370, 0.260999f, 0.351709f, 0.957445f, 0.288617f},
+    {380, 0.264163f, 0.352628f, 0.963054f, 0.269307f},
+    {390, 0.267333f, 0.353481f, 0.968036f, 0.250813f},
+    {400, 0.270510f, 0.354273f, 0.972447f, 0.233126f},
+    {410, 0.273689f, 0.355006f, 0.976342f, 0.216233f},
+    {420, 0.276870f, 0.355683f, 0.979772f, 0.200118f},
+    {430, 0.280051f, 0.356307f, 0.982783f, 0.184761f},
+    {440, 0.283229f, 0.356879f, 0.985420f, 0.170141f},
+    {450, 0.286404f, 0.357404f, 0.987720f, 0.156233f},
+    {460, 0.289573f, 0.357884f, 0.989721f, 0.143012f},
+    {470, 0.292735f, 0.358320f, 0.991454f, 0.130453f},
+    {480, 0.295889f, 0.358716f, 0.992951f, 0.118530f},
+    {490, 0.299033f, 0.359073f, 0.994236f, 0.107215f},
+    {500, 0.302167f, 0.359393f, 0.995335f, 0.096482f},
+    {510, 0.305288f, 0.359680f, 0.996269f, 0.086306f},
+    {520, 0.308396f, 0.359934f, 0.997057f, 0.076661f},
+    {530, 0.311490f, 0.360157f, 0.997718f, 0.067521f},
+    {540, 0.314569f, 0.360352f, 0.998266f, 0.058863f},
+    {550, 0.317632f, 0.360520f, 0.998716f, 0.050662f},
+    {560, 0.320678f, 0.360662f, 0.999080f, 0.042896f},
+    {570, 0.323706f, 0.360781f, 0.999368f, 0.035543f},
+    {580, 0.326715f, 0.360878f, 0.999591f, 0.028582f},
+    {590, 0.329704f, 0.360953f, 0.999758f, 0.021992f},
+    {600, 0.332674f, 0.361009f, 0.999876f, 0.015755f},
+    {610, 0.335623f, 0.361047f, 0.999951f, 0.009851f},
+    {620, 0.338550f, 0.361067f, 0.999991f, 0.004264f},
+    {630, 0.341455f, 0.361072f, 0.999999f, -0.001025f},
+    {640, 0.344337f, 0.361062f, 0.999982f, -0.006029f},
+    {650, 0.347196f, 0.361038f, 0.999942f, -0.010766f},
+    {660, 0.350031f, 0.361001f, 0.999884f, -0.015249f},
+    {670, 0.352842f, 0.360952f, 0.999810f, -0.019491f},
+    {680, 0.355628f, 0.360892f, 0.999724f, -0.023507f},
+    {690, 0.358389f, 0.360822f, 0.999627f, -0.027307f},
+    {700, 0.361125f, 0.360742f, 0.999522f, -0.030905f},
+    {710, 0.363834f, 0.360654f, 0.999411f, -0.034310f},
+    {720, 0.366517f, 0.360557f, 0.999295f, -0.037533f},
+    {730, 0.369172f, 0.360453f, 0.999176f, -0.040585f},
+    {740, 0.371801f, 0.360343f, 0.999055f, -0.043474f},
+    {750, 0.374402f, 0.360226f, 0.998932f, -0.046210f},
+    {760, 0.376976f, 0.360104f, 0.998809f, -0.048800f},
+    {770, 0.379521f, 0.359976f, 0.998686f, -0.051253f},
+    {780, 0.382037f, 0.359844f, 0.998564f, -0.053577f},
+    {790, 0.384525f, 0.359708f, 0.998443f, -0.055777f},
+    {800, 0.386984f, 0.359568f, 0.998325f, -0.057861f},
+    {810, 0.389414f, 0.359424f, 0.998208f, -0.059836f},
+    {820, 0.391815f, 0.359278f, 0.998094f, -0.061707f},
+    {830, 0.394185f, 0.359130f, 0.997983f, -0.063480f},
+    {840, 0.396526f, 0.358979f, 0.997875f, -0.065159f},
+    {850, 0.398836f, 0.358826f, 0.997770f, -0.066751f},
+    {860, 0.401117f, 0.358672f, 0.997668f, -0.068260f},
+    {870, 0.403367f, 0.358516f, 0.997569f, -0.069691f},
+    {880, 0.405586f, 0.358360f, 0.997473f, -0.071047f},
+    {890, 0.407774f, 0.358202f, 0.997381f, -0.072332f},
+    {900, 0.409932f, 0.358044f, 0.997291f, -0.073552f},
+    {910, 0.412058f, 0.357886f, 0.997205f, -0.074708f},
+    {920, 0.414154f, 0.357728f, 0.997123f, -0.075805f},
+    {930, 0.416218f, 0.357570f, 0.997043f, -0.076845f},
+    {940, 0.418250f, 0.357413f, 0.996967f, -0.077832f},
+    {950, 0.420251f, 0.357255f, 0.996893f, -0.078768f},
+    {960, 0.422220f, 0.357099f, 0.996822f, -0.079656f},
+    {970, 0.424158f, 0.356943f, 0.996755f, -0.080499f},
+    {980, 0.426064f, 0.356789f, 0.996690f, -0.081299f},
+    {990, 0.427938f, 0.356635f, 0.996628f, -0.082058f},
+    {1000, 0.429780f, 0.356483f, 0.996568f, -0.082779f},
+};
+
+#endif
@@ -0,0 +1,134 @@
+#include "DarkFrames.h"
+
+DarkFrames::DarkFrames()
+{
+    memset(_refs, 0, sizeof(_refs));
+    memset(_bornSeconds, 0, sizeof(_bornSeconds));
+    memset(_used, 0, sizeof(_used));
+    memset(_stale, 0, sizeof(_stale));
+    _maxAgeS = DARK_DEFAULT_MAX_AGE_S;
+}
+
+void DarkFrames::begin()
+{
+    _nvs.begin(DARK_NVS_NAMESPACE, false);
+    long now = nowSeconds();
+    for (uint8_t slot = 0; slot < DARK_CACHE_SIZE; slot++)
+    {
+        char name[4];
+        key(slot, name);
+        _used[slot] = _nvs.getBytes(name, &_refs[slot], sizeof(DarkReference)) == sizeof(DarkReference);
+        _stale[slot] = _used[slot];
+        _bornSeconds[slot] = now;
+    }
+}
+
+void DarkFrames::setMaxAge(uint32_t seconds)
+{
+    _maxAgeS = seconds;
+}
+
+void DarkFrames::store(const SpectralFrame &dark)
+{
+    uint8_t gain = dark.gain(SPECTRAL_PHASE_F1F4);
+    int slot = find(gain, dark.atime, dark.astep);
+    for (uint8_t i = 0; slot < 0 && i < DARK_CACHE_SIZE; i++)
+    {
+        slot = _used[i] ? slot : i;
+    }
+    if (slot < 0)
+    {
+        slot = 0;
+        for (uint8_t i = 1; i < DARK_CACHE_SIZE; i++)
+        {
+            slot = _bornSeconds[i] < _bornSeconds[slot] ? i : slot;
+        }
+    }
+
+    DarkReference &ref = _refs[slot];
+    memcpy(ref.adc, dark.adc, sizeof(ref.adc));
+    ref.astep = dark.astep;
+    ref.gain = gain;
+    ref.atime = dark.atime;
+    _bornSeconds[slot] = nowSeconds();
+    _used[slot] = true;
+    _stale[slot] = false;
+    save(slot);
+}
+
+void DarkFrames::clear()
+{
+    memset(_used, 0, sizeof(_used));
+    _nvs.clear();
+}
+
+bool DarkFrames::correct(SpectralFrame &frame)
+{
+    int slot = find(frame.gain(SPECTRAL_PHASE_F1F4), frame.atime, frame.astep);
+    if (slot < 0)
+    {
+        return false;
+    }
+
+    // One pass over the 12 ADC results, clamped at zero
+    const uint16_t *dark = &_refs[slot].adc[0][0];
+    uint16_t *counts = &frame.adc[0][0];
+    for (uint8_t i = 0; i < SPECTRAL_PHASES * SPECTRAL_ADCS; i++)
+    {
+        counts[i] = counts[i] > dark[i] ? counts[i] - dark[i] : 0;
+    }
+    return true;
+}
+
+bool DarkFrames::needed(uint8_t gain, uint8_t atime, uint16_t astep)
+{
+    int slot = find(gain, atime, astep);
+    return slot < 0 || _stale[slot] || (uint32_t)(nowSeconds() - _bornSeconds[slot]) > _maxAgeS;
+}
+
+long DarkFrames::age(uint8_t gain, uint8_t atime, uint16_t astep)
+{
+    int slot = find(gain, atime, astep);
+    return slot < 0 ? -1 : nowSeconds() - _bornSeconds[slot];
+}
+
+uint8_t DarkFrames::count()
+{
+    uint8_t used = 0;
+    for (uint8_t slot = 0; slot < DARK_CACHE_SIZE; slot++)
+    {
+        used += _used[slot] ? 1 : 0;
+    }
+    return used;
+}
+
+int DarkFrames::find(uint8_t gain, uint8_t atime, uint16_t astep)
+{
+    for (uint8_t slot = 0; slot < DARK_CACHE_SIZE; slot++)
+    {
+        if (_used[slot] && _refs[slot].gain == gain && _refs[slot].atime == atime && _refs[slot].astep == astep)
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void DarkFrames::save(uint8_t slot)
+{
+    char name[4];
+    key(slot, name);
+    _nvs.putBytes(name, &_refs[slot], sizeof(DarkReference));
+}
+
+long DarkFrames::nowSeconds()
+{
+    return (long)(millis() / 1000);
+}
+
+void DarkFrames::key(uint8_t slot, char *buffer)
+{
+    buffer[0] = 'd';
+    buffer[1] = '0' + slot;
+    buffer[2] = '\0';
+}
@@ -0,0 +1,66 @@
+#ifndef DARK_FRAMES_H
+#define DARK_FRAMES_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "SpectralFrame.h"
+
+#define DARK_CACHE_SIZE 8          // References kept (one per gain/ATIME/ASTEP)
+#define DARK_DEFAULT_MAX_AGE_S 3600 // Dark current drifts with temperature
+#define DARK_NVS_NAMESPACE "dark"
+
+// Dark reference for one combination of settings, as stored in NVS
+struct DarkReference
+{
+    uint16_t adc[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    uint16_t astep;
+    uint8_t gain;
+    uint8_t atime;
+};
+
+// Cache of dark frames keyed by gain code, ATIME and ASTEP. References are
+// captured by the user (LED off, sensor covered), kept in NVS across
+// reboots and subtracted from every frame taken with the same settings.
+class DarkFrames
+{
+public:
+    DarkFrames();
+
+    void begin(); // Loads the stored references
+    void setMaxAge(uint32_t seconds);
+
+    // Stores a frame captured in the dark, replacing the reference for the
+    // same settings or else the oldest one
+    void store(const SpectralFrame &dark);
+    void clear();
+
+    // Subtracts the matching reference in place; false if there is none
+    bool correct(SpectralFrame &frame);
+
+    // True when frames with these settings have no reference or an
+    // outdated one, i.e. a new dark capture is due. A reference loaded
+    // from NVS is always outdated: its capture time (and temperature) is
+    // unknown, so it is only used until it is recaptured.
+    bool needed(uint8_t gain, uint8_t atime, uint16_t astep);
+    // Age of the reference for these settings in seconds (since boot for
+    // one loaded from NVS), -1 if none
+    long age(uint8_t gain, uint8_t atime, uint16_t astep);
+    uint8_t count();
+
+private:
+    DarkReference _refs[DARK_CACHE_SIZE];
+    // Capture time on the uptime clock. There is no real-time clock, so
+    // references loaded from NVS are marked stale and dated to boot.
+    long _bornSeconds[DARK_CACHE_SIZE];
+    bool _used[DARK_CACHE_SIZE];
+    bool _stale[DARK_CACHE_SIZE];
+    uint32_t _maxAgeS;
+    Preferences _nvs;
+
+    int find(uint8_t gain, uint8_t atime, uint16_t astep);
+    void save(uint8_t slot);
+    static long nowSeconds();
+    static void key(uint8_t slot, char *buffer);
+};
+
+#endif
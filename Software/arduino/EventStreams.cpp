@@ -0,0 +1,164 @@
+#include "EventStreams.h"
+#include "TraceLog.h"
+#include <sys/socket.h>
+
+EventStreams::EventStreams(WiFiServer &server, char *buffer, size_t size)
+{
+    _server = &server;
+    memset(_state, 0, sizeof(_state));
+    memset(_sent, 0, sizeof(_sent));
+    memset(_openedAt, 0, sizeof(_openedAt));
+    _keepAliveAt = 0;
+    _buffer = buffer;
+    _size = size;
+    _dropped = 0;
+}
+
+void EventStreams::begin()
+{
+    _server->begin();
+}
+
+bool EventStreams::service()
+{
+    WiFiClient client = _server->available();
+    if (client)
+    {
+        int slot = -1;
+        for (int i = 0; i < EVENTS_MAX_CLIENTS && slot < 0; i++)
+        {
+            slot = _clients[i].connected() ? -1 : i;
+        }
+        if (slot < 0)
+        {
+            static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\nAccess-Control-Allow-Origin: *\r\n"
+                                       "Content-Length: 0\r\nConnection: close\r\n\r\n";
+            sendNow(client, busy, sizeof(busy) - 1);
+            client.stop();
+        }
+        else
+        {
+            _clients[slot] = client;
+            _state[slot] = 0;
+            _sent[slot] = 0;
+            _openedAt[slot] = millis();
+        }
+    }
+
+    // Handshake: skip the request up to the blank line, then answer
+    bool opened = false;
+    for (int i = 0; i < EVENTS_MAX_CLIENTS; i++)
+    {
+        if (!_clients[i].connected() || _state[i] == EVENTS_STREAMING)
+        {
+            continue;
+        }
+        while (_clients[i].available() && _state[i] < EVENTS_STREAMING)
+        {
+            char c = _clients[i].read();
+            bool expected = c == ((_state[i] & 1) ? '\n' : '\r');
+            _state[i] = expected ? _state[i] + 1 : (c == '\r' ? 1 : 0);
+        }
+        if (_state[i] == EVENTS_STREAMING)
+        {
+            static const char headers[] = "HTTP/1.1 200 OK\r\n"
+                                          "Content-Type: text/event-stream\r\n"
+                                          "Cache-Control: no-cache\r\n"
+                                          "Access-Control-Allow-Origin: *\r\n"
+                                          "Connection: keep-alive\r\n\r\n"
+                                          "retry: 2000\n\n";
+            _clients[i].setNoDelay(true);
+            if (!sendNow(_clients[i], headers, sizeof(headers) - 1))
+            {
+                drop(i);
+                continue;
+            }
+            LOG_INFO("event stream %ld opened", i);
+            opened = true;
+        }
+        else if (millis() - _openedAt[i] > EVENTS_HANDSHAKE_MS)
+        {
+            _clients[i].stop();
+        }
+    }
+
+    // A comment line now and then, so dead connections are noticed and
+    // their slots freed even when no frames are published
+    if ((long)(millis() - _keepAliveAt) >= 0)
+    {
+        static const char keepAlive[] = ": keep-alive\n\n";
+        _keepAliveAt = millis() + EVENTS_KEEPALIVE_MS;
+        for (int i = 0; i < EVENTS_MAX_CLIENTS; i++)
+        {
+            if (_clients[i].connected() && _state[i] == EVENTS_STREAMING &&
+                !sendNow(_clients[i], keepAlive, sizeof(keepAlive) - 1))
+            {
+                drop(i);
+            }
+        }
+    }
+    return opened;
+}
+
+void EventStreams::push(uint32_t sequence, EventDataFn data)
+{
+    size_t length = 0;
+    for (int i = 0; i < EVENTS_MAX_CLIENTS; i++)
+    {
+        if (!_clients[i].connected() || _state[i] != EVENTS_STREAMING || _sent[i] == sequence + 1)
+        {
+            continue;
+        }
+        if (length == 0)
+        {
+            // The JSON goes straight after the event's header lines
+            int header = snprintf(_buffer, _size, "id: %lu\nevent: frame\ndata: ", (unsigned long)sequence);
+            size_t json = data(_buffer + header, _size - header - 2);
+            if (json == 0)
+            {
+                return;
+            }
+            length = header + json;
+            _buffer[length++] = '\n';
+            _buffer[length++] = '\n';
+        }
+        if (!sendNow(_clients[i], _buffer, length))
+        {
+            drop(i);
+            continue;
+        }
+        _sent[i] = sequence + 1;
+    }
+}
+
+uint8_t EventStreams::clients()
+{
+    uint8_t open = 0;
+    for (int i = 0; i < EVENTS_MAX_CLIENTS; i++)
+    {
+        open += _clients[i].connected() && _state[i] == EVENTS_STREAMING ? 1 : 0;
+    }
+    return open;
+}
+
+uint32_t EventStreams::dropped()
+{
+    return _dropped;
+}
+
+void EventStreams::drop(uint8_t slot)
+{
+    LOG_WARN("event stream %ld dropped", slot);
+    _clients[slot].stop();
+    _dropped++;
+}
+
+// WiFiClient::write() waits for room in the socket buffer, retrying with
+// the socket timeout, so one stalled reader would stall the caller for
+// seconds. A send that cannot take everything at once fails instead; the
+// stream is then cut mid-event anyway, so the client must be dropped.
+bool EventStreams::sendNow(WiFiClient &client, const char *data, size_t length)
+{
+    ssize_t sent = send(client.fd(), data, length, MSG_DONTWAIT);
+    return sent == (ssize_t)length;
+}
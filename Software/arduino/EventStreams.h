@@ -0,0 +1,61 @@
+#ifndef EVENT_STREAMS_H
+#define EVENT_STREAMS_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#define EVENTS_MAX_CLIENTS 4
+#define EVENTS_STREAMING 4 // Handshake state once the request's blank line is in
+#define EVENTS_HANDSHAKE_MS 1000
+#define EVENTS_KEEPALIVE_MS 15000
+
+// Writes the data of an event (the /data JSON) into 'buffer'; returns its
+// length, or 0 if it did not fit
+typedef size_t (*EventDataFn)(char *buffer, size_t size);
+
+// Server-sent event streams on a port of their own: every published frame
+// is pushed to each connected client once, as a "frame" event. The streams
+// cannot share the WebServer, which serves one connection at a time and
+// would stall behind an open stream. Any request on the port opens a
+// stream.
+//
+// Nothing here waits for a client. Events go out with non-blocking sends,
+// and a client whose socket buffer cannot take a whole event is dropped;
+// the page then falls back to polling /data. A stalled phone therefore
+// never holds up loop() and the acquisition it drives.
+class EventStreams
+{
+public:
+    // Serves the streams on 'server'; events are built in 'buffer', once
+    // for all clients
+    EventStreams(WiFiServer &server, char *buffer, size_t size);
+
+    void begin();
+    // Accepts clients, completes handshakes and sends keep-alives. Returns
+    // true when a stream opened and is waiting for the current frame.
+    bool service();
+    // Sends frame 'sequence' to every stream that has not had it yet
+    void push(uint32_t sequence, EventDataFn data);
+
+    uint8_t clients(); // Streams open
+    uint32_t dropped(); // Clients dropped for not keeping up
+
+private:
+    WiFiServer *_server;
+    WiFiClient _clients[EVENTS_MAX_CLIENTS];
+    // Per slot, _state counts the CR/LF of the request's closing blank
+    // line until it reaches EVENTS_STREAMING; _sent is the sequence number
+    // of the last frame pushed plus one (0: none yet)
+    uint8_t _state[EVENTS_MAX_CLIENTS];
+    uint32_t _sent[EVENTS_MAX_CLIENTS];
+    unsigned long _openedAt[EVENTS_MAX_CLIENTS];
+    unsigned long _keepAliveAt;
+    char *_buffer;
+    size_t _size;
+    uint32_t _dropped;
+
+    void drop(uint8_t slot);
+    static bool sendNow(WiFiClient &client, const char *data, size_t length);
+};
+
+#endif
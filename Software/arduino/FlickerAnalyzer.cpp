@@ -0,0 +1,343 @@
+#include "FlickerAnalyzer.h"
+#include <math.h>
+
+FlickerAnalyzer::FlickerAnalyzer(AS7341 &sensor)
+{
+    _sensor = &sensor;
+    _busy = false;
+    _count = 0;
+    _requestedRate = FLICKER_DEFAULT_RATE_HZ;
+    _gain = FLICKER_DEFAULT_GAIN;
+    _rate = 0.0f;
+    _burstMicros = 0;
+    _startedAt = 0;
+    _nextPollAt = 0;
+    _bursts = 0;
+    _doneAt = 0;
+    memset(&_result, 0, sizeof(_result));
+    memset(_samples, 0, sizeof(_samples));
+
+    for (int i = 0; i < FLICKER_SAMPLES; i++)
+    {
+        _sine[i] = (int16_t)lroundf(32767.0f * sinf(2.0f * (float)M_PI * i / FLICKER_SAMPLES));
+    }
+}
+
+void FlickerAnalyzer::configure(float sampleRateHz, uint8_t gain)
+{
+    if (sampleRateHz < FLICKER_MIN_RATE_HZ)
+    {
+        sampleRateHz = FLICKER_MIN_RATE_HZ;
+    }
+    _requestedRate = sampleRateHz;
+    _gain = gain;
+}
+
+float FlickerAnalyzer::maxRate()
+{
+    float rate = (float)_sensor->getBusClock() / FLICKER_BUS_BITS_PER_SAMPLE;
+    return rate > FLICKER_MIN_RATE_HZ ? rate : FLICKER_MIN_RATE_HZ;
+}
+
+bool FlickerAnalyzer::start()
+{
+    if (_busy)
+    {
+        return false;
+    }
+
+    // Checked here, as the bus clock may have changed since configure()
+    float maxRateHz = maxRate();
+    _rate = _sensor->beginFlickerCapture(_requestedRate < maxRateHz ? _requestedRate : maxRateHz, _gain);
+    _burstMicros = (uint32_t)(FLICKER_MIN_BURST * 1e6f / _rate);
+    _count = 0;
+    _bursts = 0;
+    _startedAt = micros();
+    _nextPollAt = _startedAt + _burstMicros;
+    _busy = true;
+    return true;
+}
+
+bool FlickerAnalyzer::update()
+{
+    if (!_busy || (long)(micros() - _nextPollAt) < 0)
+    {
+        return false;
+    }
+
+    // Read whatever has queued up, in as few transfers as the Wire buffer allows
+    uint8_t level = _sensor->getFifoLevel();
+    uint16_t wanted = FLICKER_SAMPLES - _count;
+    uint16_t available = level < wanted ? level : wanted;
+    while (available > 0)
+    {
+        uint8_t got = _sensor->readFifo(_samples + _count, available > AS7341_FIFO_BURST ? AS7341_FIFO_BURST : available);
+        if (got == 0)
+        {
+            break;
+        }
+        _count += got;
+        available -= got;
+        _bursts++;
+    }
+
+    if (_count >= FLICKER_SAMPLES)
+    {
+        finish();
+        return true;
+    }
+
+    // Come back when the next burst is due; give up if the FIFO stalls,
+    // keeping the previous result
+    unsigned long now = micros();
+    uint32_t budgetMs = (uint32_t)(FLICKER_SAMPLES * 1000.0f / _rate) + FLICKER_TIMEOUT_MARGIN_MS;
+    if (now - _startedAt > budgetMs * 1000UL)
+    {
+        _sensor->endFlickerCapture();
+        _busy = false;
+        return true;
+    }
+    _nextPollAt = now + _burstMicros;
+    return false;
+}
+
+void FlickerAnalyzer::cancel()
+{
+    if (_busy)
+    {
+        _sensor->endFlickerCapture();
+        _busy = false;
+    }
+}
+
+bool FlickerAnalyzer::busy()
+{
+    return _busy;
+}
+
+bool FlickerAnalyzer::measure()
+{
+    if (!start())
+    {
+        return false;
+    }
+    while (!update())
+    {
+        delayMicroseconds(_burstMicros);
+    }
+    return _result.valid;
+}
+
+const FlickerResult &FlickerAnalyzer::result()
+{
+    return _result;
+}
+
+const uint16_t *FlickerAnalyzer::waveform()
+{
+    return _samples;
+}
+
+long FlickerAnalyzer::age()
+{
+    if (!_result.valid)
+    {
+        return -1;
+    }
+    return (millis() - _doneAt);
+}
+
+uint32_t FlickerAnalyzer::durationMicros()
+{
+    return (uint32_t)(FLICKER_SAMPLES * 1e6f / _requestedRate);
+}
+
+uint32_t FlickerAnalyzer::getBursts()
+{
+    return _bursts;
+}
+
+void FlickerAnalyzer::finish()
+{
+    // Samples lost to an overflow leave gaps the FFT cannot see
+    bool overflow = _sensor->fifoOverflow();
+    _sensor->endFlickerCapture();
+    _busy = false;
+    uint32_t captureMicros = micros() - _startedAt;
+
+    analyse();
+    _result.overflow = overflow;
+    _result.captureMicros = captureMicros;
+    _doneAt = millis();
+}
+
+void FlickerAnalyzer::analyse()
+{
+    const uint16_t n = FLICKER_SAMPLES;
+    uint32_t sum = 0;
+    uint16_t lo = 0xFFFF;
+    uint16_t hi = 0;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        uint16_t x = _samples[i];
+        sum += x;
+        lo = x < lo ? x : lo;
+        hi = x > hi ? x : hi;
+    }
+    int32_t mean = (sum + n / 2) >> FLICKER_LOG2_SAMPLES;
+
+    // Flicker index over the whole window, which spans many periods of
+    // anything the FFT can resolve
+    uint32_t above = 0;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        if (_samples[i] > mean)
+        {
+            above += _samples[i] - mean;
+        }
+    }
+
+    _result.samples = n;
+    _result.sampleRateHz = _rate;
+    _result.meanCounts = (float)sum / n;
+    _result.saturated = hi == 0xFFFF;
+    _result.modulationDepth = hi + lo > 0 ? (float)(hi - lo) / (hi + lo) : 0.0f;
+    _result.flickerIndex = sum > 0 ? (float)above / sum : 0.0f;
+    _result.frequencyHz = 0.0f;
+    _result.amplitudeDepth = 0.0f;
+    _result.valid = true;
+
+    // AC part scaled so the largest excursion lands in [2^13, 2^14): full
+    // use of Q15 with one bit of headroom for the window
+    int32_t peak = (hi - mean) > (mean - lo) ? (hi - mean) : (mean - lo);
+    if (peak == 0)
+    {
+        return;
+    }
+    int8_t shift = 0;
+    while (shift < 14 && (peak << (shift + 1)) < (1 << 14))
+    {
+        shift++;
+    }
+    while (shift <= 0 && (peak >> -shift) >= (1 << 14))
+    {
+        shift--;
+    }
+
+    // Hann window, w = (1 - cos) / 2, taken from the sine table
+    for (uint16_t i = 0; i < n; i++)
+    {
+        int32_t ac = (int32_t)_samples[i] - mean;
+        ac = shift >= 0 ? ac << shift : ac >> -shift;
+        int32_t window = (32767 - _sine[(i + n / 4) & (n - 1)]) >> 1;
+        _re[i] = (int16_t)((ac * window) >> 15);
+        _im[i] = 0;
+    }
+
+    fft();
+
+    // Strongest bin, skipping DC and the window's leakage into bin 1. The
+    // FFT scales by 1/n, so |X| stays within int16 and |X|^2 within uint32.
+    uint32_t power[3];
+    uint32_t best = 0;
+    uint16_t bin = 0;
+    for (uint16_t k = 2; k < n / 2; k++)
+    {
+        uint32_t p = (int32_t)_re[k] * _re[k] + (int32_t)_im[k] * _im[k];
+        if (p > best)
+        {
+            best = p;
+            bin = k;
+        }
+    }
+    if (bin == 0)
+    {
+        return;
+    }
+    for (int8_t d = -1; d <= 1; d++)
+    {
+        uint16_t k = bin + d;
+        power[d + 1] = k < n / 2 ? (int32_t)_re[k] * _re[k] + (int32_t)_im[k] * _im[k] : 0;
+    }
+
+    // Gaussian interpolation between the neighbouring bins
+    float a = logf(power[0] + 1.0f);
+    float b = logf(power[1] + 1.0f);
+    float c = logf(power[2] + 1.0f);
+    float delta = 0.0f;
+    float curvature = a - 2.0f * b + c;
+    if (curvature < 0.0f)
+    {
+        delta = 0.5f * (a - c) / curvature;
+        delta = delta < -0.5f ? -0.5f : (delta > 0.5f ? 0.5f : delta);
+    }
+
+    // A sine of amplitude A gives |X| = A / 4 at its bin after the Hann
+    // window (gain 1/2) and the 1/n scaling; divide out the window's
+    // response at the offset 'delta' from the bin centre
+    float response = 1.0f;
+    if (fabsf(delta) > 1e-4f)
+    {
+        float x = (float)M_PI * delta;
+        response = sinf(x) / x / (1.0f - delta * delta);
+    }
+    float amplitude = 4.0f * sqrtf((float)power[1]) / response;
+    amplitude = shift >= 0 ? amplitude / (1 << shift) : amplitude * (1 << -shift);
+
+    _result.amplitudeDepth = mean > 0 ? amplitude / mean : 0.0f;
+    if (_result.amplitudeDepth >= FLICKER_MIN_DEPTH)
+    {
+        _result.frequencyHz = (bin + delta) * _rate / n;
+    }
+}
+
+// In-place radix-2 decimation-in-time FFT of _re/_im in Q15. Every stage
+// halves its outputs, so the result is the DFT divided by n and cannot
+// overflow.
+void FlickerAnalyzer::fft()
+{
+    const uint16_t n = FLICKER_SAMPLES;
+
+    for (uint16_t i = 1, j = 0; i < n; i++)
+    {
+        uint16_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            int16_t t = _re[i];
+            _re[i] = _re[j];
+            _re[j] = t;
+            t = _im[i];
+            _im[i] = _im[j];
+            _im[j] = t;
+        }
+    }
+
+    for (uint16_t size = 2; size <= n; size <<= 1)
+    {
+        uint16_t half = size >> 1;
+        uint16_t step = n / size;
+        for (uint16_t k = 0; k < half; k++)
+        {
+            // W = cos - j sin of 2 pi k / size
+            int32_t wr = _sine[k * step + n / 4];
+            int32_t wi = -_sine[k * step];
+            for (uint16_t i = k; i < n; i += size)
+            {
+                uint16_t j = i + half;
+                int32_t tr = (wr * _re[j] - wi * _im[j]) >> 15;
+                int32_t ti = (wr * _im[j] + wi * _re[j]) >> 15;
+                int32_t ur = _re[i];
+                int32_t ui = _im[i];
+                _re[i] = (int16_t)((ur + tr) >> 1);
+                _im[i] = (int16_t)((ui + ti) >> 1);
+                _re[j] = (int16_t)((ur - tr) >> 1);
+                _im[j] = (int16_t)((ui - ti) >> 1);
+            }
+        }
+    }
+}
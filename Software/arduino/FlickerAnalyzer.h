@@ -0,0 +1,84 @@
+#ifndef FLICKER_ANALYZER_H
+#define FLICKER_ANALYZER_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+
+#define FLICKER_SAMPLES 256           // Waveform length, also the FFT size
+#define FLICKER_LOG2_SAMPLES 8
+#define FLICKER_DEFAULT_RATE_HZ 2000  // Resolves flicker up to 1 kHz
+#define FLICKER_MIN_RATE_HZ 400       // FD_TIME tops out at 2048 steps (352 Hz)
+#define FLICKER_BUS_BITS_PER_SAMPLE 25 // Bus clocks to drain one FIFO entry, with headroom
+#define FLICKER_DEFAULT_GAIN 9        // FD gain code (256x, the reset value)
+#define FLICKER_MIN_BURST 16          // FIFO entries worth a burst read
+#define FLICKER_MIN_DEPTH 0.01f       // Weaker modulation counts as steady light
+#define FLICKER_TIMEOUT_MARGIN_MS 100
+
+struct FlickerResult
+{
+    float frequencyHz;     // Dominant component, 0 for steady light
+    float amplitudeDepth;  // Amplitude of that component over the mean
+    float modulationDepth; // (max - min) / (max + min), "percent flicker" / 100
+    float flickerIndex;    // Area above the mean over the total area
+    float meanCounts;      // Mean FD sample
+    float sampleRateHz;
+    uint16_t samples;
+    uint32_t captureMicros; // First burst to last
+    bool valid;             // A complete waveform was analysed
+    bool saturated;         // Some samples clipped; lower the FD gain
+    bool overflow;          // The FIFO overflowed and samples were lost
+};
+
+// Flicker analysis from the raw FD waveform. start() sets the FD sample
+// rate and lets the samples queue up in the FIFO; update(), called from
+// loop(), drains them in bursts sized by FIFO_LVL and, once FLICKER_SAMPLES
+// are in, runs a Q15 FFT for the dominant frequency. Unlike the FD_STATUS
+// 100/120 Hz decision this works for any source below half the sample
+// rate, including PWM-dimmed LEDs.
+class FlickerAnalyzer
+{
+public:
+    FlickerAnalyzer(AS7341 &sensor);
+
+    // Sample rate (Hz) and FD gain code for the following captures. The
+    // rate is capped to what the I2C clock can drain (4 kHz at 100 kHz).
+    void configure(float sampleRateHz, uint8_t gain);
+    float maxRate();
+    bool start();
+    bool update(); // True once, when a new result is ready
+    void cancel();
+    bool busy();
+
+    // start() and update() until done; blocks for FLICKER_SAMPLES samples
+    bool measure();
+
+    const FlickerResult &result();
+    const uint16_t *waveform(); // Samples of the last capture
+    long age();                 // ms since the last valid result, -1 if none
+    uint32_t durationMicros();  // Expected length of one capture
+    uint32_t getBursts();       // Burst reads of the last capture
+
+private:
+    AS7341 *_sensor;
+    FlickerResult _result;
+    bool _busy;
+    uint16_t _count;
+    uint16_t _samples[FLICKER_SAMPLES];
+    int16_t _re[FLICKER_SAMPLES];
+    int16_t _im[FLICKER_SAMPLES];
+    int16_t _sine[FLICKER_SAMPLES]; // One period, Q15
+    float _requestedRate;
+    uint8_t _gain;
+    float _rate;
+    uint32_t _burstMicros;
+    unsigned long _startedAt;
+    unsigned long _nextPollAt;
+    unsigned long _doneAt;
+    uint32_t _bursts;
+
+    void finish();
+    void analyse();
+    void fft();
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "FlickerLock.h"
+#include <math.h>
+
+FlickerLock::FlickerLock()
+{
+    reset();
+}
+
+void FlickerLock::reset()
+{
+    _locked = false;
+    _source = 0.0f;
+    _hz = 0.0f;
+    _cycles = 0;
+    _steps = 0;
+    _phaseError = 0.0f;
+}
+
+bool FlickerLock::apply(const FlickerResult &result, SensorConfig &config)
+{
+    return apply(result.overflow ? _source : result.frequencyHz, config);
+}
+
+bool FlickerLock::apply(float hz, SensorConfig &config)
+{
+    _source = hz;
+    _locked = false;
+    if (hz < LOCK_MIN_HZ)
+    {
+        return false;
+    }
+
+    // Mains-driven flicker sits at exactly twice the line frequency
+    static const float mains[2] = {100.0f, 120.0f};
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (fabsf(hz - mains[i]) <= mains[i] * LOCK_MAINS_TOLERANCE)
+        {
+            hz = mains[i];
+        }
+    }
+
+    // Whole cycles nearest to the requested integration, at least one
+    float periodSteps = 1e9f / (hz * LOCK_STEP_NS);
+    uint32_t requested = (config.atime + 1UL) * (config.astep + 1UL);
+    uint32_t cycles = (uint32_t)(requested / periodSteps + 0.5f);
+    uint32_t maxCycles = (uint32_t)(LOCK_MAX_INTEGRATION_US * 1000.0f / LOCK_STEP_NS / periodSteps);
+    cycles = cycles < 1 ? 1 : (cycles > maxCycles && maxCycles > 0 ? maxCycles : cycles);
+    float target = cycles * periodSteps;
+
+    // Best (ATIME + 1) x (ASTEP + 1) factorisation of the target step
+    // count. Below half a step the error is down to quantisation anyway,
+    // so among those prefer the ATIME closest to the requested one.
+    uint32_t bestSteps = 0;
+    uint8_t bestATime = config.atime;
+    uint16_t bestAStep = config.astep;
+    float bestError = target;
+    for (uint16_t a = 1; a <= 256; a++)
+    {
+        uint32_t s = (uint32_t)(target / a + 0.5f);
+        if (s < 1 || s > 65535)
+        {
+            continue;
+        }
+        float error = fabsf((float)(a * s) - target);
+        bool closer = abs((int)a - (config.atime + 1)) < abs((int)bestATime - config.atime);
+        if (error < 0.5f && bestError < 0.5f ? closer : error < bestError)
+        {
+            bestError = error;
+            bestSteps = a * s;
+            bestATime = a - 1;
+            bestAStep = s - 1;
+        }
+    }
+    if (bestSteps == 0)
+    {
+        return false;
+    }
+
+    config.atime = bestATime;
+    config.astep = bestAStep;
+    _locked = true;
+    _hz = hz;
+    _cycles = cycles;
+    _steps = bestSteps;
+    _phaseError = 360.0f * ((float)bestSteps - target) / periodSteps;
+    return true;
+}
+
+bool FlickerLock::locked()
+{
+    return _locked;
+}
+
+float FlickerLock::source()
+{
+    return _source;
+}
+
+float FlickerLock::frequency()
+{
+    return _hz;
+}
+
+uint16_t FlickerLock::cycles()
+{
+    return _cycles;
+}
+
+uint32_t FlickerLock::integrationMicros()
+{
+    return (uint32_t)((uint64_t)_steps * LOCK_STEP_NS / 1000);
+}
+
+float FlickerLock::phaseError()
+{
+    return _phaseError;
+}
+
+float FlickerLock::ripple(float depth)
+{
+    return _locked ? ripple(depth, _cycles + _phaseError / 360.0f) : 0.0f;
+}
+
+float FlickerLock::ripple(float depth, float cycles)
+{
+    // Integral of 1 + m sin over k + d cycles varies with the start phase
+    // by at most m |sin(pi d)| / (pi (k + d)) around its mean
+    if (cycles <= 0.0f)
+    {
+        return depth;
+    }
+    float fraction = cycles - floorf(cycles);
+    return depth * fabsf(sinf((float)M_PI * fraction)) / ((float)M_PI * cycles);
+}
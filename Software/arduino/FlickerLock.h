@@ -0,0 +1,55 @@
+#ifndef FLICKER_LOCK_H
+#define FLICKER_LOCK_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+#include "FlickerAnalyzer.h"
+
+#define LOCK_STEP_NS 2780              // One integration step (ATIME/ASTEP unit)
+#define LOCK_MAINS_TOLERANCE 0.03f     // Snap to 100/120 Hz within 3%
+#define LOCK_MIN_HZ 20.0f              // Slower flicker would need very long integrations
+#define LOCK_MAX_INTEGRATION_US 700000 // Cap on k periods
+
+// Flicker-locked exposure. Under light modulated at a known frequency the
+// reading depends on where in the light cycle the integration starts,
+// unless the integration covers a whole number of cycles. apply() moves
+// ATIME/ASTEP to the nearest such integration time and reports the
+// residual phase error left by the 2.78 us step. Frequencies close to
+// twice the mains frequency are snapped to exactly 100 or 120 Hz, which
+// is more accurate than any measurement of them.
+class FlickerLock
+{
+public:
+    FlickerLock();
+
+    // Rewrites config.atime/astep for flicker at 'hz', keeping the
+    // integration as close as possible to what config asks for. Returns
+    // false and leaves config alone when there is nothing to lock to.
+    bool apply(float hz, SensorConfig &config);
+    // The same for an analyser result. One whose FIFO overflowed has lost
+    // samples, so its frequency is not trusted and the last one is kept.
+    bool apply(const FlickerResult &result, SensorConfig &config);
+    void reset();
+
+    bool locked();
+    float source();    // Frequency passed to the last apply()
+    float frequency(); // Frequency locked to, after snapping
+    uint16_t cycles();
+    uint32_t integrationMicros();
+    float phaseError(); // Integration minus whole cycles, in degrees of one cycle
+
+    // Largest relative change of a reading with the start phase, for a
+    // sinusoidal flicker of the given depth, with and without the lock
+    float ripple(float depth);
+    static float ripple(float depth, float cycles);
+
+private:
+    bool _locked;
+    float _source;
+    float _hz;
+    uint16_t _cycles;
+    uint32_t _steps;
+    float _phaseError;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "FrameAverage.h"
+
+FrameAverage::FrameAverage()
+{
+    _target = 0;
+    reset();
+}
+
+void FrameAverage::begin(uint16_t frames)
+{
+    _target = frames == 0 ? 1 : (frames > AVG_MAX_FRAMES ? AVG_MAX_FRAMES : frames);
+    reset();
+}
+
+void FrameAverage::reset()
+{
+    memset(_sum, 0, sizeof(_sum));
+    memset(_mean, 0, sizeof(_mean));
+    memset(_m2, 0, sizeof(_m2));
+    _count = 0;
+    _gain = 0;
+    _atime = 0;
+    _astep = 0;
+    _firstSequence = 0;
+    _firstMicros = 0;
+    _lastMicros = 0;
+}
+
+bool FrameAverage::add(const SpectralFrame &frame)
+{
+    if (!active())
+    {
+        return false;
+    }
+
+    // Averaging frames taken with different settings would mix units
+    uint8_t gain = frame.gain(SPECTRAL_PHASE_F1F4);
+    if (_count > 0 && (gain != _gain || frame.atime != _atime || frame.astep != _astep))
+    {
+        reset();
+    }
+    if (_count == 0)
+    {
+        _gain = gain;
+        _atime = frame.atime;
+        _astep = frame.astep;
+        _firstSequence = frame.sequence;
+        _firstMicros = frame.phaseMicros[0] < frame.phaseMicros[1] ? frame.phaseMicros[0] : frame.phaseMicros[1];
+    }
+    _lastMicros = frame.phaseMicros[0] > frame.phaseMicros[1] ? frame.phaseMicros[0] : frame.phaseMicros[1];
+
+    _count++;
+    float n = _count;
+    for (uint8_t phase = 0; phase < SPECTRAL_PHASES; phase++)
+    {
+        for (uint8_t adc = 0; adc < SPECTRAL_ADCS; adc++)
+        {
+            uint16_t x = frame.adc[phase][adc];
+            _sum[phase][adc] += x;
+            float delta = x - _mean[phase][adc];
+            _mean[phase][adc] += delta / n;
+            _m2[phase][adc] += delta * (x - _mean[phase][adc]);
+        }
+    }
+    return _count == _target;
+}
+
+bool FrameAverage::active()
+{
+    return _target > 0 && _count < _target;
+}
+
+bool FrameAverage::done()
+{
+    return _target > 0 && _count == _target;
+}
+
+uint16_t FrameAverage::count()
+{
+    return _count;
+}
+
+uint16_t FrameAverage::target()
+{
+    return _target;
+}
+
+uint32_t FrameAverage::firstSequence()
+{
+    return _firstSequence;
+}
+
+uint32_t FrameAverage::elapsedMicros()
+{
+    return _lastMicros - _firstMicros;
+}
+
+float FrameAverage::mean(uint8_t channel)
+{
+    uint8_t phase, adc;
+    slot(channel, phase, adc);
+    // The exact sum, not the running mean, which carries float rounding
+    return _count == 0 ? 0 : (float)_sum[phase][adc] / _count;
+}
+
+float FrameAverage::stddev(uint8_t channel)
+{
+    uint8_t phase, adc;
+    slot(channel, phase, adc);
+    return _count < 2 ? 0 : sqrtf(_m2[phase][adc] / (_count - 1));
+}
+
+float FrameAverage::snr(uint8_t channel)
+{
+    float sd = stddev(channel);
+    return sd > 0 ? mean(channel) / sd : 0;
+}
+
+void FrameAverage::slot(uint8_t channel, uint8_t &phase, uint8_t &adc)
+{
+    // Same mapping as SpectralFrame::channel()
+    if (channel < 4)
+    {
+        phase = SPECTRAL_PHASE_F1F4;
+        adc = channel;
+    }
+    else
+    {
+        phase = SPECTRAL_PHASE_F5F8;
+        adc = channel < 8 ? channel - 4 : SPECTRAL_ADC_NIR;
+    }
+}
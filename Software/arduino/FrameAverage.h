@@ -0,0 +1,53 @@
+#ifndef FRAME_AVERAGE_H
+#define FRAME_AVERAGE_H
+
+#include <Arduino.h>
+#include "SpectralFrame.h"
+
+#define AVG_MAX_FRAMES 4096 // Keeps the 32-bit sums far from overflow
+
+// N-frame averaging with constant memory: per ADC a 32-bit sum for the
+// mean and Welford's running mean/M2 for the variance, so frames are
+// folded in as they are published and nothing is buffered. Frames must
+// share gain, ATIME and ASTEP; a frame with other settings restarts the
+// average.
+class FrameAverage
+{
+public:
+    FrameAverage();
+
+    void begin(uint16_t frames);
+    void reset();
+
+    // Folds a frame in; true when it completed the requested count
+    bool add(const SpectralFrame &frame);
+
+    bool active(); // Started and not yet complete
+    bool done();
+    uint16_t count();
+    uint16_t target();
+    uint32_t firstSequence();
+    uint32_t elapsedMicros(); // First to last frame readout
+
+    // Per channel (F1-F8 + NIR, index 0-8) in raw counts
+    float mean(uint8_t channel);
+    float stddev(uint8_t channel); // Sample standard deviation
+    float snr(uint8_t channel);    // mean / stddev, 0 while undefined
+
+private:
+    uint32_t _sum[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    float _mean[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    float _m2[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    uint16_t _count;
+    uint16_t _target;
+    uint8_t _gain;
+    uint8_t _atime;
+    uint16_t _astep;
+    uint32_t _firstSequence;
+    uint32_t _firstMicros;
+    uint32_t _lastMicros;
+
+    static void slot(uint8_t channel, uint8_t &phase, uint8_t &adc);
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "HdrFusion.h"
+
+static uint32_t frameMicros(const SensorConfig &config)
+{
+    // Two phases per frame
+    return 2 * (((uint64_t)(config.atime + 1) * (config.astep + 1) * 278) / 100);
+}
+
+float HdrSpectrum::channel(uint8_t index) const
+{
+    if (index < 4)
+    {
+        return basic[SPECTRAL_PHASE_F1F4][index];
+    }
+    if (index < 8)
+    {
+        return basic[SPECTRAL_PHASE_F5F8][index - 4];
+    }
+    return index == 8 ? basic[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR] : 0;
+}
+
+float HdrSpectrum::channelWeight(uint8_t index) const
+{
+    if (index < 4)
+    {
+        return weight[SPECTRAL_PHASE_F1F4][index];
+    }
+    if (index < 8)
+    {
+        return weight[SPECTRAL_PHASE_F5F8][index - 4];
+    }
+    return index == 8 ? weight[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR] : 0;
+}
+
+HdrFusion::HdrFusion()
+{
+    _budgetMs = HDR_DEFAULT_BUDGET_MS;
+    _count = 0;
+    _received = 0;
+    _firstMicros = 0;
+    memset(&_result, 0, sizeof(_result));
+}
+
+void HdrFusion::setBudget(uint32_t ms)
+{
+    _budgetMs = ms;
+}
+
+void HdrFusion::plan(const SensorConfig &base)
+{
+    // Base exposure first, then brighter and darker; codes that fall off
+    // the 0-10 range are dropped rather than duplicated
+    _count = 0;
+    _bracket[_count++] = base;
+    if (base.gain + HDR_GAIN_STEP <= 10)
+    {
+        _bracket[_count] = base;
+        _bracket[_count++].gain = base.gain + HDR_GAIN_STEP;
+    }
+    if (base.gain >= HDR_GAIN_STEP)
+    {
+        _bracket[_count] = base;
+        _bracket[_count++].gain = base.gain - HDR_GAIN_STEP;
+    }
+
+    // Shorten every exposure alike until the bracket fits the budget
+    uint8_t atime = base.atime;
+    while (atime > 0 && _count * frameMicros(_bracket[0]) > _budgetMs * 1000UL)
+    {
+        atime--;
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            _bracket[i].atime = atime;
+        }
+    }
+
+    memset(&_result, 0, sizeof(_result));
+    _result.plannedMicros = _count * frameMicros(_bracket[0]);
+    _received = 0;
+}
+
+uint8_t HdrFusion::exposures()
+{
+    return _count;
+}
+
+const SensorConfig &HdrFusion::exposure(uint8_t index)
+{
+    return _bracket[index < _count ? index : 0];
+}
+
+bool HdrFusion::add(uint8_t index, const SpectralFrame &frame)
+{
+    if (index >= _count)
+    {
+        return false;
+    }
+    if (_received == 0)
+    {
+        _firstMicros = frame.phaseMicros[0] < frame.phaseMicros[1] ? frame.phaseMicros[0] : frame.phaseMicros[1];
+    }
+    fuse(index, frame);
+    _received++;
+
+    if (_received < _count)
+    {
+        return false;
+    }
+    uint32_t last = frame.phaseMicros[0] > frame.phaseMicros[1] ? frame.phaseMicros[0] : frame.phaseMicros[1];
+    _result.captureMicros = last - _firstMicros;
+    _result.sequence = frame.sequence;
+    _result.exposures = _count;
+    return true;
+}
+
+const HdrSpectrum &HdrFusion::result()
+{
+    return _result;
+}
+
+void HdrFusion::fuse(uint8_t index, const SpectralFrame &frame)
+{
+    uint32_t steps = (frame.atime + 1UL) * (frame.astep + 1UL);
+    float fullScale = steps < 65535 ? steps : 65535;
+    _basic.setTiming(frame.atime, frame.astep);
+
+    for (uint8_t phase = 0; phase < SPECTRAL_PHASES; phase++)
+    {
+        // ASAT means some ADC of the phase clipped (analog or digital); the
+        // flag is per phase, so readings near full scale are not trusted
+        bool asat = (frame.astatus[phase] & AS7341_ASTATUS_ASAT_STATUS) != 0;
+        float limit = fullScale * (asat ? HDR_ASAT_FILL : HDR_SATURATION_FILL);
+        uint8_t gain = frame.gain(phase);
+
+        for (uint8_t adc = 0; adc < SPECTRAL_ADCS; adc++)
+        {
+            uint16_t counts = frame.adc[phase][adc];
+            bool usable = counts < limit;
+            bool first = _received == 0;
+
+            // The strongest usable reading has the best signal to noise.
+            // Until something usable turns up, keep the reading taken at
+            // the lowest gain as a lower bound with zero weight.
+            bool take;
+            if (usable)
+            {
+                take = first || !_usable[phase][adc] || counts > _counts[phase][adc];
+            }
+            else
+            {
+                take = first || (!_usable[phase][adc] && gain < _bracket[_result.source[phase][adc]].gain);
+            }
+            if (!take)
+            {
+                continue;
+            }
+
+            float weight = usable ? counts / (float)HDR_CONFIDENT_COUNTS : 0;
+            _result.basic[phase][adc] = BasicCounts::toFloat(_basic.normalise(counts, gain));
+            _result.weight[phase][adc] = weight > 1 ? 1 : weight;
+            _result.source[phase][adc] = index;
+            _counts[phase][adc] = counts;
+            _usable[phase][adc] = usable;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef HDR_FUSION_H
+#define HDR_FUSION_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+#include "SpectralFrame.h"
+#include "BasicCounts.h"
+
+#define HDR_MAX_EXPOSURES 3
+#define HDR_GAIN_STEP 4            // Gain codes between brackets (16x)
+#define HDR_DEFAULT_BUDGET_MS 1000 // Upper bound on the whole bracket
+#define HDR_SATURATION_FILL 0.9f   // Readings above this fraction of full scale are not used
+#define HDR_ASAT_FILL 0.5f         // Stricter limit for phases flagged ASAT
+#define HDR_CONFIDENT_COUNTS 1000  // Counts for full confidence (~3% shot noise)
+
+// Fused result: basic counts (counts per 1x gain per ms of integration)
+// for every ADC slot of both phases, with a confidence weight each
+struct HdrSpectrum
+{
+    float basic[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    float weight[SPECTRAL_PHASES][SPECTRAL_ADCS]; // 0 = saturated in every exposure
+    uint8_t source[SPECTRAL_PHASES][SPECTRAL_ADCS]; // Exposure each value came from
+    uint32_t sequence;        // Sequence of the last frame in the bracket
+    uint8_t exposures;
+    uint32_t plannedMicros;   // Integration time of the planned bracket
+    uint32_t captureMicros;   // First to last readout, including overhead
+
+    // F1-F8 + NIR, mapped like SpectralFrame::channel()
+    float channel(uint8_t index) const;
+    float channelWeight(uint8_t index) const;
+};
+
+// High-dynamic-range capture: plans a bracket of gain/ATIME settings
+// around a base configuration, takes one frame per bracket entry and fuses
+// them per ADC, keeping the strongest reading that is not saturated.
+class HdrFusion
+{
+public:
+    HdrFusion();
+
+    void setBudget(uint32_t ms);
+
+    // Plans the bracket: base gain, then HDR_GAIN_STEP codes above and
+    // below, ATIME shortened if needed to fit the budget
+    void plan(const SensorConfig &base);
+    uint8_t exposures();
+    const SensorConfig &exposure(uint8_t index);
+
+    // Feeds the frame for exposure 'index'; true once the bracket is complete
+    bool add(uint8_t index, const SpectralFrame &frame);
+
+    const HdrSpectrum &result();
+
+private:
+    uint32_t _budgetMs;
+    SensorConfig _bracket[HDR_MAX_EXPOSURES];
+    uint8_t _count;
+    uint8_t _received;
+    uint32_t _firstMicros;
+    HdrSpectrum _result;
+    BasicCounts _basic;
+    uint16_t _counts[SPECTRAL_PHASES][SPECTRAL_ADCS]; // Raw counts behind each fused value
+    bool _usable[SPECTRAL_PHASES][SPECTRAL_ADCS];
+
+    void fuse(uint8_t index, const SpectralFrame &frame);
+};
+
+#endif
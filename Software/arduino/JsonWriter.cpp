@@ -0,0 +1,205 @@
+#include "JsonWriter.h"
+
+JsonWriter::JsonWriter(char *buffer, size_t size)
+{
+    _buffer = buffer;
+    _size = size;
+    _length = 0;
+    _hasMembers = 0;
+    _depth = 0;
+    _overflow = size == 0;
+    if (size > 0)
+    {
+        _buffer[0] = '\0';
+    }
+}
+
+void JsonWriter::beginObject(const char *key)
+{
+    begin(key, '{');
+}
+
+void JsonWriter::endObject()
+{
+    end('}');
+}
+
+void JsonWriter::beginArray(const char *key)
+{
+    begin(key, '[');
+}
+
+void JsonWriter::endArray()
+{
+    end(']');
+}
+
+void JsonWriter::addInt(const char *key, int32_t value)
+{
+    separator(key);
+    if (value < 0)
+    {
+        put('-');
+    }
+    putUnsigned(value < 0 ? 0U - (uint32_t)value : (uint32_t)value, 1);
+}
+
+void JsonWriter::addUnsigned(const char *key, uint32_t value)
+{
+    separator(key);
+    putUnsigned(value, 1);
+}
+
+void JsonWriter::addFloat(const char *key, float value, uint8_t decimals)
+{
+    static const uint32_t scales[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    separator(key);
+    decimals = decimals < 6 ? decimals : 6;
+    float magnitude = fabsf(value);
+    if (!(magnitude < 4.0e9f)) // NaN too
+    {
+        put("null");
+        return;
+    }
+
+    // Integer and fraction apart, so the fraction keeps the float's precision
+    uint32_t whole = (uint32_t)magnitude;
+    uint32_t fraction = (uint32_t)((magnitude - whole) * scales[decimals] + 0.5f);
+    if (fraction >= scales[decimals])
+    {
+        whole++;
+        fraction -= scales[decimals];
+    }
+    if (value < 0 && (whole > 0 || fraction > 0))
+    {
+        put('-');
+    }
+    putUnsigned(whole, 1);
+    if (decimals > 0)
+    {
+        put('.');
+        putUnsigned(fraction, decimals);
+    }
+}
+
+void JsonWriter::addBool(const char *key, bool value)
+{
+    separator(key);
+    put(value ? "true" : "false");
+}
+
+void JsonWriter::addString(const char *key, const char *value)
+{
+    static const char hex[] = "0123456789abcdef";
+    separator(key);
+    put('"');
+    for (const char *c = value; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            put('\\');
+            put(*c);
+        }
+        else if ((uint8_t)*c < 0x20)
+        {
+            put("\\u00");
+            put(hex[(uint8_t)*c >> 4]);
+            put(hex[*c & 0x0F]);
+        }
+        else
+        {
+            put(*c);
+        }
+    }
+    put('"');
+}
+
+const char *JsonWriter::c_str()
+{
+    return _buffer;
+}
+
+size_t JsonWriter::length()
+{
+    return _length;
+}
+
+bool JsonWriter::overflowed()
+{
+    return _overflow;
+}
+
+void JsonWriter::begin(const char *key, char open)
+{
+    separator(key);
+    put(open);
+    if (_depth + 1 < JSON_MAX_DEPTH)
+    {
+        _depth++;
+        _hasMembers &= ~(1UL << _depth);
+    }
+}
+
+void JsonWriter::end(char close)
+{
+    put(close);
+    if (_depth > 0)
+    {
+        _depth--;
+    }
+}
+
+// Comma unless this is the first member at its level, then the key
+void JsonWriter::separator(const char *key)
+{
+    if (_hasMembers & (1UL << _depth))
+    {
+        put(',');
+    }
+    _hasMembers |= 1UL << _depth;
+    if (key)
+    {
+        put('"');
+        put(key);
+        put("\":");
+    }
+}
+
+void JsonWriter::put(char c)
+{
+    if (_length + 1 >= _size)
+    {
+        _overflow = true;
+        return;
+    }
+    _buffer[_length++] = c;
+    _buffer[_length] = '\0';
+}
+
+void JsonWriter::put(const char *text)
+{
+    while (*text)
+    {
+        put(*text++);
+    }
+}
+
+// Decimal digits, zero-padded to at least 'minDigits'
+void JsonWriter::putUnsigned(uint32_t value, uint8_t minDigits)
+{
+    char digits[10];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    while (count < minDigits)
+    {
+        digits[count++] = '0';
+    }
+    while (count > 0)
+    {
+        put(digits[--count]);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+#define JSON_MAX_DEPTH 16
+
+// Writes JSON straight into a caller's buffer, without the heap: numbers
+// are formatted in place, decimals in fixed point. Pass a key for members
+// of an object and NULL for elements of an array. Once the buffer is full
+// the rest is dropped and overflowed() says so; the text stays
+// terminated.
+class JsonWriter
+{
+public:
+    JsonWriter(char *buffer, size_t size);
+
+    void beginObject(const char *key = NULL);
+    void endObject();
+    void beginArray(const char *key = NULL);
+    void endArray();
+
+    void addInt(const char *key, int32_t value);
+    void addUnsigned(const char *key, uint32_t value);
+    // 'decimals' places, rounded; null if not finite or beyond 32 bits
+    void addFloat(const char *key, float value, uint8_t decimals);
+    void addBool(const char *key, bool value);
+    void addString(const char *key, const char *value); // Escaped
+
+    const char *c_str();
+    size_t length();
+    bool overflowed();
+
+private:
+    char *_buffer;
+    size_t _size;
+    size_t _length;
+    uint32_t _hasMembers; // Bit per nesting level
+    uint8_t _depth;
+    bool _overflow;
+
+    void begin(const char *key, char open);
+    void end(char close);
+    void separator(const char *key);
+    void put(char c);
+    void put(const char *text);
+    void putUnsigned(uint32_t value, uint8_t minDigits);
+};
+
+#endif
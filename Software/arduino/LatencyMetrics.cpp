@@ -0,0 +1,185 @@
+#include "LatencyMetrics.h"
+#include <stdarg.h>
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::record(uint32_t us)
+{
+    _counts[bucket(us)]++;
+    _count++;
+    _sum += us;
+    _max = us > _max ? us : _max;
+}
+
+void LatencyHistogram::reset()
+{
+    memset(_counts, 0, sizeof(_counts));
+    _count = 0;
+    _sum = 0;
+    _max = 0;
+}
+
+uint32_t LatencyHistogram::count()
+{
+    return _count;
+}
+
+uint64_t LatencyHistogram::sum()
+{
+    return _sum;
+}
+
+uint32_t LatencyHistogram::max()
+{
+    return _max;
+}
+
+uint32_t LatencyHistogram::percentile(float fraction)
+{
+    if (_count == 0)
+    {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)ceilf(fraction * _count);
+    rank = rank < 1 ? 1 : rank;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++)
+    {
+        seen += _counts[i];
+        if (seen >= rank)
+        {
+            uint32_t upper = bucketLow(i + 1) - 1;
+            return upper < _max ? upper : _max;
+        }
+    }
+    return _max;
+}
+
+uint8_t LatencyHistogram::bucket(uint32_t us)
+{
+    const uint8_t sub = 1 << LATENCY_SUB_BITS;
+    if (us < sub)
+    {
+        return us;
+    }
+    // Octave from the leading bit, position within it from the next two
+    uint8_t msb = 31 - __builtin_clz(us);
+    uint16_t index = (msb - LATENCY_SUB_BITS + 1) * sub + ((us >> (msb - LATENCY_SUB_BITS)) & (sub - 1));
+    return index < LATENCY_BUCKETS ? index : LATENCY_BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketLow(uint8_t index)
+{
+    const uint8_t sub = 1 << LATENCY_SUB_BITS;
+    if (index < sub)
+    {
+        return index;
+    }
+    uint8_t msb = index / sub + LATENCY_SUB_BITS - 1;
+    return (uint32_t)(sub + index % sub) << (msb - LATENCY_SUB_BITS);
+}
+
+LatencyMetrics::LatencyMetrics()
+{
+}
+
+void LatencyMetrics::attach(AS7341 &sensor)
+{
+    sensor.setTimingCallback(onTiming, this);
+}
+
+void LatencyMetrics::record(uint8_t metric, uint32_t us)
+{
+    if (metric < METRIC_COUNT)
+    {
+        _histograms[metric].record(us);
+    }
+}
+
+LatencyHistogram &LatencyMetrics::histogram(uint8_t metric)
+{
+    return _histograms[metric < METRIC_COUNT ? metric : 0];
+}
+
+void LatencyMetrics::reset()
+{
+    for (uint8_t i = 0; i < METRIC_COUNT; i++)
+    {
+        _histograms[i].reset();
+    }
+}
+
+size_t LatencyMetrics::prometheus(char *buffer, size_t size)
+{
+    static const float quantiles[] = {0.5f, 0.95f, 0.99f};
+    static const char *labels[] = {"0.5", "0.95", "0.99"};
+
+    size_t length = 0;
+    append(buffer, size, length, "# HELP spectrometer_latency_seconds Duration of instrumented operations\n");
+    append(buffer, size, length, "# TYPE spectrometer_latency_seconds summary\n");
+    for (uint8_t i = 0; i < METRIC_COUNT; i++)
+    {
+        LatencyHistogram &h = _histograms[i];
+        for (uint8_t q = 0; q < 3; q++)
+        {
+            append(buffer, size, length, "spectrometer_latency_seconds{op=\"%s\",quantile=\"%s\"} %.6f\n", name(i),
+                   labels[q], h.percentile(quantiles[q]) * 1e-6);
+        }
+        append(buffer, size, length, "spectrometer_latency_seconds_sum{op=\"%s\"} %.6f\n", name(i), h.sum() * 1e-6);
+        append(buffer, size, length, "spectrometer_latency_seconds_count{op=\"%s\"} %lu\n", name(i),
+               (unsigned long)h.count());
+    }
+    append(buffer, size, length, "# HELP spectrometer_latency_max_seconds Longest duration seen per operation\n");
+    append(buffer, size, length, "# TYPE spectrometer_latency_max_seconds gauge\n");
+    for (uint8_t i = 0; i < METRIC_COUNT; i++)
+    {
+        append(buffer, size, length, "spectrometer_latency_max_seconds{op=\"%s\"} %.6f\n", name(i),
+               _histograms[i].max() * 1e-6);
+    }
+    return length;
+}
+
+const char *LatencyMetrics::name(uint8_t metric)
+{
+    static const char *names[METRIC_COUNT] = {
+        "smux", "integration", "readout", "register_read", "register_write", "data_json", "data_send",
+        "display_spectrum", "display_wavelength", "display_gain", "display_integration"};
+    return metric < METRIC_COUNT ? names[metric] : "unknown";
+}
+
+void LatencyMetrics::append(char *buffer, size_t size, size_t &length, const char *format, ...)
+{
+    if (length + 1 >= size)
+    {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer + length, size - length, format, args);
+    va_end(args);
+    if (n > 0)
+    {
+        length += (size_t)n < size - length ? n : size - length - 1;
+    }
+}
+
+void LatencyMetrics::onTiming(void *arg, uint8_t event, uint32_t us)
+{
+    ((LatencyMetrics *)arg)->record(event, us);
+}
+
+LatencyScope::LatencyScope(LatencyMetrics &metrics, uint8_t metric)
+{
+    _metrics = &metrics;
+    _metric = metric;
+    _start = micros();
+}
+
+LatencyScope::~LatencyScope()
+{
+    _metrics->record(_metric, micros() - _start);
+}
@@ -0,0 +1,93 @@
+#ifndef LATENCY_METRICS_H
+#define LATENCY_METRICS_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+
+// Four buckets per power of two, exact below 4 us; the last bucket also
+// takes everything from 2^25 us (33 s) on
+#define LATENCY_SUB_BITS 2
+#define LATENCY_BUCKETS 96
+
+// Instrumented operations. The first ones are the driver's timing events.
+#define METRIC_SMUX AS7341_TIMING_SMUX
+#define METRIC_INTEGRATION AS7341_TIMING_INTEGRATION
+#define METRIC_READOUT AS7341_TIMING_READOUT
+#define METRIC_REG_READ AS7341_TIMING_REG_READ
+#define METRIC_REG_WRITE AS7341_TIMING_REG_WRITE
+#define METRIC_DATA_JSON 5           // Building the /data reply
+#define METRIC_SEND 6                // server.send() of the /data reply
+#define METRIC_DISPLAY_SPECTRUM 7    // One redraw of each screen
+#define METRIC_DISPLAY_WAVELENGTH 8
+#define METRIC_DISPLAY_GAIN 9
+#define METRIC_DISPLAY_INTEGRATION 10
+#define METRIC_COUNT 11
+#define METRICS_TEXT_SIZE 6144 // Room for the whole /metrics reply
+
+// Log-scale histogram of durations in microseconds. Recording is a bucket
+// lookup and four adds; percentiles come from the bucket counts, to within
+// the bucket width (at most 25% of the value).
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t count();
+    uint64_t sum();
+    uint32_t max();
+    // Upper bound of the bucket holding the given fraction of the samples,
+    // capped at the largest one seen; 0 when empty
+    uint32_t percentile(float fraction);
+
+    static uint8_t bucket(uint32_t us);
+    static uint32_t bucketLow(uint8_t index);
+
+private:
+    uint32_t _counts[LATENCY_BUCKETS];
+    uint32_t _count;
+    uint64_t _sum;
+    uint32_t _max;
+};
+
+// One histogram per instrumented operation, with the driver's phases and
+// bus transactions fed in through its timing callback
+class LatencyMetrics
+{
+public:
+    LatencyMetrics();
+
+    void attach(AS7341 &sensor);
+    void record(uint8_t metric, uint32_t us);
+    LatencyHistogram &histogram(uint8_t metric);
+    void reset();
+
+    // Prometheus text exposition into 'buffer': a summary with p50/p95/p99,
+    // sum and count per operation, and the maximum as a gauge. Returns the
+    // length; the text is cut short if it does not fit.
+    size_t prometheus(char *buffer, size_t size);
+    static const char *name(uint8_t metric);
+
+private:
+    LatencyHistogram _histograms[METRIC_COUNT];
+
+    static void append(char *buffer, size_t size, size_t &length, const char *format, ...);
+    static void onTiming(void *arg, uint8_t event, uint32_t us);
+};
+
+// Records the duration of the enclosing block
+class LatencyScope
+{
+public:
+    LatencyScope(LatencyMetrics &metrics, uint8_t metric);
+    ~LatencyScope();
+
+private:
+    LatencyMetrics *_metrics;
+    uint8_t _metric;
+    unsigned long _start;
+};
+
+#endif
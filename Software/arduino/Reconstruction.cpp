@@ -0,0 +1,133 @@
+#include "Reconstruction.h"
+
+Reconstruction::Reconstruction()
+{
+    memset(_spectrum, 0, sizeof(_spectrum));
+    _sequence = 0;
+    _valid = false;
+}
+
+const int32_t *Reconstruction::compute(const SpectralFrame &frame)
+{
+    if (_valid && frame.sequence == _sequence)
+    {
+        return _spectrum;
+    }
+
+    uint32_t basic[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    _basic.normalise(frame, basic);
+    uint32_t channels[RECON_CHANNELS];
+    uint32_t peak = 0;
+    for (uint8_t i = 0; i < RECON_CHANNELS; i++)
+    {
+        channels[i] = i < 4 ? basic[SPECTRAL_PHASE_F1F4][i]
+                            : (i < 8 ? basic[SPECTRAL_PHASE_F5F8][i - 4] : basic[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR]);
+        peak = channels[i] > peak ? channels[i] : peak;
+    }
+
+    // Block floating point: one shift brings every input below
+    // 2^RECON_INPUT_BITS, which with the matrix scaling keeps the int32
+    // accumulators from overflowing
+    uint8_t shift = 0;
+    while ((peak >> shift) >= (1UL << RECON_INPUT_BITS))
+    {
+        shift++;
+    }
+    int32_t x[RECON_CHANNELS];
+    for (uint8_t i = 0; i < RECON_CHANNELS; i++)
+    {
+        x[i] = (int32_t)((channels[i] + ((1UL << shift) >> 1)) >> shift);
+    }
+
+    kernel(reconMatrix, x, _spectrum);
+
+    // Undo the input shift and the coefficient scaling
+    for (uint16_t b = 0; b < RECON_BINS; b++)
+    {
+        int64_t value = (int64_t)_spectrum[b] << shift;
+        _spectrum[b] = (int32_t)((value + (1LL << (RECON_COEF_FRAC_BITS - 1))) >> RECON_COEF_FRAC_BITS);
+    }
+
+    _sequence = frame.sequence;
+    _valid = true;
+    return _spectrum;
+}
+
+uint32_t Reconstruction::sequence()
+{
+    return _sequence;
+}
+
+uint16_t Reconstruction::wavelength(uint16_t bin)
+{
+    return RECON_START_NM + bin * RECON_STEP_NM;
+}
+
+float Reconstruction::toFloat(int32_t value)
+{
+    return value * (1.0f / BASIC_COUNTS_ONE);
+}
+
+void Reconstruction::kernelScalar(const int16_t *matrix, const int32_t *x, int32_t *out)
+{
+    // Column-major: each channel streams through one contiguous column
+    // (flash reads stay sequential for the cache)
+    memset(out, 0, RECON_BINS_PADDED * sizeof(int32_t));
+    for (uint8_t c = 0; c < RECON_CHANNELS; c++)
+    {
+        const int16_t *column = matrix + c * RECON_BINS_PADDED;
+        int32_t xc = x[c];
+        for (uint16_t b = 0; b < RECON_BINS_PADDED; b++)
+        {
+            out[b] += column[b] * xc;
+        }
+    }
+}
+
+#if defined(__SSE2__)
+void Reconstruction::kernel(const int16_t *matrix, const int32_t *x, int32_t *out)
+{
+    // Eight bins per step. Inputs fit in int16, so the products come from
+    // 16-bit low/high multiplies interleaved into int32 lanes; the two
+    // accumulators stay in registers across all channels.
+    for (uint16_t b = 0; b < RECON_BINS_PADDED; b += 8)
+    {
+        __m128i lo = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        for (uint8_t c = 0; c < RECON_CHANNELS; c++)
+        {
+            __m128i xc = _mm_set1_epi16((int16_t)x[c]);
+            __m128i coef = _mm_loadu_si128((const __m128i *)(matrix + c * RECON_BINS_PADDED + b));
+            __m128i productLo = _mm_mullo_epi16(coef, xc);
+            __m128i productHi = _mm_mulhi_epi16(coef, xc);
+            lo = _mm_add_epi32(lo, _mm_unpacklo_epi16(productLo, productHi));
+            hi = _mm_add_epi32(hi, _mm_unpackhi_epi16(productLo, productHi));
+        }
+        _mm_storeu_si128((__m128i *)(out + b), lo);
+        _mm_storeu_si128((__m128i *)(out + b + 4), hi);
+    }
+}
+#elif defined(__ARM_NEON)
+void Reconstruction::kernel(const int16_t *matrix, const int32_t *x, int32_t *out)
+{
+    // Eight bins per step with widening int16 multiply-accumulates
+    for (uint16_t b = 0; b < RECON_BINS_PADDED; b += 8)
+    {
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+        for (uint8_t c = 0; c < RECON_CHANNELS; c++)
+        {
+            int16x8_t coef = vld1q_s16(matrix + c * RECON_BINS_PADDED + b);
+            lo = vmlal_n_s16(lo, vget_low_s16(coef), (int16_t)x[c]);
+            hi = vmlal_n_s16(hi, vget_high_s16(coef), (int16_t)x[c]);
+        }
+        vst1q_s32(out + b, lo);
+        vst1q_s32(out + b + 4, hi);
+    }
+}
+#else
+void Reconstruction::kernel(const int16_t *matrix, const int32_t *x, int32_t *out)
+{
+    kernelScalar(matrix, x, out);
+}
+#endif
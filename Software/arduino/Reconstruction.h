@@ -0,0 +1,50 @@
+#ifndef RECONSTRUCTION_H
+#define RECONSTRUCTION_H
+
+#include <Arduino.h>
+#include "SpectralFrame.h"
+#include "BasicCounts.h"
+#include "ReconstructionMatrix.h"
+
+#define RECON_INPUT_BITS 14 // Inputs are scaled to this range before the kernel
+
+// Host builds get a vectorised kernel; the ESP32 has no SIMD unit for it
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RECON_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RECON_SIMD 1
+#else
+#define RECON_SIMD 0
+#endif
+
+// Dense spectrum from the nine channels: a calibration matrix in flash
+// (ReconstructionMatrix.h, generated by host/gen_reconstruction.py) maps
+// F1-F8 and NIR basic counts to RECON_BINS wavelength bins. The result is
+// computed on request and kept until a newer frame is asked for.
+class Reconstruction
+{
+public:
+    Reconstruction();
+
+    // Spectrum of the frame in Q16.16 basic counts per nm (RECON_BINS values)
+    const int32_t *compute(const SpectralFrame &frame);
+    uint32_t sequence(); // Frame the cached spectrum belongs to
+
+    static uint16_t wavelength(uint16_t bin);
+    static float toFloat(int32_t value);
+
+    // out[b] = sum over channels of matrix[c][b] * x[c] for all padded
+    // bins; x must be below 2^RECON_INPUT_BITS
+    static void kernelScalar(const int16_t *matrix, const int32_t *x, int32_t *out);
+    static void kernel(const int16_t *matrix, const int32_t *x, int32_t *out);
+
+private:
+    BasicCounts _basic;
+    int32_t _spectrum[RECON_BINS_PADDED];
+    uint32_t _sequence;
+    bool _valid;
+};
+
+#endif
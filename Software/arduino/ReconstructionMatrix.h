@@ -0,0 +1,130 @@
+// Generated by Software/host/gen_reconstruction.py - do not edit.
+//
+// Channels (F1-F8, NIR in basic counts) to a 380-1000 nm spectrum in
+// 5 nm bins (basic counts per nm), Wiener estimate from nominal
+// Gaussian channel responses. Column-major: RECON_BINS_PADDED coefficients
+// per channel, Q19.
+#ifndef RECONSTRUCTION_MATRIX_H
+#define RECONSTRUCTION_MATRIX_H
+
+#include <Arduino.h>
+
+#define RECON_START_NM 380
+#define RECON_STEP_NM 5
+#define RECON_BINS 125
+#define RECON_BINS_PADDED 128
+#define RECON_CHANNELS 9
+#define RECON_COEF_FRAC_BITS 19
+
+const int16_t reconMatrix[RECON_CHANNELS * RECON_BINS_PADDED] PROGMEM = {
+    // F1
+    19050, 21384, 23235, 24391, 24674, 23973, 22261, 19615, 16212, 12319, 8261, 4379,
+    991, -1654, -3404, -4223, -4190, -3478, -2323, -988, 283, 1293, 1918, 2114,
+    1914, 1410, 731, 14, -614, -1063, -1283, -1270, -1057, -706, -294, 105,
+    429, 635, 707, 651, 493, 270, 27, -198, -371, -472, -495, -445,
+    -335, -187, -24, 131, 261, 352, 399, 401, 362, 291, 198, 94,
+    -10, -106, -189, -253, -297, -321, -328, -320, -301, -273, -241, -207,
+    -173, -142, -113, -89, -68, -51, -38, -27, -19, -13, -9, -6,
+    -4, -3, -2, -1, -1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F2
+    -12788, -13468, -13445, -12555, -10694, -7851, -4128, 252, 4959, 9586, 13693, 16866,
+    18776, 19230, 18199, 15832, 12435, 8429, 4290, 483, -2602, -4700, -5700, -5644,
+    -4714, -3183, -1376, 391, 1852, 2827, 3235, 3092, 2499, 1612, 610, -335,
+    -1083, -1544, -1688, -1533, -1145, -614, -39, 485, 885, 1116, 1163, 1039,
+    778, 430, 50, -313, -615, -827, -934, -936, -844, -678, -461, -219,
+    25, 249, 441, 590, 692, 749, 765, 746, 701, 636, 561, 482,
+    404, 330, 264, 207, 158, 119, 88, 63, 45, 31, 21, 14,
+    9, 6, 4, 2, 1, 1, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F3
+    6287, 6452, 6230, 5559, 4427, 2883, 1048, -888, -2682, -4065, -4775, -4608,
+    -3448, -1305, 1676, 5220, 8951, 12442, 15268, 17074, 17622, 16829, 14782, 11725,
+    8019, 4095, 387, -2722, -4955, -6165, -6352, -5644, -4273, -2528, -709, 911,
+    2129, 2824, 2970, 2622, 1900, 964, -20, -899, -1556, -1922, -1977, -1747,
+    -1294, -700, -58, 549, 1051, 1401, 1575, 1573, 1414, 1132, 767, 361,
+    -47, -422, -741, -989, -1160, -1254, -1279, -1247, -1171, -1063, -938, -805,
+    -674, -551, -441, -345, -264, -199, -146, -105, -75, -52, -35, -24,
+    -16, -10, -6, -4, -2, -1, -1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F4
+    -3282, -3335, -3178, -2787, -2161, -1338, -392, 567, 1406, 1986, 2184, 1924,
+    1190, 48, -1356, -2805, -4037, -4784, -4813, -3969, -2206, 394, 3619, 7157,
+    10625, 13629, 15814, 16916, 16802, 15485, 13123, 9998, 6470, 2930, -254, -2782,
+    -4459, -5212, -5087, -4234, -2875, -1269, 327, 1693, 2668, 3165, 3172, 2744,
+    1983, 1025, 7, -939, -1710, -2238, -2490, -2469, -2207, -1757, -1181, -545,
+    89, 672, 1166, 1548, 1810, 1953, 1991, 1939, 1818, 1651, 1455, 1249,
+    1045, 855, 683, 535, 410, 308, 226, 163, 116, 80, 55, 37,
+    24, 16, 10, 6, 4, 2, 1, 1, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F5
+    1743, 1763, 1670, 1452, 1111, 670, 171, -325, -747, -1021, -1089, -915,
+    -503, 98, 800, 1477, 1989, 2204, 2022, 1402, 378, -936, -2353, -3632,
+    -4517, -4770, -4215, -2771, -476, 2510, 5918, 9401, 12576, 15079, 16612, 16983,
+    16138, 14162, 11271, 7782, 4065, 502, -2568, -4881, -6280, -6723, -6278, -5104,
+    -3424, -1488, 454, 2187, 3543, 4421, 4783, 4649, 4088, 3201, 2105, 918,
+    -250, -1313, -2207, -2892, -3356, -3604, -3660, -3555, -3328, -3016, -2655, -2277,
+    -1904, -1556, -1243, -972, -745, -559, -411, -297, -210, -146, -99, -67,
+    -44, -28, -18, -11, -7, -4, -2, -1, -1, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F6
+    -950, -959, -906, -785, -597, -356, -85, 182, 407, 549, 578, 476,
+    248, -78, -451, -801, -1052, -1135, -1001, -639, -76, 613, 1317, 1901,
+    2229, 2188, 1715, 810, -449, -1907, -3352, -4539, -5221, -5193, -4321, -2576,
+    -38, 3098, 6549, 9972, 13006, 15324, 16665, 16877, 15926, 13902, 11005, 7517,
+    3767, 91, -3205, -5873, -7747, -8748, -8887, -8248, -6974, -5246, -3255, -1189,
+    787, 2545, 3992, 5079, 5793, 6151, 6195, 5982, 5573, 5032, 4417, 3778,
+    3155, 2574, 2054, 1605, 1228, 921, 678, 489, 346, 240, 164, 109,
+    72, 46, 29, 18, 11, 7, 4, 2, 1, 1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F7
+    329, 332, 313, 271, 206, 122, 28, -64, -141, -189, -198, -161,
+    -82, 31, 159, 277, 360, 383, 331, 202, 7, -228, -461, -645,
+    -737, -698, -513, -190, 238, 709, 1144, 1458, 1573, 1432, 1014, 343,
+    -512, -1438, -2293, -2921, -3175, -2937, -2138, -768, 1115, 3390, 5886, 8399,
+    10715, 12632, 13982, 14651, 14583, 13787, 12334, 10341, 7963, 5372, 2739, 225,
+    -2039, -3954, -5458, -6526, -7169, -7421, -7338, -6988, -6442, -5769, -5031, -4281,
+    -3559, -2894, -2303, -1796, -1372, -1027, -755, -544, -384, -267, -182, -121,
+    -80, -51, -32, -20, -12, -7, -4, -3, -1, -1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // F8
+    -104, -105, -99, -86, -65, -39, -9, 20, 45, 60, 62, 51,
+    25, -10, -51, -88, -113, -120, -103, -62, 0, 74, 146, 203,
+    229, 215, 154, 51, -83, -228, -359, -449, -474, -419, -278, -64,
+    199, 472, 708, 859, 882, 750, 452, 2, -559, -1170, -1754, -2224,
+    -2494, -2491, -2162, -1479, -448, 895, 2486, 4238, 6049, 7813, 9428, 10805,
+    11874, 12593, 12940, 12924, 12574, 11936, 11069, 10039, 8912, 7747, 6600, 5511,
+    4513, 3625, 2857, 2209, 1676, 1249, 913, 656, 462, 320, 217, 145,
+    95, 61, 39, 24, 15, 9, 5, 3, 2, 1, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // NIR
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 1, 1, 3, 4, 7, 11,
+    17, 27, 42, 63, 94, 137, 196, 278, 387, 530, 714, 947,
+    1236, 1588, 2006, 2495, 3052, 3675, 4353, 5074, 5820, 6569, 7295, 7972,
+    8572, 9070, 9442, 9672, 9749, 9668, 9433, 9055, 8551, 7944, 7260, 6525,
+    5767, 5013, 4284, 3598, 2970, 0, 0, 0,
+};
+
+#endif
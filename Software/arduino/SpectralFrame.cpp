@@ -0,0 +1,121 @@
+#include "SpectralFrame.h"
+
+uint16_t SpectralFrame::channel(uint8_t index) const
+{
+    if (index < 4)
+    {
+        return adc[SPECTRAL_PHASE_F1F4][index];
+    }
+    if (index < 8)
+    {
+        return adc[SPECTRAL_PHASE_F5F8][index - 4];
+    }
+    return index == 8 ? adc[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR] : 0;
+}
+
+uint16_t SpectralFrame::clear(uint8_t phase) const
+{
+    return adc[phase][SPECTRAL_ADC_CLEAR];
+}
+
+uint16_t SpectralFrame::nir(uint8_t phase) const
+{
+    return adc[phase][SPECTRAL_ADC_NIR];
+}
+
+uint8_t SpectralFrame::gain(uint8_t phase) const
+{
+    return astatus[phase] & AS7341_ASTATUS_AGAIN_STATUS;
+}
+
+bool SpectralFrame::saturated() const
+{
+    return ((astatus[0] | astatus[1]) & AS7341_ASTATUS_ASAT_STATUS) != 0;
+}
+
+uint32_t SpectralFrame::integrationMicros() const
+{
+    return ((uint64_t)(atime + 1) * (astep + 1) * 278) / 100;
+}
+
+// Byte by byte, so the layout does not depend on the host's endianness
+static uint8_t *putLE(uint8_t *out, uint32_t value, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        *out++ = value >> (8 * i);
+    }
+    return out;
+}
+
+size_t SpectralFrame::pack(uint8_t flags, uint8_t *buffer) const
+{
+    uint8_t *out = buffer;
+    out = putLE(out, FRAME_PACKET_VERSION, 1);
+    out = putLE(out, flags | (saturated() ? FRAME_FLAG_SATURATED : 0), 1);
+    out = putLE(out, gain(SPECTRAL_PHASE_F1F4), 1);
+    out = putLE(out, gain(SPECTRAL_PHASE_F5F8), 1);
+    out = putLE(out, sequence, 4);
+    out = putLE(out, phaseMicros[SPECTRAL_PHASE_F5F8], 4);
+    out = putLE(out, astep, 2);
+    out = putLE(out, atime, 1);
+    out = putLE(out, mode, 1);
+    for (uint8_t i = 0; i < SPECTRAL_CHANNELS; i++)
+    {
+        out = putLE(out, channel(i), 2);
+    }
+    for (uint8_t phase = 0; phase < SPECTRAL_PHASES; phase++)
+    {
+        out = putLE(out, clear(phase), 2);
+    }
+    return out - buffer;
+}
+
+FrameRing::FrameRing()
+{
+    memset(_frames, 0, sizeof(_frames));
+    _head = 0;
+    _count = 0;
+}
+
+void FrameRing::push(const SpectralFrame &frame)
+{
+    _frames[_head] = frame;
+    _head = (_head + 1) % FRAME_RING_SIZE;
+    if (_count < FRAME_RING_SIZE)
+    {
+        _count++;
+    }
+}
+
+uint8_t FrameRing::count()
+{
+    return _count;
+}
+
+const SpectralFrame *FrameRing::latest()
+{
+    return recent(0);
+}
+
+const SpectralFrame *FrameRing::recent(uint8_t age)
+{
+    if (age >= _count)
+    {
+        return NULL;
+    }
+    return &_frames[(_head + FRAME_RING_SIZE - 1 - age) % FRAME_RING_SIZE];
+}
+
+const SpectralFrame *FrameRing::find(uint32_t sequence)
+{
+    for (uint8_t age = 0; age < _count; age++)
+    {
+        const SpectralFrame *frame = recent(age);
+        if (frame->sequence == sequence)
+        {
+            return frame;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,85 @@
+#ifndef SPECTRAL_FRAME_H
+#define SPECTRAL_FRAME_H
+
+#include <Arduino.h>
+#include "AS7341.h"
+
+#define SPECTRAL_CHANNELS 9 // F1-F8 + NIR
+#define SPECTRAL_PHASES 2   // SMUX halves: F1-F4 and F5-F8, each with Clear and NIR
+#define SPECTRAL_ADCS 6
+#define FRAME_RING_SIZE 16
+
+// ADC slots within a phase
+#define SPECTRAL_ADC_CLEAR 4
+#define SPECTRAL_ADC_NIR 5
+
+// Phase indices
+#define SPECTRAL_PHASE_F1F4 0
+#define SPECTRAL_PHASE_F5F8 1
+
+// Packed wire form of a frame (/frame.bin), all fields little-endian:
+//   0  u8      FRAME_PACKET_VERSION
+//   1  u8      FRAME_FLAG_* bits
+//   2  u8[2]   gain code per phase (0 = 0.5x)
+//   4  u32     sequence
+//   8  u32     micros() at the F5-F8 readout
+//   12 u16     ASTEP
+//   14 u8      ATIME
+//   15 u8      AS7341_MODE_*
+//   16 u16[9]  F1-F8 + NIR counts
+//   34 u16[2]  Clear counts per phase
+#define FRAME_PACKET_VERSION 1
+#define FRAME_PACKET_SIZE 38
+#define FRAME_FLAG_SATURATED 0x01
+#define FRAME_FLAG_DARK_CORRECTED 0x02 // Flags from here on are the caller's
+#define FRAME_FLAG_MEASURING 0x04
+#define FRAME_FLAG_CONTINUOUS 0x08
+
+// One complete two-phase capture as read from the sensor: every ADC
+// result of both SMUX phases together with the status and the settings
+// that produced them. Fields are ordered by size so the struct has no
+// padding (44 bytes).
+struct SpectralFrame
+{
+    uint32_t sequence;
+    uint32_t phaseMicros[SPECTRAL_PHASES];          // micros() at each phase's readout
+    uint16_t adc[SPECTRAL_PHASES][SPECTRAL_ADCS];   // Raw counts per phase and ADC
+    uint16_t astep;                                 // ASTEP in effect
+    uint8_t astatus[SPECTRAL_PHASES];               // ASTATUS: ASAT flag + gain code per phase
+    uint8_t atime;                                  // ATIME in effect
+    uint8_t mode;                                   // AS7341_MODE_* the frame was taken in
+
+    // F1-F8 + NIR (index 0-8); NIR comes from the F5-F8 phase
+    uint16_t channel(uint8_t index) const;
+    uint16_t clear(uint8_t phase) const;
+    uint16_t nir(uint8_t phase) const;
+
+    // Gain code actually used (from ASTATUS, so it reflects AGC)
+    uint8_t gain(uint8_t phase) const;
+    bool saturated() const;
+    uint32_t integrationMicros() const;
+
+    // Writes FRAME_PACKET_SIZE bytes; FRAME_FLAG_SATURATED is added here
+    size_t pack(uint8_t flags, uint8_t *buffer) const;
+};
+
+// Fixed-size ring holding the most recent frames. Pushing never allocates;
+// the oldest frame is overwritten once the ring is full.
+class FrameRing
+{
+public:
+    FrameRing();
+
+    void push(const SpectralFrame &frame);
+    uint8_t count();
+    const SpectralFrame *latest();
+    const SpectralFrame *recent(uint8_t age); // 0 = latest
+    const SpectralFrame *find(uint32_t sequence);
+
+private:
+    SpectralFrame _frames[FRAME_RING_SIZE];
+    uint8_t _head; // Next slot to write
+    uint8_t _count;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "TraceLog.h"
+
+TraceLog traceLog;
+
+TraceLog::TraceLog()
+{
+    memset(_entries, 0, sizeof(_entries));
+    _written = 0;
+    _drained = 0;
+    _dropped = 0;
+}
+
+void TraceLog::write(uint8_t level, const char *format, int32_t a, int32_t b, int32_t c, int32_t d)
+{
+    LogEntry &entry = _entries[_written % LOG_RING_SIZE];
+    entry.micros = micros();
+    entry.format = format;
+    entry.args[0] = a;
+    entry.args[1] = b;
+    entry.args[2] = c;
+    entry.args[3] = d;
+    entry.level = level;
+    _written++;
+
+    if (_written - _drained > LOG_RING_SIZE)
+    {
+        _drained++;
+        _dropped++;
+    }
+}
+
+void TraceLog::drain(HardwareSerial &port)
+{
+    char line[LOG_LINE_SIZE];
+    while (_drained != _written)
+    {
+        const LogEntry &entry = _entries[_drained % LOG_RING_SIZE];
+        size_t length = format(entry, line, sizeof(line) - 1, true);
+        if ((size_t)port.availableForWrite() < length + 1)
+        {
+            return; // Next loop() pass
+        }
+        line[length++] = '\n';
+        line[length] = '\0';
+        port.write(line);
+        _drained++;
+    }
+}
+
+uint32_t TraceLog::written()
+{
+    return _written;
+}
+
+uint32_t TraceLog::dropped()
+{
+    return _dropped;
+}
+
+const LogEntry *TraceLog::entry(uint32_t sequence)
+{
+    if (sequence >= _written || sequence < oldest())
+    {
+        return NULL;
+    }
+    return &_entries[sequence % LOG_RING_SIZE];
+}
+
+uint32_t TraceLog::oldest()
+{
+    return _written > LOG_RING_SIZE ? _written - LOG_RING_SIZE : 0;
+}
+
+size_t TraceLog::format(const LogEntry &entry, char *buffer, size_t size, bool stamp)
+{
+    int n = 0;
+    if (stamp)
+    {
+        n = snprintf(buffer, size, "[%4lu.%06lu] %c ", (unsigned long)(entry.micros / 1000000UL),
+                     (unsigned long)(entry.micros % 1000000UL), levelLetter(entry.level));
+        if (n < 0 || (size_t)n >= size)
+        {
+            return n < 0 ? 0 : size - 1;
+        }
+    }
+    int m = snprintf(buffer + n, size - n, entry.format, (long)entry.args[0], (long)entry.args[1],
+                     (long)entry.args[2], (long)entry.args[3]);
+    if (m < 0)
+    {
+        return n;
+    }
+    return (size_t)(n + m) < size ? n + m : size - 1;
+}
+
+char TraceLog::levelLetter(uint8_t level)
+{
+    static const char letters[] = "-EWID";
+    return level <= LOG_LEVEL_DEBUG ? letters[level] : '?';
+}
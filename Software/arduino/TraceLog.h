@@ -0,0 +1,87 @@
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#include <Arduino.h>
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+// Messages above this level are compiled out, arguments included
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_RING_SIZE 128 // Entries kept for /trace and the serial drain
+#define LOG_MAX_ARGS 4
+#define LOG_LINE_SIZE 112 // Longest formatted line, newline included
+
+// One message as recorded: the format string is not expanded until the
+// entry is drained or served, so logging costs a timestamp and a copy
+struct LogEntry
+{
+    uint32_t micros;
+    const char *format; // String literal with up to LOG_MAX_ARGS %ld
+    int32_t args[LOG_MAX_ARGS];
+    uint8_t level;
+};
+
+// Ring of binary log entries, written from loop() context (not from
+// interrupts). drain() passes them on to the serial port only as fast as
+// its transmit buffer takes them, so a burst of messages never blocks; if
+// the ring wraps first the oldest undrained entries are lost and counted.
+class TraceLog
+{
+public:
+    TraceLog();
+
+    void write(uint8_t level, const char *format, int32_t a = 0, int32_t b = 0, int32_t c = 0, int32_t d = 0);
+
+    // Prints pending entries while the port has room for a whole line
+    void drain(HardwareSerial &port);
+
+    uint32_t written();  // Entries ever written; also the next sequence number
+    uint32_t dropped();  // Lost before reaching the serial port
+    const LogEntry *entry(uint32_t sequence); // NULL once overwritten
+    uint32_t oldest();   // Sequence number of the oldest entry kept
+
+    // "[   1.234567] I message"; returns the length
+    static size_t format(const LogEntry &entry, char *buffer, size_t size, bool stamp);
+    static char levelLetter(uint8_t level);
+
+private:
+    LogEntry _entries[LOG_RING_SIZE];
+    uint32_t _written;
+    uint32_t _drained;
+    uint32_t _dropped;
+};
+
+extern TraceLog traceLog;
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) traceLog.write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) traceLog.write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) traceLog.write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) traceLog.write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif
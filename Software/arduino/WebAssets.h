@@ -0,0 +1,351 @@
+// Generated by Software/host/gen_web_assets.py - do not edit.
+//
+// index_html from html_content.h, 26669 bytes gzip-compressed to 5369.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+#define INDEX_HTML_GZ_SIZE 5369
+#define INDEX_HTML_ETAG "\"d444c3384699d415\""
+
+const uint8_t index_html_gz[INDEX_HTML_GZ_SIZE] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x3d, 0x69, 0x73, 0xdb, 0xb6,
+    0xb6, 0xdf, 0xf3, 0x2b, 0x10, 0xb5, 0x2f, 0x22, 0x6b, 0xad, 0xde, 0xea, 0xda, 0x96, 0x33, 0x8e,
+    0x13, 0x37, 0xb9, 0x37, 0x69, 0x3a, 0x71, 0xda, 0x4e, 0x27, 0x2f, 0xe3, 0x0b, 0x89, 0x90, 0xc5,
+    0x86, 0x22, 0xf5, 0x48, 0xca, 0xcb, 0xcb, 0xd5, 0x7f, 0xbf, 0xe7, 0x1c, 0x70, 0x01, 0x41, 0x90,
+    0xa2, 0x92, 0xdc, 0xa6, 0x93, 0xd4, 0x99, 0xda, 0x5c, 0x80, 0x83, 0xb3, 0xe1, 0x6c, 0x00, 0xd8,
+    0x7b, 0xc7, 0xf7, 0x1f, 0xbf, 0x3c, 0x7b, 0xfd, 0xfb, 0xcf, 0x4f, 0xd8, 0x2c, 0x9e, 0x7b, 0x27,
+    0xf7, 0x8e, 0xd3, 0x3f, 0x82, 0x3b, 0x27, 0xf7, 0x18, 0xfc, 0x1c, 0xcf, 0x45, 0xcc, 0x99, 0xcf,
+    0xe7, 0x62, 0xd4, 0xba, 0x76, 0xc5, 0xcd, 0x22, 0x08, 0xe3, 0x16, 0x9b, 0x04, 0x7e, 0x2c, 0xfc,
+    0x78, 0xd4, 0xba, 0x71, 0x9d, 0x78, 0x36, 0x72, 0xc4, 0xb5, 0x3b, 0x11, 0x5d, 0xba, 0xe9, 0x30,
+    0xd7, 0x77, 0x63, 0x97, 0x7b, 0xdd, 0x68, 0xc2, 0x3d, 0x31, 0x1a, 0xb6, 0x12, 0x40, 0xb1, 0x1b,
+    0x7b, 0xe2, 0xe4, 0xe7, 0x60, 0xf2, 0x4e, 0xc4, 0xec, 0x62, 0x21, 0x26, 0x71, 0x18, 0x00, 0x70,
+    0x11, 0x1e, 0xf7, 0xe5, 0x2b, 0xd9, 0x2c, 0x8a, 0xef, 0xd2, 0x6b, 0xfc, 0x19, 0x07, 0xce, 0x1d,
+    0x7b, 0x9f, 0xdd, 0xe2, 0xcf, 0x14, 0x06, 0xef, 0x4e, 0xf9, 0xdc, 0xf5, 0xee, 0x0e, 0xd9, 0x69,
+    0x08, 0x43, 0x75, 0x58, 0xc4, 0xfd, 0xa8, 0x1b, 0x89, 0xd0, 0x9d, 0x1e, 0x15, 0xda, 0x8e, 0xf9,
+    0xe4, 0xdd, 0x55, 0x18, 0x2c, 0x7d, 0xa7, 0x3b, 0x09, 0xbc, 0x20, 0x3c, 0x64, 0xdf, 0x0c, 0xb7,
+    0xf1, 0x5f, 0xb1, 0x59, 0xfa, 0x6e, 0x4a, 0x3f, 0xc5, 0x77, 0x73, 0x1e, 0x5e, 0xb9, 0xfe, 0x21,
+    0x1b, 0x14, 0x1f, 0x2f, 0xb8, 0xe3, 0xb8, 0xfe, 0xd5, 0x21, 0xdb, 0x1e, 0x2c, 0x6e, 0x8b, 0xaf,
+    0x62, 0x71, 0x1b, 0x77, 0xb9, 0xe7, 0x5e, 0x41, 0xaf, 0x09, 0xb0, 0x49, 0x84, 0xf9, 0xfb, 0x55,
+    0x76, 0x35, 0x1b, 0x6a, 0x74, 0xa5, 0x48, 0x0c, 0x76, 0x1e, 0x9f, 0x9e, 0xed, 0x9b, 0x90, 0xe8,
+    0x8e, 0x83, 0x38, 0x0e, 0xe6, 0x87, 0x6c, 0xa7, 0x30, 0x66, 0x0e, 0xb3, 0x87, 0x82, 0xe1, 0xae,
+    0x2f, 0x42, 0x0d, 0xf6, 0x9c, 0xdf, 0x4a, 0xf1, 0x1c, 0xb2, 0x83, 0x41, 0x09, 0xe1, 0x8c, 0x44,
+    0xc6, 0x97, 0x71, 0x60, 0x06, 0x3c, 0xe3, 0x61, 0xdc, 0xad, 0x02, 0x3f, 0x13, 0xee, 0xd5, 0x2c,
+    0x46, 0xbc, 0x2a, 0x61, 0x23, 0xca, 0x25, 0x1e, 0x06, 0x11, 0xa8, 0x4a, 0x00, 0x6f, 0x43, 0xe1,
+    0xf1, 0xd8, 0xbd, 0x16, 0x9a, 0xf4, 0x82, 0xd0, 0x11, 0xc0, 0x92, 0x21, 0x74, 0x8d, 0x02, 0xcf,
+    0x75, 0xd8, 0x37, 0x3b, 0x3b, 0x3b, 0xa6, 0x36, 0xdd, 0x90, 0x3b, 0xee, 0x32, 0x3a, 0x64, 0x7b,
+    0xfa, 0xf8, 0x99, 0x9c, 0x86, 0x25, 0xd4, 0x4c, 0xca, 0x21, 0xf0, 0x9f, 0x91, 0x03, 0x63, 0xae,
+    0x53, 0x9d, 0xa3, 0xcf, 0xc7, 0x80, 0xde, 0x32, 0x2e, 0xa1, 0x2f, 0xa5, 0xb5, 0x5b, 0x1a, 0x39,
+    0x11, 0xc5, 0x4e, 0x13, 0x94, 0x1e, 0x3d, 0x3a, 0xd8, 0x3f, 0x3f, 0xab, 0x25, 0x7a, 0x07, 0xf8,
+    0x83, 0xff, 0x0d, 0x74, 0x06, 0xc7, 0x21, 0xcc, 0x8b, 0x04, 0x47, 0x29, 0x23, 0x36, 0xe8, 0xed,
+    0x44, 0x4c, 0xf0, 0xa8, 0x92, 0xc8, 0xae, 0xc7, 0xc7, 0xc2, 0xfb, 0x40, 0x52, 0xf7, 0x1a, 0x53,
+    0x5a, 0x37, 0x49, 0xb2, 0x59, 0x1e, 0xb9, 0xff, 0x2f, 0x4c, 0x92, 0xab, 0x9a, 0x2a, 0x0a, 0x25,
+    0xd7, 0xdc, 0x5b, 0x8a, 0x0f, 0xa2, 0xe5, 0xbf, 0x8a, 0xf2, 0xcd, 0xcc, 0xd5, 0xc7, 0x8b, 0x83,
+    0xc5, 0x21, 0xeb, 0x6e, 0x57, 0x4d, 0x69, 0xd7, 0x9f, 0x06, 0xdd, 0x05, 0xf7, 0x4b, 0x74, 0x34,
+    0x50, 0xdf, 0xcd, 0x26, 0xc8, 0x9e, 0x79, 0xee, 0x66, 0x56, 0xa7, 0xde, 0xd2, 0x79, 0x62, 0x1a,
+    0x57, 0x13, 0x00, 0x54, 0xcf, 0x4b, 0x36, 0x49, 0x5a, 0x86, 0xa1, 0x66, 0x19, 0xf4, 0xae, 0x26,
+    0x19, 0xd6, 0xd9, 0x4a, 0xc7, 0x8d, 0x16, 0x1e, 0x07, 0xdf, 0xe0, 0xfa, 0x1e, 0xd8, 0xaa, 0xee,
+    0xd8, 0x03, 0x9f, 0x63, 0x14, 0xf1, 0x70, 0xaf, 0x8a, 0xe9, 0xe3, 0x25, 0x90, 0xec, 0xaf, 0x67,
+    0xb8, 0x69, 0xfc, 0x3a, 0x47, 0x93, 0x5a, 0x34, 0x3f, 0xf0, 0x45, 0x95, 0x18, 0xb6, 0x81, 0x1d,
+    0xdb, 0xbb, 0x9b, 0x2a, 0x1f, 0xbd, 0x77, 0xc4, 0x24, 0x08, 0xb9, 0x54, 0xee, 0xf2, 0x10, 0x0d,
+    0x18, 0xa3, 0xaa, 0xf0, 0x7e, 0x95, 0x29, 0x27, 0x81, 0x95, 0x94, 0x65, 0xb2, 0x0c, 0x23, 0xa4,
+    0x7b, 0x11, 0xb8, 0x65, 0xec, 0xd6, 0x29, 0xa1, 0x6a, 0xa8, 0x74, 0x36, 0x93, 0xc9, 0xaa, 0x91,
+    0xd2, 0xe1, 0x2c, 0xb8, 0x2e, 0x79, 0x24, 0x93, 0xac, 0x86, 0x07, 0xdf, 0x1f, 0x98, 0x8d, 0x45,
+    0x24, 0x3c, 0x88, 0x47, 0x84, 0xd3, 0xbd, 0xe1, 0xd7, 0x70, 0xe9, 0x5f, 0xc5, 0x33, 0xa3, 0xb2,
+    0x76, 0x69, 0xae, 0x96, 0xe7, 0x81, 0xca, 0xb6, 0x83, 0x2a, 0x63, 0xa5, 0x1b, 0xf2, 0x7c, 0xfc,
+    0x6f, 0xa2, 0x98, 0xc7, 0xcb, 0xa8, 0x66, 0xc8, 0x6a, 0x13, 0x78, 0x76, 0xbe, 0xbf, 0xff, 0xfd,
+    0x0f, 0x47, 0x46, 0x77, 0x5c, 0x69, 0x53, 0x22, 0x20, 0xb3, 0x5b, 0x1d, 0x2b, 0xd4, 0x91, 0xfa,
+    0xdf, 0xb5, 0x3a, 0xd5, 0x38, 0xba, 0xfe, 0x62, 0x19, 0xeb, 0x96, 0xbc, 0xc6, 0xb7, 0xaf, 0x19,
+    0xbf, 0x51, 0x68, 0x51, 0x26, 0x75, 0xdb, 0xc1, 0x7f, 0x4d, 0x2d, 0x7b, 0xc2, 0xc9, 0x50, 0x4a,
+    0x63, 0x58, 0x15, 0x06, 0x6c, 0x0f, 0x0c, 0x72, 0x3a, 0xee, 0x27, 0x91, 0xf0, 0x71, 0x5f, 0x46,
+    0xe3, 0xc7, 0x18, 0x0a, 0x27, 0x41, 0xb2, 0xe3, 0x5e, 0xb3, 0x89, 0xc7, 0xa3, 0x68, 0xd4, 0xca,
+    0x38, 0xd4, 0xca, 0x83, 0xe6, 0xe3, 0xd9, 0xd0, 0x1c, 0x68, 0xc3, 0xf3, 0xac, 0x51, 0xde, 0x5a,
+    0x81, 0x96, 0x3b, 0x1b, 0x05, 0x9c, 0xb1, 0x11, 0x1a, 0x74, 0xad, 0x8d, 0x8c, 0xdf, 0xa1, 0x77,
+    0xa1, 0x21, 0x99, 0xef, 0xd6, 0xc9, 0x45, 0x32, 0xc5, 0x0e, 0x81, 0x30, 0x68, 0x52, 0xd5, 0xd3,
+    0x75, 0x46, 0x2d, 0xc3, 0x6c, 0x6c, 0x9d, 0x3c, 0x02, 0x77, 0xce, 0xac, 0xdd, 0x83, 0x81, 0x3f,
+    0xb7, 0x4d, 0x20, 0x8e, 0xfb, 0x80, 0xe1, 0x27, 0xc6, 0xf9, 0x47, 0x60, 0x6c, 0x03, 0x7c, 0xaf,
+    0xa0, 0x59, 0x97, 0xe2, 0x8d, 0xd6, 0xc9, 0xed, 0xc1, 0x9f, 0x85, 0xdc, 0x33, 0xb0, 0xb2, 0x57,
+    0xd2, 0xd8, 0xb3, 0xd7, 0xee, 0x5c, 0x34, 0x40, 0xd4, 0xcd, 0xbb, 0x74, 0x63, 0xe8, 0xd2, 0x3a,
+    0x19, 0x0e, 0x06, 0xf3, 0xa8, 0x01, 0xc6, 0xda, 0xad, 0x51, 0x77, 0xb4, 0x14, 0xa1, 0x45, 0x43,
+    0xd2, 0x43, 0x5d, 0x97, 0xee, 0x77, 0xbb, 0xec, 0x11, 0x0f, 0x23, 0x98, 0x00, 0x9e, 0xc7, 0xc6,
+    0x82, 0xc1, 0x3c, 0x16, 0x0e, 0x98, 0xad, 0x50, 0xb0, 0xf1, 0x1d, 0xfb, 0x07, 0xbf, 0xe6, 0x17,
+    0x93, 0xd0, 0x5d, 0xc4, 0xac, 0xdb, 0x6d, 0x80, 0x43, 0xe2, 0xac, 0x13, 0x34, 0xe4, 0x9d, 0x1c,
+    0x7d, 0x0e, 0x81, 0xee, 0x32, 0x04, 0x4f, 0x17, 0xc3, 0x83, 0xc0, 0x9f, 0x78, 0xee, 0xe4, 0xdd,
+    0xa8, 0x15, 0xf3, 0x77, 0xe2, 0x85, 0x7c, 0x33, 0x07, 0x4f, 0x6a, 0xd9, 0xad, 0x93, 0xd7, 0xf0,
+    0x88, 0x29, 0xcf, 0x8e, 0xfb, 0x12, 0xcc, 0x49, 0x93, 0x51, 0x72, 0x35, 0xd5, 0x06, 0x02, 0xe2,
+    0xfd, 0x2b, 0xf1, 0x5b, 0xf6, 0x1a, 0x47, 0x3a, 0xa3, 0x67, 0x2c, 0x7f, 0xb8, 0xd1, 0x50, 0xa4,
+    0x6a, 0xc5, 0x41, 0xb8, 0xf3, 0xc7, 0x32, 0x8a, 0x51, 0x55, 0x11, 0xfc, 0x29, 0xdd, 0x31, 0xbc,
+    0xdd, 0x08, 0xb0, 0xaa, 0x1a, 0x26, 0xf8, 0x8a, 0xb6, 0x29, 0xc3, 0x28, 0x4f, 0x37, 0x1a, 0x0d,
+    0x95, 0xc4, 0xf5, 0x97, 0xc1, 0x32, 0xd2, 0x45, 0x13, 0x5c, 0x5d, 0x79, 0xe2, 0x2c, 0x7b, 0x4d,
+    0x1c, 0xcb, 0xee, 0x0e, 0xd9, 0xcb, 0xe9, 0x74, 0xa3, 0x81, 0xb8, 0x30, 0x0e, 0x70, 0x0a, 0x69,
+    0xee, 0x93, 0x5b, 0x48, 0x04, 0x40, 0xdc, 0x44, 0x0e, 0xdc, 0xb3, 0xf4, 0xc1, 0xe6, 0xa3, 0xcc,
+    0x9c, 0xd0, 0xa0, 0x62, 0x4f, 0x9d, 0x10, 0x61, 0x3f, 0x7d, 0xfc, 0x8a, 0x9d, 0xf1, 0x45, 0x0c,
+    0x90, 0x37, 0x02, 0xea, 0xf0, 0xf0, 0x9d, 0xae, 0x4f, 0x12, 0xcc, 0x63, 0x78, 0x43, 0x8c, 0x91,
+    0xb7, 0x0c, 0xef, 0x37, 0xe3, 0x0a, 0xc4, 0x4b, 0xfc, 0xca, 0x34, 0x2d, 0x4e, 0xe5, 0x1b, 0xe2,
+    0x89, 0xbc, 0x64, 0xb7, 0xc3, 0xfd, 0x32, 0x70, 0xa3, 0x01, 0x28, 0x7a, 0x6c, 0x7d, 0xd2, 0x9b,
+    0xd1, 0xc9, 0x46, 0x77, 0x82, 0x1b, 0xdf, 0x0b, 0xb8, 0xf3, 0x98, 0xc7, 0x1c, 0x87, 0x7f, 0x9c,
+    0xdc, 0x33, 0x7c, 0x60, 0xa0, 0xae, 0xce, 0x20, 0x91, 0x13, 0xa1, 0x90, 0xaa, 0x75, 0xa2, 0x34,
+    0x4c, 0x2e, 0x93, 0x3a, 0x13, 0x19, 0x98, 0x1c, 0x42, 0xbf, 0xcf, 0x70, 0x6a, 0x62, 0x9a, 0x85,
+    0x25, 0x2f, 0x07, 0x46, 0xed, 0xb0, 0x50, 0x40, 0xc0, 0x3c, 0x01, 0xd3, 0x04, 0x56, 0xa9, 0x4f,
+    0x95, 0x30, 0x0b, 0xdc, 0xfc, 0x64, 0xc6, 0xe2, 0x19, 0x58, 0xaa, 0x30, 0xb8, 0x89, 0x20, 0x32,
+    0x99, 0xf0, 0xc9, 0x4c, 0x44, 0x76, 0x06, 0xc9, 0x03, 0xb7, 0x3b, 0x91, 0xa0, 0x5e, 0x60, 0x97,
+    0x91, 0x16, 0xb5, 0xe4, 0xe6, 0x02, 0x14, 0xfa, 0xcd, 0xee, 0x70, 0xaf, 0xc3, 0x76, 0x77, 0xf1,
+    0xd7, 0xc1, 0xa0, 0xc3, 0xf6, 0xf0, 0x76, 0x6f, 0x0f, 0x7f, 0xfd, 0x00, 0xb7, 0xfb, 0x3b, 0xf8,
+    0x0b, 0x5f, 0xfc, 0xb0, 0x3b, 0x78, 0xdb, 0x29, 0xc0, 0xc1, 0xa2, 0x1c, 0x42, 0x68, 0xfd, 0xea,
+    0x06, 0x30, 0x66, 0xab, 0xc3, 0xf0, 0xaa, 0x8b, 0x8e, 0x12, 0xaf, 0xd3, 0xbf, 0x67, 0x77, 0xdc,
+    0xc7, 0xbf, 0x3f, 0x86, 0x42, 0xd0, 0xc5, 0xef, 0xc2, 0xf3, 0x82, 0x1b, 0xbc, 0x7a, 0x19, 0xa2,
+    0x2d, 0xc2, 0xab, 0x57, 0xc2, 0xc1, 0x3f, 0x3f, 0x3d, 0x7b, 0xd5, 0xd2, 0x46, 0x99, 0x86, 0x30,
+    0xcc, 0xe5, 0x18, 0xe3, 0xfe, 0xf7, 0xa0, 0x11, 0x11, 0x85, 0xe8, 0xc3, 0x0e, 0x93, 0xd1, 0xee,
+    0xce, 0x41, 0x1e, 0xb1, 0xad, 0x8e, 0xee, 0xa9, 0xdc, 0x7c, 0x26, 0xcb, 0x80, 0x0c, 0x39, 0x59,
+    0xe0, 0x4d, 0x44, 0x21, 0x09, 0xf7, 0x50, 0xb0, 0xf5, 0xcc, 0x51, 0xb8, 0xd8, 0x53, 0x5e, 0x18,
+    0xd9, 0xa0, 0xb6, 0xa5, 0x47, 0xc5, 0x56, 0xe4, 0x9e, 0x91, 0x5b, 0xc3, 0x6d, 0x60, 0xe6, 0xf6,
+    0x2e, 0xfc, 0xda, 0xd9, 0xc3, 0x2b, 0xe4, 0xed, 0x10, 0x59, 0xbd, 0x8d, 0x2f, 0x76, 0x86, 0x78,
+    0x4b, 0xfc, 0xd6, 0xd9, 0x8d, 0xa6, 0xf7, 0x90, 0x1d, 0x14, 0x1f, 0x2a, 0x66, 0xf3, 0x12, 0x3d,
+    0x2a, 0x46, 0x79, 0x83, 0x62, 0x93, 0x34, 0x9a, 0xb9, 0x74, 0x7d, 0x47, 0xdc, 0x42, 0xb4, 0xa7,
+    0x32, 0xac, 0xa4, 0xbf, 0xc0, 0xb8, 0xf3, 0xa5, 0x3f, 0x21, 0xaf, 0x0e, 0x36, 0x69, 0xb9, 0x00,
+    0xf6, 0x09, 0x52, 0x37, 0xf2, 0xa4, 0x59, 0xbb, 0x69, 0xda, 0x48, 0xb6, 0x38, 0xc3, 0x97, 0x96,
+    0x5d, 0xca, 0x92, 0xfd, 0x28, 0x96, 0x1d, 0xcf, 0xb2, 0x40, 0x7a, 0xc4, 0x9c, 0x60, 0xb2, 0x44,
+    0x27, 0xd7, 0xbb, 0x12, 0xf1, 0x13, 0x8f, 0xfc, 0xdd, 0xa3, 0xbb, 0x67, 0x8e, 0xd5, 0xa6, 0x96,
+    0x6d, 0x5b, 0x0b, 0x6f, 0x0b, 0xdd, 0x21, 0x25, 0x87, 0xdf, 0x4f, 0x5f, 0xbf, 0x78, 0x0e, 0x80,
+    0xda, 0xed, 0x62, 0x53, 0xc3, 0xe0, 0x73, 0x7e, 0xfb, 0x2b, 0xb2, 0x1e, 0x5a, 0xbf, 0xe0, 0xf1,
+    0xac, 0x07, 0xf7, 0x56, 0xaf, 0xd7, 0x53, 0x75, 0x40, 0x96, 0x6a, 0x22, 0x7d, 0xd8, 0x1c, 0xf7,
+    0xdf, 0x30, 0x4c, 0x06, 0x00, 0x1a, 0x26, 0xc1, 0x74, 0x1a, 0x09, 0xf9, 0xd2, 0xd4, 0x75, 0xcc,
+    0xc3, 0xb4, 0xe3, 0xce, 0xc0, 0xd4, 0x00, 0x82, 0x9e, 0x09, 0x64, 0x0f, 0xf0, 0xde, 0x52, 0x86,
+    0xe9, 0x32, 0x2b, 0xeb, 0xf9, 0x5d, 0x41, 0x57, 0x55, 0x15, 0xec, 0xc9, 0xbf, 0xb6, 0xcd, 0xfa,
+    0xcc, 0x5a, 0xd3, 0x88, 0x6d, 0xb1, 0xa1, 0x5d, 0xc3, 0xa8, 0x29, 0xa4, 0xb8, 0x16, 0x4e, 0x0c,
+    0x17, 0x50, 0x19, 0x1c, 0xc1, 0x9f, 0xe3, 0x75, 0xe3, 0x42, 0xa3, 0xad, 0x2d, 0x5d, 0xda, 0x05,
+    0xd2, 0x9f, 0xca, 0x6a, 0xdf, 0x48, 0xc3, 0x4e, 0xb2, 0xfa, 0x8d, 0xfb, 0x16, 0xf0, 0x4e, 0x45,
+    0x63, 0x03, 0x9d, 0xa0, 0xfc, 0x47, 0xd5, 0xc0, 0x9e, 0x8b, 0x29, 0x82, 0x4a, 0x19, 0xb6, 0x05,
+    0x28, 0x7e, 0xa7, 0xb0, 0x69, 0x2b, 0x7d, 0x63, 0x97, 0x61, 0x94, 0x1e, 0xa0, 0x9d, 0x0d, 0x05,
+    0x2a, 0x35, 0xf4, 0xaf, 0x1e, 0x52, 0x55, 0xd3, 0x09, 0xb5, 0x4f, 0x34, 0xd5, 0x6a, 0x83, 0x11,
+    0x6f, 0x1b, 0x46, 0x82, 0x4e, 0x3d, 0x72, 0x2e, 0x3f, 0xc1, 0xec, 0x47, 0xe5, 0x84, 0x07, 0x6d,
+    0x73, 0x33, 0xca, 0xac, 0x7a, 0x9e, 0xa4, 0x2a, 0xa5, 0x6f, 0x8b, 0xb5, 0x17, 0xb7, 0xb5, 0x1d,
+    0x66, 0x29, 0x4f, 0x73, 0xfe, 0x56, 0x75, 0x32, 0x91, 0x7d, 0x81, 0x7e, 0x81, 0x0a, 0x1a, 0x63,
+    0x1e, 0x81, 0x4f, 0x81, 0xc9, 0x9b, 0x4b, 0xb6, 0xd4, 0xc1, 0x9d, 0x32, 0x0b, 0x14, 0x62, 0x34,
+    0x2a, 0xea, 0x42, 0xd1, 0x9a, 0x98, 0x54, 0xa0, 0x88, 0x73, 0x9e, 0xc3, 0x9e, 0xd1, 0xd0, 0xc0,
+    0x97, 0xa4, 0x10, 0x61, 0xc0, 0x5a, 0xeb, 0x1a, 0xdc, 0x5e, 0xcc, 0x38, 0xf8, 0x65, 0xec, 0x34,
+    0x60, 0x03, 0x59, 0xf7, 0xa9, 0xee, 0xbd, 0x62, 0xc2, 0x8b, 0x44, 0x05, 0x46, 0x40, 0xff, 0xe9,
+    0x62, 0x11, 0x06, 0xb7, 0xee, 0x1c, 0x65, 0x4f, 0x7c, 0x88, 0x48, 0xf5, 0x05, 0xb8, 0xcf, 0x3a,
+    0x46, 0x28, 0xc6, 0x40, 0x76, 0x1a, 0xb1, 0x37, 0xc6, 0x46, 0xf8, 0xd3, 0xfe, 0xe6, 0x60, 0x30,
+    0x18, 0x9c, 0x9f, 0xb7, 0x3b, 0x38, 0xa2, 0x74, 0x8c, 0x35, 0x8d, 0x77, 0x1f, 0x0d, 0x06, 0x07,
+    0xdb, 0x59, 0x63, 0xf2, 0x9d, 0x35, 0xcd, 0x07, 0x0a, 0xec, 0xb5, 0x4d, 0xcf, 0xcf, 0xd3, 0xa6,
+    0xe8, 0x81, 0xd7, 0x34, 0x1d, 0x0c, 0x64, 0x53, 0x72, 0xd2, 0x35, 0x6d, 0x11, 0x68, 0xda, 0x56,
+    0xfa, 0xf1, 0xda, 0xc6, 0xc8, 0x0c, 0xd9, 0x58, 0xba, 0xfa, 0xda, 0xc6, 0x83, 0xac, 0x31, 0x44,
+    0x03, 0xb5, 0x1c, 0xc6, 0x7f, 0x6d, 0x92, 0x29, 0x04, 0x0c, 0xcc, 0xba, 0x0a, 0xc5, 0x9d, 0x6d,
+    0xec, 0xf0, 0xf6, 0x68, 0x63, 0xf5, 0x94, 0x42, 0x06, 0x0b, 0x65, 0x50, 0xb0, 0x4d, 0xac, 0x8b,
+    0x52, 0xc9, 0xa3, 0x84, 0xb9, 0xc2, 0xd4, 0xc8, 0xe2, 0xf2, 0xc6, 0xc6, 0x86, 0xba, 0x95, 0xcc,
+    0x8d, 0x4c, 0xcd, 0xdb, 0x55, 0xcd, 0xb1, 0x44, 0x7b, 0x26, 0x57, 0x4e, 0xd9, 0xa8, 0xd2, 0xc4,
+    0x1b, 0x49, 0x97, 0x00, 0x36, 0xb2, 0x5b, 0x35, 0xbc, 0x21, 0x2f, 0x50, 0xcb, 0x16, 0x6a, 0xf1,
+    0xfc, 0xc3, 0x78, 0x93, 0xf7, 0x2d, 0x32, 0x48, 0x59, 0x91, 0x69, 0xd7, 0xf6, 0xaa, 0xe1, 0x53,
+    0xe6, 0xbf, 0x6a, 0x01, 0x6c, 0xc4, 0xa7, 0x52, 0x3f, 0xb9, 0xdc, 0x81, 0xae, 0x53, 0xb5, 0xf3,
+    0x7b, 0x76, 0x73, 0x4e, 0x6b, 0x81, 0x0a, 0x5f, 0x2c, 0x04, 0x28, 0xf8, 0xcc, 0xf5, 0x1c, 0x04,
+    0x69, 0x60, 0x59, 0x4d, 0x07, 0xe2, 0xd7, 0x66, 0x5d, 0x72, 0x8a, 0xb4, 0x7e, 0xab, 0xea, 0x20,
+    0x04, 0x94, 0xe3, 0x17, 0x19, 0x6b, 0x62, 0x8d, 0x89, 0x51, 0x09, 0xb0, 0xb8, 0x78, 0x50, 0x15,
+    0x34, 0x1a, 0xaa, 0x75, 0x6d, 0x5b, 0x93, 0x61, 0x09, 0xfb, 0x82, 0x50, 0x29, 0x5c, 0x7f, 0x53,
+    0xe3, 0xe6, 0xde, 0x22, 0xeb, 0x99, 0xd5, 0x86, 0x3f, 0xf5, 0x90, 0xd4, 0x69, 0xb4, 0x0e, 0x9e,
+    0x3f, 0xb7, 0x35, 0x59, 0x56, 0x92, 0x98, 0x17, 0xf8, 0x4a, 0x94, 0xb5, 0x6f, 0xdb, 0x14, 0xff,
+    0x28, 0x63, 0x61, 0xeb, 0x86, 0x80, 0xf5, 0x82, 0x5c, 0x09, 0x7c, 0x01, 0xb0, 0x9e, 0x6c, 0x20,
+    0x15, 0xf3, 0xa8, 0x29, 0x11, 0xc5, 0x9a, 0x4b, 0x99, 0x10, 0xb5, 0xcc, 0x82, 0x34, 0x15, 0x03,
+    0xc7, 0xbc, 0x37, 0x7b, 0xc8, 0xda, 0x2f, 0xfd, 0x36, 0x83, 0x56, 0x2f, 0xa7, 0xd3, 0xb6, 0x31,
+    0x6c, 0xe7, 0x42, 0xc7, 0x1d, 0x37, 0x16, 0x5c, 0x8a, 0xa4, 0xc2, 0xd2, 0x10, 0x63, 0x59, 0xbc,
+    0x29, 0x63, 0xaa, 0x55, 0x6b, 0x00, 0xd9, 0x92, 0x56, 0x58, 0x80, 0xc1, 0x83, 0x07, 0x80, 0x47,
+    0x4f, 0xf8, 0x7c, 0xec, 0x41, 0xb4, 0x45, 0x58, 0x4b, 0x1d, 0x82, 0xa7, 0x6e, 0x2c, 0x24, 0x23,
+    0x23, 0xa4, 0xb4, 0xf8, 0x00, 0x42, 0xae, 0x21, 0x36, 0x67, 0x49, 0xb9, 0xc5, 0x26, 0x5a, 0xd3,
+    0xbb, 0xc8, 0x6e, 0xdb, 0xb5, 0xb4, 0x63, 0xdd, 0x46, 0xa7, 0x1e, 0x9f, 0x35, 0x24, 0x3a, 0x2d,
+    0xfb, 0x18, 0x04, 0xa4, 0x94, 0x7b, 0x48, 0x40, 0x34, 0x12, 0x50, 0x89, 0x7f, 0x7b, 0xbe, 0x10,
+    0x8e, 0x24, 0x93, 0x59, 0xf2, 0x5a, 0xe2, 0xad, 0x22, 0xb9, 0x32, 0xe6, 0x9b, 0x7d, 0xcc, 0xd0,
+    0x19, 0xf7, 0x1d, 0x4a, 0x33, 0xc5, 0x35, 0x0e, 0x17, 0xc5, 0x60, 0xea, 0xe7, 0x90, 0xae, 0xc3,
+    0x84, 0xa2, 0xc7, 0xca, 0xcc, 0xa2, 0xa6, 0x34, 0x67, 0x31, 0x43, 0xa5, 0xb2, 0x48, 0x39, 0x2d,
+    0xbd, 0x71, 0xe3, 0x19, 0xe6, 0xe2, 0x16, 0x02, 0xd7, 0xc3, 0x54, 0x47, 0x9b, 0xab, 0x32, 0xb7,
+    0x33, 0xa5, 0xfa, 0x47, 0xe5, 0x7e, 0x72, 0xe4, 0x51, 0x39, 0xe1, 0x2f, 0xb6, 0x0d, 0x05, 0x30,
+    0xcb, 0xa7, 0x2e, 0x2a, 0x03, 0xca, 0x98, 0x4e, 0x45, 0x3c, 0x91, 0xa8, 0xea, 0x68, 0xd2, 0x1b,
+    0xab, 0x4d, 0x14, 0xb6, 0xcb, 0x01, 0x4e, 0x0f, 0xf8, 0xe2, 0x5b, 0xa0, 0x11, 0x0b, 0x90, 0x3b,
+    0x28, 0xfc, 0x09, 0x4b, 0xaf, 0x7b, 0x7f, 0x44, 0x58, 0x26, 0xad, 0xea, 0x42, 0x85, 0x24, 0x68,
+    0x6e, 0x8e, 0x94, 0x8b, 0xa5, 0x23, 0x6c, 0x6b, 0x0e, 0xa2, 0x32, 0x0e, 0xab, 0x9a, 0x66, 0x9b,
+    0xdb, 0x16, 0x8a, 0x04, 0x86, 0xc0, 0xca, 0x80, 0xe9, 0x84, 0x23, 0xf1, 0x22, 0x0c, 0x31, 0x2a,
+    0xab, 0xc2, 0xb5, 0xda, 0x29, 0x50, 0xf5, 0xad, 0xac, 0xc3, 0x4f, 0x10, 0x9e, 0xb4, 0x2f, 0x04,
+    0xda, 0x84, 0x8b, 0x51, 0x5c, 0x5a, 0x5d, 0x84, 0x44, 0x03, 0x19, 0x94, 0x77, 0x47, 0xda, 0xe9,
+    0x01, 0x75, 0x94, 0x20, 0x2c, 0xfd, 0x38, 0xea, 0x30, 0x1e, 0xd1, 0x53, 0x48, 0x4a, 0xdf, 0xc1,
+    0x94, 0xa0, 0x0a, 0x96, 0x0a, 0xc8, 0x11, 0x58, 0xfc, 0x1b, 0xc3, 0x2b, 0xd7, 0x4f, 0xcb, 0x7a,
+    0x9e, 0x1b, 0xc7, 0x9e, 0xe8, 0x82, 0x0f, 0x75, 0xb9, 0xdf, 0x61, 0x91, 0x10, 0xc9, 0xd2, 0x19,
+    0xf7, 0xce, 0xb1, 0x7f, 0x6f, 0x66, 0x57, 0xa8, 0x0e, 0xbd, 0xae, 0xd4, 0x1d, 0x1a, 0xbc, 0x37,
+    0x76, 0xfd, 0xcd, 0x14, 0x88, 0x87, 0x21, 0xbf, 0x7b, 0xb4, 0x9c, 0x4e, 0x45, 0x58, 0xad, 0x47,
+    0x63, 0x7a, 0x5f, 0xa3, 0x49, 0x32, 0x94, 0x73, 0x05, 0x66, 0x70, 0x3e, 0xfc, 0x46, 0x0d, 0xf9,
+    0x15, 0x6e, 0x93, 0x9e, 0x15, 0xca, 0x82, 0x99, 0xa7, 0x6c, 0xd0, 0x1b, 0xdf, 0xc5, 0xe2, 0xb9,
+    0x0c, 0xa2, 0x8f, 0x0b, 0x13, 0x2e, 0xab, 0x0a, 0xf6, 0xb0, 0x0e, 0xc8, 0xfe, 0xfd, 0xef, 0xca,
+    0x7c, 0x01, 0x87, 0x47, 0xf5, 0xf8, 0x05, 0xbc, 0xd7, 0x81, 0x35, 0xb0, 0xd9, 0xfd, 0xd1, 0xa8,
+    0x02, 0x54, 0x52, 0x5e, 0xac, 0x4a, 0x6a, 0x33, 0xb6, 0xca, 0x12, 0xf1, 0x11, 0x8a, 0xf2, 0x39,
+    0xbf, 0x0b, 0x96, 0xb2, 0xdc, 0x7a, 0x05, 0xf2, 0x84, 0x3c, 0x02, 0x18, 0x22, 0x65, 0x5f, 0x93,
+    0xed, 0x48, 0xdb, 0x60, 0xa6, 0x7e, 0x55, 0xc3, 0xca, 0xa9, 0xc7, 0xaf, 0xd0, 0xf4, 0x14, 0x69,
+    0x1a, 0x56, 0xf0, 0x51, 0x89, 0xa4, 0x29, 0x69, 0xad, 0x48, 0x86, 0x4c, 0xe5, 0x9f, 0x1f, 0x2a,
+    0x0b, 0x3c, 0xc5, 0x7a, 0x66, 0x6f, 0xb1, 0x8c, 0x66, 0x96, 0x8a, 0xce, 0x70, 0xdf, 0x1a, 0xee,
+    0xc3, 0xec, 0xda, 0x66, 0xdf, 0x31, 0xb7, 0xc3, 0xe2, 0x70, 0x29, 0x6c, 0x7b, 0x13, 0x4a, 0x0d,
+    0xe1, 0x36, 0x52, 0x4c, 0x17, 0x47, 0xeb, 0x7b, 0x44, 0xe2, 0xff, 0x96, 0xc2, 0x9f, 0x08, 0x8d,
+    0x4b, 0x3b, 0xdb, 0xd6, 0x6e, 0x82, 0x4d, 0x03, 0x20, 0x72, 0xd9, 0x2e, 0xa9, 0xcd, 0x49, 0xa6,
+    0x3f, 0x60, 0x83, 0xdb, 0xc1, 0xae, 0xd4, 0x9e, 0x41, 0x03, 0x10, 0x4a, 0xbc, 0x52, 0x84, 0x71,
+    0x50, 0x0b, 0xc3, 0x01, 0xc7, 0x03, 0x31, 0x70, 0x31, 0x74, 0x91, 0x0b, 0x21, 0x4e, 0x9d, 0x94,
+    0x49, 0x89, 0x75, 0xaf, 0x4f, 0x0f, 0xab, 0xe7, 0x18, 0xbd, 0xae, 0x55, 0x76, 0xb2, 0x1d, 0x18,
+    0x4e, 0x5e, 0x4e, 0x02, 0x07, 0xc1, 0xbf, 0x29, 0x6a, 0xde, 0xb6, 0xdd, 0xd1, 0x74, 0x71, 0xc7,
+    0xae, 0xd0, 0xb2, 0x1c, 0x1e, 0x8f, 0x62, 0xb1, 0xd0, 0xc4, 0x83, 0x5a, 0xb3, 0x5d, 0x2b, 0x1f,
+    0xa5, 0x3f, 0x85, 0x9e, 0xa5, 0x49, 0xb0, 0xbb, 0xb6, 0xa3, 0x1a, 0xbe, 0x92, 0x58, 0xa8, 0x20,
+    0x3c, 0xf5, 0x82, 0x20, 0xb4, 0x2c, 0x15, 0x36, 0xd6, 0x4b, 0xb1, 0xc0, 0xa8, 0xe2, 0x9b, 0x3c,
+    0xdb, 0xfe, 0xfe, 0x80, 0xf5, 0xb1, 0xc6, 0xbe, 0x76, 0xb4, 0x08, 0x1c, 0x10, 0x0c, 0x06, 0x46,
+    0xa1, 0x28, 0xff, 0x61, 0xad, 0xfc, 0xf3, 0xfe, 0x13, 0x88, 0x7d, 0x42, 0x9d, 0xe5, 0xc0, 0xa7,
+    0x9d, 0x54, 0x8f, 0x3b, 0x3a, 0x07, 0x77, 0xf6, 0x93, 0x37, 0x6f, 0x37, 0x99, 0x6f, 0xa8, 0x09,
+    0xa5, 0x58, 0xb1, 0x4e, 0x2b, 0x4a, 0x8d, 0x41, 0xd7, 0xc3, 0x90, 0xb2, 0x1b, 0x8d, 0xd4, 0xed,
+    0x5a, 0x52, 0x57, 0x1f, 0x12, 0x29, 0x7c, 0x90, 0xd3, 0x6f, 0x7f, 0x39, 0x11, 0x07, 0x7a, 0xd1,
+    0xc2, 0x82, 0x56, 0x31, 0x16, 0x90, 0x9e, 0xa9, 0x22, 0x14, 0xc0, 0x7e, 0x9f, 0x32, 0x8c, 0xa4,
+    0xb0, 0xbd, 0x92, 0x51, 0xda, 0x2a, 0x5b, 0x31, 0x1e, 0x3f, 0xfa, 0x5b, 0xf6, 0x26, 0xd9, 0xaf,
+    0x5b, 0x8d, 0xc3, 0x15, 0x72, 0xc6, 0xd9, 0x3c, 0xdf, 0x27, 0x52, 0xd6, 0x83, 0xd2, 0xe6, 0x12,
+    0x3d, 0xf7, 0xd9, 0x94, 0x88, 0xd7, 0xfc, 0x1d, 0x7a, 0x42, 0x65, 0xd0, 0x5e, 0xaf, 0xa7, 0xb1,
+    0x35, 0xcf, 0x54, 0xa8, 0xd1, 0x9f, 0xa7, 0x65, 0xc0, 0xa0, 0xd7, 0xb8, 0x36, 0x99, 0xa4, 0xa6,
+    0xe1, 0x12, 0xf2, 0x67, 0x08, 0xaa, 0x69, 0x79, 0x3c, 0x2b, 0xed, 0x1e, 0x41, 0xf6, 0xe8, 0xc6,
+    0x14, 0xe8, 0x70, 0x9c, 0x41, 0x10, 0xa2, 0xa5, 0x61, 0x82, 0x39, 0xb3, 0x81, 0xd6, 0xe7, 0x41,
+    0xa8, 0x72, 0xd1, 0x51, 0x63, 0x8b, 0x2f, 0x22, 0x83, 0x59, 0x04, 0x9e, 0x07, 0xf1, 0x6a, 0xec,
+    0x7a, 0xc0, 0x94, 0x94, 0x7f, 0x92, 0x39, 0x31, 0x44, 0xb3, 0xac, 0xbd, 0x08, 0xc5, 0xb5, 0x0b,
+    0xf1, 0x4b, 0x9b, 0xb9, 0x11, 0x5b, 0x2c, 0xc7, 0x9e, 0x1b, 0xcd, 0x94, 0xba, 0x7c, 0x9e, 0x69,
+    0x97, 0xb9, 0x95, 0x76, 0xfd, 0x6b, 0x58, 0x22, 0x5c, 0xfa, 0x59, 0xc6, 0x41, 0x37, 0xad, 0xfe,
+    0xb0, 0x39, 0xbf, 0xc3, 0x10, 0x1c, 0x27, 0x13, 0x2a, 0x8a, 0x0c, 0x93, 0xa4, 0x8e, 0x48, 0x86,
+    0xc0, 0x45, 0x24, 0x30, 0x1f, 0x8b, 0x2a, 0x5d, 0xa6, 0x53, 0x0c, 0x36, 0xc1, 0xcd, 0xa5, 0x44,
+    0x43, 0x32, 0x92, 0xbc, 0xce, 0xc3, 0xc8, 0x07, 0x0f, 0xd8, 0x7d, 0xa7, 0x18, 0x16, 0xda, 0xb5,
+    0x3e, 0x56, 0xc4, 0xb8, 0xa5, 0x0e, 0x52, 0x0b, 0x0b, 0x26, 0x30, 0x50, 0x56, 0xc7, 0xe4, 0x0e,
+    0x6e, 0xe0, 0xac, 0x89, 0x47, 0x36, 0xcf, 0x36, 0xfe, 0x22, 0xb6, 0x5b, 0xa1, 0x16, 0xc2, 0xdc,
+    0xf9, 0x02, 0x43, 0xe3, 0xfb, 0x15, 0xcb, 0x86, 0x25, 0x8e, 0x55, 0x33, 0xf7, 0x53, 0xf8, 0x10,
+    0xe2, 0x1d, 0x31, 0x7e, 0x60, 0x7f, 0x49, 0x1e, 0x46, 0x26, 0xb2, 0xd9, 0x9e, 0x11, 0xd3, 0xba,
+    0x68, 0x36, 0xf1, 0xcb, 0xbb, 0x0b, 0x2b, 0xa6, 0xbb, 0x6c, 0x78, 0xa9, 0xd6, 0xe7, 0x3f, 0x47,
+    0x14, 0xa2, 0x15, 0xe1, 0x71, 0x61, 0xa9, 0xfc, 0xf4, 0x0b, 0xab, 0x5f, 0xad, 0x93, 0xb7, 0xdc,
+    0x5c, 0x49, 0x7b, 0x8b, 0xca, 0x02, 0x56, 0x77, 0x76, 0x56, 0x88, 0x56, 0x36, 0xb9, 0xc4, 0xfe,
+    0x9f, 0x49, 0xa8, 0x38, 0x74, 0x2a, 0xca, 0xf2, 0xca, 0xc7, 0xd7, 0x22, 0x40, 0x25, 0xb7, 0x65,
+    0x98, 0xc3, 0x56, 0x09, 0xb3, 0xb0, 0x8d, 0xb6, 0x5e, 0xa6, 0x0a, 0xc8, 0xcf, 0x24, 0xda, 0xd2,
+    0x7a, 0x53, 0x22, 0x66, 0xfd, 0xf9, 0x57, 0x26, 0x72, 0x18, 0x27, 0x8c, 0x19, 0xa0, 0x18, 0xc5,
+    0xc1, 0x82, 0x29, 0x85, 0xa6, 0x24, 0x8a, 0x33, 0xe4, 0x04, 0xa5, 0x5d, 0xcd, 0x55, 0x96, 0x3a,
+    0x6b, 0xf2, 0x50, 0xae, 0x5b, 0x8d, 0xd6, 0xac, 0xc4, 0x0d, 0xd8, 0x21, 0x1b, 0xda, 0x9f, 0x47,
+    0x3d, 0x0a, 0x25, 0x36, 0x2d, 0xba, 0x6a, 0x50, 0xa1, 0x5b, 0x88, 0xd0, 0x0d, 0x9c, 0xb4, 0xab,
+    0xbc, 0xfb, 0x4a, 0x56, 0x2f, 0x68, 0x65, 0x8a, 0x17, 0x62, 0x62, 0x78, 0x01, 0xa8, 0x06, 0xd3,
+    0x69, 0x95, 0xf6, 0x14, 0xb7, 0xac, 0x1b, 0x37, 0x7a, 0xa6, 0x4b, 0x9d, 0x75, 0x4b, 0xaf, 0x18,
+    0x0a, 0x57, 0xbf, 0x4d, 0x57, 0x4b, 0xcd, 0xd9, 0x65, 0xa1, 0x69, 0x41, 0x41, 0xf3, 0x45, 0xd6,
+    0xcf, 0xa9, 0x90, 0x45, 0x42, 0x6b, 0xb9, 0x00, 0x39, 0xc2, 0xfb, 0xd5, 0xd1, 0x86, 0x20, 0x7b,
+    0x39, 0x83, 0x9d, 0x35, 0x6b, 0xda, 0x5f, 0xae, 0xea, 0x52, 0x09, 0xc4, 0x67, 0x78, 0xaa, 0x61,
+    0x1c, 0xe2, 0x02, 0x5b, 0x7c, 0x24, 0xb3, 0xb8, 0x25, 0xee, 0x69, 0x94, 0xcc, 0x5b, 0xce, 0x19,
+    0x0f, 0x43, 0xf7, 0x5a, 0x44, 0xc9, 0x8a, 0x0c, 0xb1, 0x6b, 0xe6, 0x84, 0xe6, 0x72, 0x09, 0x1d,
+    0x94, 0xf8, 0x44, 0x65, 0x12, 0x05, 0xaf, 0xea, 0x32, 0x09, 0x60, 0xd2, 0xc8, 0xa5, 0xbe, 0xaf,
+    0x4c, 0x3f, 0xef, 0x67, 0xda, 0x1b, 0xd4, 0x16, 0x6b, 0xe3, 0x59, 0x18, 0xdc, 0x50, 0xd5, 0x90,
+    0x04, 0x80, 0xbb, 0x65, 0xfc, 0x08, 0x77, 0x80, 0x2e, 0xa3, 0xbb, 0xf6, 0x46, 0xeb, 0x32, 0xc9,
+    0x7a, 0xb6, 0x36, 0x6b, 0x9a, 0xa9, 0x54, 0x83, 0x89, 0xf4, 0x55, 0xd4, 0x5c, 0x92, 0x95, 0x1c,
+    0x36, 0xdc, 0x97, 0x45, 0x87, 0x08, 0xcd, 0x2e, 0x2a, 0xaf, 0xfc, 0x80, 0x09, 0x6d, 0x6c, 0x88,
+    0x66, 0x20, 0x30, 0x7c, 0x36, 0x17, 0xdc, 0x37, 0xeb, 0x6b, 0x76, 0x48, 0xe6, 0x63, 0x75, 0x56,
+    0x02, 0x02, 0xb5, 0xad, 0x56, 0xd5, 0x04, 0xe5, 0x87, 0x12, 0xdf, 0xd1, 0x70, 0xff, 0x6f, 0xc5,
+    0x35, 0x2a, 0x6e, 0x2a, 0x93, 0x2f, 0xba, 0x50, 0x88, 0x6a, 0x99, 0xea, 0x30, 0x45, 0xa1, 0x60,
+    0x71, 0xf9, 0x34, 0x06, 0x03, 0x5b, 0xac, 0x16, 0xa6, 0xc5, 0x9a, 0xca, 0x62, 0x61, 0xca, 0xad,
+    0xbf, 0x56, 0xa1, 0x30, 0xd9, 0x3b, 0x96, 0x10, 0x98, 0x3a, 0x59, 0x79, 0x5b, 0xbd, 0x8c, 0x7a,
+    0x3f, 0xed, 0x00, 0x3e, 0x3d, 0xbd, 0xee, 0x39, 0x81, 0x4f, 0x0f, 0xd2, 0xfb, 0xa9, 0x1b, 0x42,
+    0x4a, 0x95, 0xd5, 0x0b, 0x8f, 0xf3, 0x72, 0xa1, 0xfd, 0x29, 0x2b, 0x55, 0xea, 0x84, 0x36, 0xee,
+    0x4b, 0x2b, 0xee, 0x51, 0x4b, 0x10, 0x7f, 0x98, 0xa3, 0x29, 0xad, 0xd2, 0x16, 0x6b, 0xf7, 0x69,
+    0xa3, 0x5a, 0xf2, 0x18, 0x44, 0x0d, 0x18, 0xe8, 0xbb, 0xb9, 0x9a, 0x16, 0x2d, 0x4b, 0xc2, 0xfe,
+    0x4b, 0x14, 0x2c, 0xcd, 0xfb, 0x0c, 0x52, 0x8a, 0xd1, 0xf8, 0xf6, 0xe6, 0x7c, 0x61, 0x5d, 0x23,
+    0x21, 0xb4, 0x50, 0x4c, 0x4b, 0x09, 0xd6, 0xb5, 0xdd, 0x04, 0x5e, 0xba, 0x64, 0x0f, 0x10, 0x71,
+    0x45, 0xf6, 0xcf, 0x2b, 0x99, 0xa6, 0x87, 0x26, 0x83, 0x29, 0x53, 0x05, 0x98, 0xcb, 0x35, 0x71,
+    0x3c, 0x5f, 0xc4, 0x92, 0x68, 0xba, 0x6a, 0xc1, 0xe5, 0x9e, 0xc7, 0x50, 0x4c, 0x45, 0x48, 0xd3,
+    0x0b, 0x57, 0x7a, 0xe8, 0xc8, 0xda, 0x32, 0x0c, 0x69, 0x37, 0xa1, 0x88, 0x21, 0x2f, 0xbc, 0x8a,
+    0x0c, 0x35, 0x4c, 0xf5, 0x44, 0xab, 0x46, 0x1f, 0x4d, 0x6e, 0xb0, 0x09, 0x30, 0x77, 0xe7, 0x56,
+    0xfb, 0x8c, 0x3e, 0xf2, 0x81, 0x50, 0xa5, 0x27, 0xea, 0xe0, 0xb5, 0x8f, 0xd3, 0x38, 0x8a, 0xd8,
+    0xcb, 0x7f, 0xaa, 0xf8, 0x90, 0x47, 0x2f, 0x60, 0xd4, 0x6b, 0x1b, 0xcb, 0xfd, 0x26, 0x45, 0x5f,
+    0x7d, 0x9c, 0x4b, 0x97, 0x9b, 0x34, 0x31, 0x12, 0xd5, 0x30, 0xa8, 0xf4, 0xf0, 0xd8, 0xee, 0x6f,
+    0xa7, 0xfe, 0x15, 0x46, 0xa3, 0xe9, 0x89, 0x67, 0xf2, 0x73, 0xa4, 0xbf, 0x9e, 0x0b, 0x43, 0xb4,
+    0xa3, 0x24, 0x1c, 0x2d, 0xcf, 0x96, 0xe2, 0x19, 0x69, 0x8d, 0x1e, 0x3c, 0x3d, 0x24, 0x7c, 0xdc,
+    0xc5, 0x2c, 0xa8, 0xb6, 0x30, 0xe7, 0xb1, 0x3b, 0x61, 0x53, 0xd7, 0x13, 0xb8, 0x3b, 0x96, 0x6c,
+    0x32, 0x95, 0x26, 0x81, 0xac, 0xf9, 0xa2, 0xa3, 0xac, 0x2c, 0x74, 0xa8, 0xfc, 0xdc, 0xa1, 0xe8,
+    0xb7, 0xb2, 0x8e, 0x99, 0xfb, 0x67, 0x3f, 0x50, 0xb6, 0x13, 0x0a, 0xcb, 0xb8, 0x07, 0x3a, 0x1b,
+    0x07, 0x5b, 0x06, 0xb4, 0x49, 0xe6, 0x7c, 0xe9, 0x79, 0xbf, 0x0b, 0x8e, 0x99, 0x9e, 0x61, 0x17,
+    0xbf, 0xe6, 0x19, 0xdb, 0x03, 0x2a, 0x2b, 0x24, 0x5d, 0x5f, 0x00, 0xef, 0x67, 0xd4, 0x6f, 0x68,
+    0xdb, 0xbd, 0xc8, 0x03, 0xde, 0x58, 0xdd, 0xed, 0xe6, 0x70, 0x12, 0x30, 0x12, 0xdd, 0x22, 0x80,
+    0xf6, 0xe5, 0x3a, 0x2f, 0xad, 0x43, 0x79, 0x1a, 0x2c, 0xc3, 0xc8, 0xfa, 0x18, 0x3c, 0x5e, 0xb8,
+    0xfe, 0x32, 0x16, 0x1f, 0x07, 0xe3, 0x42, 0x00, 0xa3, 0x9d, 0x22, 0x8c, 0xb5, 0x67, 0x71, 0x95,
+    0x23, 0x51, 0xa3, 0x0f, 0x3b, 0x37, 0x61, 0x92, 0x75, 0xb2, 0x00, 0xb0, 0xe6, 0x08, 0x84, 0x6c,
+    0xab, 0xa8, 0xd7, 0x6b, 0xb7, 0xbc, 0x61, 0xae, 0xbe, 0xb0, 0x6c, 0x80, 0x97, 0x69, 0xf7, 0x88,
+    0xfd, 0xeb, 0xdb, 0xf7, 0x99, 0xd6, 0xad, 0x2e, 0xbf, 0x7d, 0x9f, 0x93, 0xb4, 0xf2, 0xe7, 0x97,
+    0x3f, 0x7e, 0xfb, 0x1e, 0x71, 0x5a, 0x5d, 0x3e, 0xfb, 0xf6, 0xbd, 0x86, 0xc4, 0x6a, 0x1e, 0xf5,
+    0xe2, 0xdb, 0xf8, 0x5f, 0x47, 0xb5, 0x87, 0x63, 0x92, 0x93, 0x53, 0x68, 0x0a, 0xd2, 0xaf, 0x5f,
+    0x66, 0x6e, 0x0e, 0xb1, 0x28, 0xb4, 0xa7, 0x2f, 0x00, 0x64, 0x06, 0xa3, 0x65, 0xf8, 0x14, 0x0f,
+    0x6d, 0xc5, 0xfd, 0x5f, 0xbf, 0x55, 0x62, 0x12, 0xf5, 0xd9, 0x82, 0x4e, 0xdd, 0x8a, 0x9f, 0xda,
+    0x4e, 0xa8, 0xe2, 0x87, 0xac, 0x95, 0xe8, 0x49, 0x1c, 0x3c, 0x0f, 0xf0, 0x1b, 0x9c, 0x17, 0x31,
+    0x3a, 0x24, 0x9a, 0x40, 0xad, 0xda, 0xee, 0xf4, 0xbd, 0x1b, 0x76, 0xdb, 0x32, 0x9d, 0x68, 0x59,
+    0xdb, 0xb9, 0xf4, 0x3d, 0x1a, 0x56, 0x82, 0x63, 0x38, 0xc0, 0xd2, 0x9a, 0x47, 0xb5, 0x50, 0xd3,
+    0xcf, 0x06, 0x29, 0x1f, 0x4c, 0x91, 0x80, 0x3f, 0xc1, 0x91, 0xa2, 0x16, 0xb3, 0x5a, 0x9f, 0xf2,
+    0x48, 0x51, 0xcb, 0x9f, 0xdb, 0x44, 0x8c, 0xae, 0x3c, 0x17, 0x49, 0xfc, 0x43, 0xda, 0x92, 0xc4,
+    0xba, 0x37, 0xf8, 0xb1, 0x1b, 0x3e, 0x89, 0x97, 0xdc, 0xf3, 0xee, 0xd2, 0xd0, 0xc5, 0x21, 0x33,
+    0x7d, 0xef, 0xc3, 0xf7, 0x97, 0xd6, 0xee, 0x2b, 0x55, 0xf9, 0x4a, 0xbb, 0xd6, 0x0d, 0x22, 0xca,
+    0x52, 0x24, 0x93, 0xb8, 0x75, 0x20, 0xa7, 0xaf, 0x9f, 0xbd, 0x78, 0x22, 0x81, 0x14, 0xf7, 0x6f,
+    0xb6, 0x3a, 0xec, 0xf4, 0xe2, 0xf5, 0x93, 0x9f, 0x0b, 0xef, 0xe4, 0x3e, 0x4e, 0xa3, 0x99, 0x4b,
+    0x24, 0x61, 0x19, 0x37, 0x8a, 0xd2, 0x7e, 0xcf, 0x01, 0xb8, 0xe1, 0xe0, 0xdc, 0xbd, 0x15, 0x8e,
+    0x45, 0xd6, 0x12, 0xf4, 0xc6, 0x5e, 0x8b, 0x1f, 0xea, 0x33, 0xc3, 0xad, 0xb3, 0x2a, 0x1e, 0xd9,
+    0x7e, 0xda, 0xde, 0x1f, 0x81, 0xeb, 0x5b, 0xad, 0x7e, 0xcb, 0x6e, 0x44, 0xec, 0x45, 0xba, 0xa1,
+    0x54, 0x02, 0xb3, 0xf4, 0x6d, 0xa6, 0x0f, 0x59, 0xeb, 0x4e, 0x44, 0x2d, 0xc8, 0xd2, 0x5a, 0x7e,
+    0xd0, 0x10, 0x26, 0xc6, 0xbd, 0x2c, 0xdb, 0xbe, 0x99, 0x00, 0x2e, 0x6d, 0xf0, 0x2c, 0xd5, 0xec,
+    0xb5, 0x5d, 0x9f, 0x1f, 0x32, 0xf2, 0x19, 0x6e, 0x6f, 0x55, 0xd9, 0x42, 0xfb, 0x5d, 0x8b, 0x2c,
+    0xe9, 0xe0, 0xf1, 0x5e, 0xb5, 0x8d, 0xef, 0x86, 0x6b, 0x98, 0xb6, 0xba, 0x57, 0x97, 0xd0, 0x9b,
+    0x73, 0xb4, 0x87, 0xc6, 0xe7, 0x40, 0x8d, 0x0f, 0x21, 0x43, 0x59, 0xbd, 0x93, 0xf7, 0xeb, 0x14,
+    0x3c, 0xc9, 0xc4, 0x24, 0xfa, 0xa5, 0x3c, 0xac, 0x95, 0xe4, 0x61, 0x8d, 0x08, 0x98, 0x39, 0xa1,
+    0x8e, 0x3c, 0x3c, 0x2a, 0x63, 0x86, 0xed, 0x40, 0x54, 0xf0, 0xa7, 0xb8, 0x33, 0xc9, 0x38, 0xc1,
+    0xd6, 0xe1, 0xff, 0xf4, 0x71, 0xc2, 0x7a, 0x04, 0x97, 0x2e, 0x32, 0x48, 0xd4, 0xb3, 0xbb, 0x0e,
+    0x36, 0x30, 0x4e, 0x28, 0xc4, 0xa5, 0x97, 0x18, 0x15, 0xd3, 0x1c, 0x1a, 0xda, 0x15, 0xb6, 0x77,
+    0x55, 0x69, 0x89, 0x4b, 0x4d, 0x75, 0x2b, 0x77, 0xea, 0xa8, 0xfb, 0x55, 0x18, 0x7e, 0xb5, 0x4e,
+    0x84, 0x91, 0xc9, 0x98, 0xd1, 0x52, 0xc1, 0x88, 0x6d, 0xc4, 0xaf, 0x6a, 0x17, 0x91, 0x7b, 0x06,
+    0x88, 0x18, 0xe7, 0x76, 0x87, 0x3e, 0x6a, 0x41, 0x33, 0x29, 0x2f, 0xb0, 0xb4, 0x3a, 0x17, 0xb1,
+    0x83, 0x71, 0x75, 0xe7, 0xe2, 0xa7, 0x57, 0x34, 0x53, 0x48, 0x81, 0x2d, 0x89, 0x0a, 0xbe, 0x7f,
+    0xc4, 0x23, 0x08, 0x97, 0x93, 0x13, 0x44, 0xbf, 0xd1, 0xa9, 0xdf, 0xbc, 0x5d, 0x33, 0xe2, 0x29,
+    0x8e, 0x5f, 0xf7, 0x49, 0x83, 0x4f, 0xfc, 0xb5, 0x8f, 0x94, 0x0b, 0x35, 0xa7, 0xc9, 0x69, 0x2a,
+    0x97, 0x0c, 0x7d, 0xcd, 0x49, 0xea, 0x35, 0xb3, 0x4c, 0xe7, 0x7f, 0x47, 0x9d, 0x61, 0x51, 0xec,
+    0x00, 0x97, 0xd5, 0x51, 0xb3, 0x37, 0x7e, 0xd8, 0xf0, 0x54, 0x3f, 0x39, 0x31, 0x14, 0x4c, 0xe3,
+    0xd1, 0x51, 0x85, 0xc6, 0x28, 0x40, 0x75, 0x60, 0x7c, 0x78, 0x43, 0x82, 0x6c, 0x38, 0x6e, 0xad,
+    0xb6, 0xaf, 0x9a, 0x84, 0x87, 0x9c, 0x8d, 0xbd, 0x60, 0x9c, 0xe4, 0x5a, 0x54, 0x85, 0x50, 0xb6,
+    0x8a, 0xe7, 0x13, 0x80, 0x1a, 0xc9, 0x1c, 0xea, 0x11, 0x5c, 0x5a, 0x6f, 0x92, 0x91, 0xdf, 0x76,
+    0xd8, 0x7b, 0x16, 0xdf, 0x2d, 0xf0, 0x50, 0x2b, 0x46, 0x9a, 0xfd, 0x85, 0x87, 0x1b, 0x7b, 0x0a,
+    0xf9, 0x64, 0xed, 0xe8, 0x59, 0x4a, 0xe9, 0xb9, 0xfe, 0x3b, 0xc3, 0xc0, 0xcb, 0x10, 0xcf, 0xf3,
+    0xff, 0xf2, 0xea, 0x79, 0x72, 0x94, 0xff, 0xe5, 0xf8, 0x0f, 0x50, 0x09, 0xb8, 0xb7, 0x10, 0x25,
+    0xf3, 0x51, 0xde, 0x9a, 0x0f, 0x00, 0x70, 0xbd, 0x68, 0x00, 0x86, 0x31, 0x14, 0x53, 0xe8, 0x01,
+    0x03, 0xe9, 0x6f, 0x32, 0xdc, 0x46, 0x59, 0xd8, 0xbe, 0x66, 0x4a, 0xd1, 0x91, 0x76, 0x5a, 0x74,
+    0x44, 0x56, 0x26, 0x38, 0x74, 0x18, 0x7d, 0x30, 0x8c, 0xb9, 0xb1, 0xcc, 0x58, 0x43, 0x31, 0x0f,
+    0xae, 0x05, 0xdc, 0x9a, 0xeb, 0x36, 0xf8, 0xd1, 0xcc, 0xc2, 0xe1, 0x78, 0x5e, 0x42, 0x99, 0xe0,
+    0xe9, 0x79, 0x6c, 0x11, 0x80, 0x1c, 0xc4, 0x0c, 0x00, 0xb9, 0x19, 0x8a, 0xeb, 0xe0, 0x9d, 0xc2,
+    0x4d, 0x20, 0xbf, 0x4e, 0x64, 0x1b, 0x97, 0x1c, 0xa8, 0xae, 0x9a, 0x32, 0x10, 0x8b, 0xfe, 0x11,
+    0x95, 0x1f, 0xcc, 0x7c, 0x6c, 0xb0, 0x15, 0xf3, 0x63, 0xb7, 0x60, 0xae, 0x3a, 0xf8, 0xa9, 0xf7,
+    0xc1, 0x46, 0xdb, 0x66, 0xe4, 0x0e, 0x0f, 0x77, 0x42, 0xf1, 0x2e, 0x68, 0x09, 0xf8, 0xaf, 0x19,
+    0x4d, 0x90, 0xc3, 0xd2, 0x61, 0x4d, 0x32, 0xa0, 0x2a, 0x1c, 0x0c, 0x2b, 0x3b, 0xc9, 0x32, 0xb3,
+    0xe7, 0x25, 0x27, 0x96, 0xad, 0xb4, 0xac, 0xd8, 0xa1, 0x8f, 0x86, 0x2c, 0xc3, 0x0e, 0x93, 0xe8,
+    0xdb, 0x78, 0x88, 0x39, 0xbc, 0x03, 0xf6, 0x4c, 0x15, 0xe3, 0x8b, 0x36, 0x37, 0x19, 0x16, 0xd9,
+    0x83, 0x2e, 0xbd, 0x18, 0x60, 0x28, 0x0d, 0xce, 0xd0, 0x0d, 0xb0, 0xc2, 0xd1, 0x99, 0xac, 0x08,
+    0x43, 0x0b, 0x2f, 0xb8, 0x1b, 0xe3, 0x95, 0x6c, 0x6b, 0x2a, 0xc4, 0xbc, 0x52, 0xc8, 0x4b, 0x90,
+    0xd9, 0x06, 0xb9, 0x50, 0xce, 0xde, 0xc1, 0x8d, 0x1e, 0x3c, 0xce, 0xb7, 0x3e, 0xb3, 0x50, 0x7e,
+    0x76, 0x41, 0xdd, 0x4a, 0x34, 0x87, 0xf8, 0xb4, 0x94, 0x52, 0xd2, 0x77, 0x95, 0xc1, 0x6e, 0x03,
+    0x62, 0xb8, 0xf1, 0xb5, 0x1c, 0x80, 0x54, 0x6c, 0xcf, 0x31, 0x99, 0x51, 0x05, 0x56, 0xf6, 0x5d,
+    0x2e, 0xc3, 0xf6, 0x1c, 0xd3, 0x52, 0xc1, 0x4a, 0x3b, 0x67, 0x5d, 0x60, 0xa9, 0xa2, 0x7c, 0x29,
+    0xc7, 0x2c, 0xe3, 0xf8, 0x80, 0xee, 0xd6, 0x56, 0x81, 0xdd, 0xff, 0xc3, 0xf6, 0xc8, 0xfd, 0x0f,
+    0xaa, 0xcc, 0xbe, 0x7a, 0xf8, 0x73, 0xb3, 0xaf, 0x0f, 0xa9, 0x07, 0x75, 0x9b, 0x78, 0x82, 0xb2,
+    0x8c, 0x4b, 0xfa, 0x9f, 0x32, 0xd0, 0xae, 0x3f, 0x5d, 0x8e, 0x7b, 0xc4, 0xea, 0x94, 0x85, 0xc2,
+    0xee, 0x94, 0x63, 0x2a, 0x2f, 0xed, 0xa3, 0x3a, 0x36, 0x17, 0x35, 0xb7, 0xba, 0xc6, 0x08, 0x19,
+    0x82, 0x70, 0xaf, 0xe5, 0x84, 0x22, 0x7f, 0x23, 0x35, 0x2e, 0x39, 0x20, 0x9d, 0x2c, 0x7b, 0xa7,
+    0x87, 0x0b, 0x22, 0x34, 0xaa, 0x2a, 0xa4, 0x29, 0xcc, 0x55, 0x2c, 0x65, 0xe3, 0x51, 0x8e, 0x74,
+    0x29, 0x12, 0xef, 0x6f, 0xc0, 0x10, 0xca, 0x32, 0x7b, 0xf2, 0x9d, 0x00, 0x37, 0x22, 0xeb, 0x54,
+    0x31, 0x59, 0x9e, 0xe0, 0x27, 0x05, 0x22, 0x73, 0x7d, 0xff, 0x06, 0xb2, 0xe7, 0xe0, 0xa6, 0x47,
+    0x4d, 0x2e, 0x60, 0x0e, 0x9b, 0x03, 0xe3, 0x75, 0xf2, 0x68, 0x56, 0xcc, 0x4f, 0x76, 0x49, 0x11,
+    0x36, 0x89, 0xfb, 0x55, 0xc6, 0xb5, 0xda, 0xb3, 0x38, 0x5e, 0x1c, 0xf6, 0x69, 0xe5, 0xcd, 0x0b,
+    0x26, 0x94, 0x7f, 0xf6, 0x66, 0x41, 0x14, 0x53, 0x85, 0x69, 0x8b, 0xb5, 0x0f, 0x0f, 0x86, 0x7d,
+    0xd9, 0x5b, 0xf7, 0x7b, 0xf2, 0x69, 0x8f, 0x3b, 0x0e, 0x01, 0x7c, 0xee, 0x42, 0xae, 0xeb, 0x8b,
+    0xd0, 0x6a, 0x13, 0xbb, 0xdb, 0x9d, 0x8c, 0x21, 0x56, 0x05, 0x79, 0x9a, 0x92, 0x1c, 0xdd, 0x6b,
+    0xba, 0xc2, 0xf6, 0x8f, 0x8b, 0x97, 0x3f, 0xf5, 0x16, 0x3c, 0x8c, 0x84, 0x25, 0x7a, 0xb4, 0xdc,
+    0x66, 0xe8, 0x5c, 0xb3, 0xd2, 0xb5, 0x32, 0x53, 0x12, 0xf8, 0x49, 0xd5, 0x9c, 0xd5, 0xce, 0xe2,
+    0xe4, 0xf8, 0x4f, 0xfa, 0x25, 0x4c, 0x10, 0x41, 0xe8, 0xca, 0x5d, 0x15, 0x2e, 0xb0, 0x18, 0x34,
+    0x82, 0x2d, 0x7d, 0x0f, 0x17, 0x68, 0x14, 0x6d, 0x03, 0x4d, 0xc6, 0xd8, 0xce, 0x68, 0x11, 0x8a,
+    0x5a, 0x3e, 0x92, 0x7a, 0x5e, 0x65, 0x0e, 0x9a, 0x28, 0x45, 0x51, 0x01, 0x56, 0x55, 0x53, 0x26,
+    0xf9, 0x56, 0x25, 0x1e, 0x65, 0xcf, 0x3e, 0xb5, 0x08, 0x5a, 0x2e, 0xfc, 0xec, 0x2c, 0x39, 0x43,
+    0xcf, 0x9b, 0x27, 0x33, 0x89, 0xda, 0x06, 0x59, 0x44, 0x53, 0xc5, 0x25, 0xe5, 0xeb, 0x12, 0x47,
+    0xe6, 0x6f, 0x8c, 0x2e, 0x23, 0x59, 0x02, 0x9a, 0x86, 0xc1, 0x5c, 0x8e, 0x8e, 0xdf, 0x13, 0xbd,
+    0x57, 0x65, 0xf8, 0x64, 0x9d, 0x3f, 0x4e, 0xff, 0x2f, 0x3b, 0xe5, 0x10, 0xb3, 0x30, 0xe5, 0x8e,
+    0x12, 0x11, 0xf9, 0x90, 0x77, 0xe0, 0xd7, 0xc2, 0x14, 0xaf, 0x23, 0xa7, 0xae, 0xfe, 0x31, 0xca,
+    0xe3, 0x7e, 0xfa, 0x61, 0xd4, 0xe3, 0xbe, 0xfc, 0xe0, 0xf8, 0x71, 0x5f, 0xfe, 0x4f, 0x81, 0xfe,
+    0x03, 0xdd, 0xef, 0x2d, 0xb4, 0x2d, 0x68, 0x00, 0x00,
+};
+
+#endif
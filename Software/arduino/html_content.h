@@ -143,6 +143,11 @@ const char index_html[] PROGMEM = R"rawliteral(
         <button class="button" id="wavelength-btn" onclick="changeWavelength()">Change Wavelength</button>
         <button class="button" id="gain-btn" onclick="adjustGain()">Adjust Gain</button>
         <button class="button" id="integration-btn" onclick="adjustIntegration()">Adjust Integration</button>
+        <button class="button" id="continuous-btn" onclick="toggleContinuous()">Continuous: Off</button>
+        <button class="button" id="ae-btn" onclick="toggleAutoExposure()">Auto Exposure: Off</button>
+        <button class="button" id="hdr-btn" onclick="takeHdr()">HDR Capture</button>
+        <button class="button" id="dark-btn" onclick="captureDark()">Capture Dark</button>
+        <button class="button" id="average-btn" onclick="takeAverage()">Average x16</button>
         
         <div class="save-container">
             <button class="button" onclick="downloadData()">Download Data</button>
@@ -152,10 +157,17 @@ const char index_html[] PROGMEM = R"rawliteral(
     </div>
 
     <script>
-        // Initial data
-        let spectralData = {
+        // Channel metadata, replaced by /meta (which the browser caches)
+        let channelMeta = {
             wavelengths: [415, 445, 480, 515, 555, 590, 630, 680, 940],
             names: ["Violet", "Vio-Blue", "Blue", "Cyan", "Green", "Yellow", "Orange", "Red", "NIR"],
+            frame_bin: {version: 1, size: 38}
+        };
+
+        // Initial data
+        let spectralData = {
+            wavelengths: channelMeta.wavelengths,
+            names: channelMeta.names,
             values: [120, 240, 350, 280, 190, 220, 310, 180, 90],
             gain: 8,
             integration_time: 100,
@@ -226,14 +238,82 @@ const char index_html[] PROGMEM = R"rawliteral(
                 spectralData.wavelengths[spectralData.selected_index] + 'nm)';
             document.getElementById('gain-value').textContent = 'x' + spectralData.gain;
             document.getElementById('integration-time').textContent = spectralData.integration_time + 'ms';
+            document.getElementById('continuous-btn').textContent = 'Continuous: ' + (spectralData.continuous ? 'On' : 'Off');
+            const ae = spectralData.auto_exposure;
+            document.getElementById('ae-btn').textContent = 'Auto Exposure: ' +
+                (ae && ae.enabled ? 'On (' + ae.iterations + (ae.iterations == 1 ? ' capture)' : ' captures)') : 'Off');
+            const dark = spectralData.dark;
+            document.getElementById('dark-btn').textContent = 'Capture Dark' + (dark && dark.needed ? ' (needed)' : '');
         }
         
+        // /data and the event stream leave the wavelengths and names to /meta
+        function withMeta(data) {
+            data.wavelengths = channelMeta.wavelengths;
+            data.names = channelMeta.names;
+            return data;
+        }
+
+        function fetchMeta() {
+            fetch('/meta')
+                .then(response => response.json())
+                .then(meta => {
+                    channelMeta = meta;
+                    withMeta(spectralData);
+                    updateChart();
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to fetch only the latest counts, as the packed frame
+        // described in /meta (little-endian, see SpectralFrame.h)
+        function fetchFrame() {
+            fetch('/frame.bin')
+                .then(response => response.arrayBuffer())
+                .then(buffer => {
+                    const view = new DataView(buffer);
+                    if (buffer.byteLength < channelMeta.frame_bin.size ||
+                        view.getUint8(0) !== channelMeta.frame_bin.version) {
+                        fetchData(); // Layout changed under the page
+                        return;
+                    }
+                    const flags = view.getUint8(1);
+                    const values = [];
+                    for (let i = 0; i < 9; i++) {
+                        values.push(view.getUint16(16 + 2 * i, true));
+                    }
+                    spectralData.values = values;
+                    spectralData.sequence = view.getUint32(4, true);
+                    spectralData.measuring = (flags & 0x04) !== 0;
+                    spectralData.continuous = (flags & 0x08) !== 0;
+                    delete spectralData.averaged;
+                    const frame = spectralData.frame;
+                    if (frame) {
+                        frame.gain_code = [view.getUint8(2), view.getUint8(3)];
+                        frame.astep = view.getUint16(12, true);
+                        frame.atime = view.getUint8(14);
+                        frame.integration_us = Math.floor((frame.atime + 1) * (frame.astep + 1) * 278 / 100);
+                        frame.saturated = (flags & 0x01) !== 0;
+                        frame.clear = [view.getUint16(34, true), view.getUint16(36, true)];
+                    }
+                    if (spectralData.dark) {
+                        spectralData.dark.corrected = (flags & 0x02) !== 0;
+                    }
+                    updateChart();
+                    document.getElementById('status').textContent = '';
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
         // Function to fetch new data
         function fetchData() {
             fetch('/data')
                 .then(response => response.json())
                 .then(data => {
-                    spectralData = data;
+                    spectralData = withMeta(data);
                     updateChart();
                     document.getElementById('status').textContent = '';
                 })
@@ -248,7 +328,25 @@ const char index_html[] PROGMEM = R"rawliteral(
             fetch('/measure')
                 .then(response => response.json())
                 .then(data => {
-                    spectralData = data;
+                    // The capture runs in the background; wait for a newer sequence
+                    waitForMeasurement(data.sequence);
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to poll until a capture newer than 'previous' is published
+        function waitForMeasurement(previous) {
+            fetch('/data')
+                .then(response => response.json())
+                .then(data => {
+                    // Auto-exposure may retake the frame; wait until it settles
+                    if (data.sequence === previous || (data.measuring && !data.continuous)) {
+                        setTimeout(() => waitForMeasurement(previous), 200);
+                        return;
+                    }
+                    spectralData = withMeta(data);
                     updateChart();
                     document.getElementById('status').textContent = 'Measurement complete!';
                     setTimeout(() => {
@@ -299,6 +397,115 @@ const char index_html[] PROGMEM = R"rawliteral(
                 });
         }
         
+        // Function to start or stop continuous capture
+        function toggleContinuous() {
+            fetch('/continuous?enable=' + (spectralData.continuous ? 0 : 1))
+                .then(response => response.json())
+                .then(data => {
+                    spectralData.continuous = data.continuous;
+                    spectralData.period = data.period;
+                    updateChart();
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to turn auto-exposure on or off
+        function toggleAutoExposure() {
+            const enabled = spectralData.auto_exposure && spectralData.auto_exposure.enabled;
+            fetch('/auto_exposure?enable=' + (enabled ? 0 : 1))
+                .then(response => response.json())
+                .then(data => {
+                    spectralData.auto_exposure = spectralData.auto_exposure || {};
+                    spectralData.auto_exposure.enabled = data.auto_exposure;
+                    updateChart();
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to take an HDR bracket; the fused spectrum arrives under data.hdr
+        function takeHdr() {
+            document.getElementById('status').textContent = 'Taking HDR bracket...';
+            fetch('/hdr')
+                .then(response => {
+                    if (!response.ok) {
+                        throw new Error('sensor busy');
+                    }
+                    return response.json();
+                })
+                .then(data => {
+                    waitForMeasurement(data.sequence);
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to average 16 frames on the device and show the mean
+        function takeAverage() {
+            document.getElementById('status').textContent = 'Averaging...';
+            fetch('/average?frames=16')
+                .then(response => {
+                    if (!response.ok) {
+                        throw new Error('sensor busy');
+                    }
+                    return response.json();
+                })
+                .then(data => {
+                    waitForAverage(data.sequence);
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to poll until the average started after 'previous' is complete
+        function waitForAverage(previous) {
+            fetch('/data')
+                .then(response => response.json())
+                .then(data => {
+                    const average = data.average;
+                    if (!average || !average.done || average.first_sequence <= previous) {
+                        document.getElementById('status').textContent = 'Averaging... ' +
+                            (average ? average.frames + '/' + average.target : '');
+                        setTimeout(() => waitForAverage(previous), 200);
+                        return;
+                    }
+                    spectralData = withMeta(data);
+                    spectralData.values = average.mean.map(v => Math.round(v));
+                    spectralData.averaged = true;
+                    updateChart();
+                    document.getElementById('status').textContent = 'Average of ' + average.frames + ' frames';
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
+        // Function to capture a dark reference for the current settings
+        function captureDark() {
+            if (!confirm('Cover the sensor, then press OK to capture the dark reference.')) {
+                return;
+            }
+            document.getElementById('status').textContent = 'Capturing dark reference...';
+            fetch('/dark')
+                .then(response => {
+                    if (!response.ok) {
+                        throw new Error('sensor busy');
+                    }
+                    return response.json();
+                })
+                .then(data => {
+                    waitForMeasurement(data.sequence);
+                })
+                .catch(error => {
+                    document.getElementById('status').textContent = 'Error: ' + error;
+                });
+        }
+
         // Function to download data to client's device
         function downloadData() {
             // Generate automatic filename with timestamp, wavelength, gain, and integration time
@@ -324,14 +531,44 @@ const char index_html[] PROGMEM = R"rawliteral(
             content += "Integration Time: " + spectralData.integration_time + "ms\n";
             content += "Selected Wavelength: " + 
                 spectralData.names[spectralData.selected_index] + " (" + 
-                spectralData.wavelengths[spectralData.selected_index] + "nm)\n\n";
+                spectralData.wavelengths[spectralData.selected_index] + "nm)\n";
+
+            // Settings the values were actually captured with
+            const frame = spectralData.frame;
+            if (frame) {
+                content += "Frame: " + spectralData.sequence + "\n";
+                content += "ATIME: " + frame.atime + ", ASTEP: " + frame.astep +
+                    " (" + (frame.integration_us / 1000).toFixed(2) + "ms)\n";
+                content += "Gain code: " + frame.gain_code.join("/") + "\n";
+                content += "Saturated: " + (frame.saturated ? "yes" : "no") + "\n";
+                content += "Dark corrected: " + (spectralData.dark && spectralData.dark.corrected ? "yes" : "no") + "\n";
+                content += "Clear: " + frame.clear.join("/") + ", NIR: " + frame.nir.join("/") + "\n";
+            }
+            const average = spectralData.averaged ? spectralData.average : null;
+            if (average) {
+                content += "Average: " + average.frames + " frames\n";
+            }
+            const hdr = spectralData.hdr;
+            if (hdr && hdr.sequence === spectralData.sequence) {
+                content += "HDR: " + hdr.exposures + " exposures, " +
+                    (hdr.capture_us / 1000).toFixed(1) + "ms\n";
+            }
+            content += "\n";
             
             // Add wavelength headers
-            content += "Wavelength (nm),Value\n";
+            const fused = hdr && hdr.sequence === spectralData.sequence;
+            content += "Wavelength (nm),Value" + (average ? ",Std dev,SNR" : "") + (fused ? ",Basic counts,Weight" : "") + "\n";
             
             // Add data for each wavelength
             for (let i = 0; i < spectralData.wavelengths.length; i++) {
-                content += spectralData.wavelengths[i] + "," + spectralData.values[i] + "\n";
+                content += spectralData.wavelengths[i] + "," + spectralData.values[i];
+                if (average) {
+                    content += "," + average.stddev[i] + "," + average.snr[i];
+                }
+                if (fused) {
+                    content += "," + hdr.basic[i] + "," + hdr.weight[i];
+                }
+                content += "\n";
             }
             
             // Create a blob with the data
@@ -355,17 +592,57 @@ const char index_html[] PROGMEM = R"rawliteral(
             }, 3000);
         }
         
-        // Function to periodically refresh data
+        // Function to periodically refresh data: the packed frame each
+        // time, the full /data (settings, colour, status) every fifth
+        let refreshTimer = null;
+        let refreshCount = 0;
         function startAutoRefresh() {
-            // Refresh data every 2 seconds
-            setInterval(function() {
-                fetchData();
-            }, 2000);
+            // Refresh data every 2 seconds, or at the frame rate in continuous mode
+            let interval = 2000;
+            if (spectralData.continuous) {
+                interval = Math.max(spectralData.period, 200);
+            }
+            refreshTimer = setTimeout(function() {
+                if (++refreshCount % 5 === 0) {
+                    fetchData();
+                } else {
+                    fetchFrame();
+                }
+                startAutoRefresh();
+            }, interval);
+        }
+
+        function stopAutoRefresh() {
+            clearTimeout(refreshTimer);
+            refreshTimer = null;
+        }
+
+        // Function to receive each new frame as the device publishes it,
+        // falling back to polling while the stream is down
+        function startEvents() {
+            if (!window.EventSource) {
+                startAutoRefresh();
+                return;
+            }
+            const events = new EventSource('http://' + location.hostname + ':81/events');
+            events.addEventListener('frame', function(e) {
+                stopAutoRefresh();
+                spectralData = withMeta(JSON.parse(e.data));
+                updateChart();
+            });
+            events.onerror = function() {
+                // The browser retries on its own unless the device refused
+                if (refreshTimer === null) {
+                    startAutoRefresh();
+                }
+            };
         }
+
         // Initialize the chart when the page loads
         window.onload = function() {
+            fetchMeta(); // Channel metadata, usually from the cache
             fetchData(); // Get initial data
-            startAutoRefresh(); // Start periodic refresh
+            startEvents(); // Then follow the frame stream
         };
     </script>
 </body>
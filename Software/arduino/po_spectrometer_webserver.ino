@@ -3,8 +3,22 @@
 #include <WiFi.h>
 #include <WebServer.h>
 #include <Wire.h>
-#include "html_content.h"
+#include "WebAssets.h"
 #include "AS7341.h"
+#include "Acquisition.h"
+#include "AutoExposure.h"
+#include "HdrFusion.h"
+#include "BasicCounts.h"
+#include "Reconstruction.h"
+#include "Colorimetry.h"
+#include "DarkFrames.h"
+#include "FrameAverage.h"
+#include "FlickerAnalyzer.h"
+#include "FlickerLock.h"
+#include "TraceLog.h"
+#include "LatencyMetrics.h"
+#include "JsonWriter.h"
+#include "EventStreams.h"
 
 // Access Point Configuration
 const char *ap_ssid = "PocketSpectro";  // Name of the WiFi network the device will create
@@ -19,6 +33,84 @@ WebServer server(80);
 // Create AS7341 sensor object
 AS7341 sensor;
 
+// GPIO wired to the AS7341 INT output (e.g. G26 on the hat header), or
+// AS7341_INT_PIN_NONE to poll for measurement completion over I2C
+const int sensorIntPin = AS7341_INT_PIN_NONE;
+
+// GPIO wired to the AS7341 GPIO pin to trigger synced captures (SYNS), or
+// AS7341_INT_PIN_NONE when the sync edges come from an external strobe
+const int syncTriggerPin = AS7341_INT_PIN_NONE;
+
+// Sensor configuration; gain, ATIME and mode follow the UI selections
+// (defaults: SPM, ATIME 29, ASTEP 599 = 1.67 ms, gain 8x)
+SensorConfig sensorConfig;
+
+// Auto-exposure picks gain/ATIME from the captured counts instead of the
+// manual selections; a one-shot measurement retakes up to this many frames
+AutoExposure autoExposure;
+bool autoExposureEnabled = false;
+#define AE_MAX_ITERATIONS 4
+
+// Raw counts to basic counts (per ms at 1x), for comparing captures
+BasicCounts basicCounts;
+
+// Dense spectrum for /spectrum, computed only when requested
+Reconstruction reconstruction;
+
+// XYZ, chromaticity, CCT and lux of the latest frame (/color and /data),
+// computed once per frame however many clients ask
+Colorimetry colorimetry;
+
+// Dark references per gain/ATIME/ASTEP, kept in NVS and subtracted from
+// every frame; darkCapture is set while /dark is taking a new one
+DarkFrames darkFrames;
+bool darkCapture = false;
+
+// N-frame average (/average); frames are folded in as they are published.
+// averageRunsContinuous is set when /average started continuous mode itself.
+FrameAverage frameAverage;
+bool averageRunsContinuous = false;
+
+// HDR bracket (/hdr): exposure being captured, -1 when not bracketing
+HdrFusion hdr;
+int hdrExposure = -1;
+
+// Two-phase capture driven from loop()
+Acquisition acquisition(sensor);
+
+// Flicker waveform from the FD FIFO, run by the acquisition between
+// frames whenever the last result is older than FLICKER_REFRESH_MS
+FlickerAnalyzer flicker(sensor);
+#define FLICKER_REFRESH_MS 10000
+
+// Flicker-locked exposure (/flicker_lock): integration time moved to whole
+// cycles of the measured flicker so readings do not depend on its phase
+FlickerLock flickerLock;
+bool flickerLockEnabled = false;
+
+// Latency histograms for /metrics: capture phases and register accesses
+// from the driver, /data building and sending, and screen redraws
+LatencyMetrics metrics;
+
+// Pieces the compressed page is sent in: one TCP segment
+#define WEB_CHUNK_SIZE 1436
+
+// Serialised JSON replies and frame events are built here, in loop()
+// context, rather than on the heap
+#define REPLY_BUFFER_SIZE 3072
+char replyBuffer[REPLY_BUFFER_SIZE];
+// Room one /trace entry can take: every character of the message escaped
+#define TRACE_ENTRY_JSON_SIZE (2 * LOG_LINE_SIZE + 64)
+
+// Server-sent event streams (/events on EVENTS_PORT), built in the reply
+// buffer
+#define EVENTS_PORT 81
+WiFiServer eventServer(EVENTS_PORT);
+EventStreams events(eventServer, replyBuffer, sizeof(replyBuffer));
+
+// Continuous mode frame period (ms), changed via /continuous?period=
+uint32_t continuousPeriodMs = 500;
+
 // Global variables for gain and integration time settings
 uint8_t gainCodes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
 float gainFactors[] = {0.5, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512};
@@ -29,16 +121,18 @@ int wavelengthIndex = 2; // Default to blue(index 2)
 String wavelengthNames[] = {"Violet", "Vio-Blue", "Blue", "Cyan", "Green", "Yellow", "Orange", "Red", "NIR"};
 int wavelengthValues[] = {415, 445, 480, 515, 555, 590, 630, 680, 940}; // Center wavelengths in nm
 
-// Spectral data storage
-uint16_t spectralData[9]; // F1-F8 + NIR
-
 // Flag to indicate if a new measurement was taken
 bool newMeasurementTaken = false;
 
+// Gain/integration changed while a capture was running; applied between frames
+bool settingsPending = false;
+
 // Add these global variables for UI state
 int displayMode = 0; // 0: spectrum, 1: wavelength selection, 2: gain settings, 3: integration time
 unsigned long lastUIUpdate = 0;
 const int uiUpdateInterval = 100; // Update UI every 100ms
+unsigned long modeRedrawAt = 0;   // Pending redraw after the mode change banner
+const int modeBannerTime = 300;   // How long the mode change banner stays up
 
 // Define 16-bit RGB565 colors for M5StickC Plus
 // Note: These are 16-bit colors, not 24-bit
@@ -59,95 +153,193 @@ uint16_t wavelengthColors[] = {
     COLOR_VIOLET, COLOR_INDIGO, COLOR_BLUE, COLOR_CYAN, COLOR_GREEN,
     COLOR_YELLOW, COLOR_ORANGE, COLOR_RED, COLOR_GREY};
 
+// Index of the ATIME setting closest to 'atime', so that the display and
+// the manual buttons follow auto-exposure
+int nearestATimeIndex(uint8_t atime)
+{
+    int nearest = 0;
+    for (int i = 1; i < 6; i++)
+    {
+        if (abs(atimeSettings[i] - atime) < abs(atimeSettings[nearest] - atime))
+        {
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+// The settings updateSettings() applies: the manual choices unless
+// auto-exposure owns them, then moved by the flicker lock
+void resolveSettings(SensorConfig &config, FlickerLock &lock)
+{
+    if (!autoExposureEnabled)
+    {
+        config.atime = atimeSettings[atimeIndex];
+        config.astep = SensorConfig().astep; // The flicker lock may have moved it
+        config.gain = gainCodes[gainIndex];
+    }
+    if (flickerLockEnabled)
+    {
+        lock.apply(flicker.result(), config);
+    }
+}
+
+// Integration time (ms) of the current settings, whether or not they have
+// reached the sensor yet (they wait for the frame boundary)
+float integrationTimeMs()
+{
+    SensorConfig config = sensorConfig;
+    FlickerLock lock = flickerLock;
+    resolveSettings(config, lock);
+    return (config.atime + 1) * (config.astep + 1) * 0.00278f;
+}
+
 // Function to update sensor settings
 void updateSettings()
 {
-    sensor.setATime(atimeSettings[atimeIndex]);
-    sensor.setGain(gainCodes[gainIndex]);
+    resolveSettings(sensorConfig, flickerLock);
+    if (sensor.apply(sensorConfig) == 0)
+    {
+        return; // Sensor already configured
+    }
 
-    // Debug output
-    Serial.print("Updated settings - Gain: x");
-    Serial.print(gainFactors[gainIndex]);
-    Serial.print(", Integration time: ");
-    float integrationTimeMs = (atimeSettings[atimeIndex] + 1) * 2.78;
-    Serial.print(integrationTimeMs);
-    Serial.println("ms");
+    LOG_INFO("settings: gain code %ld, ATIME %ld, ASTEP %ld", sensorConfig.gain, sensorConfig.atime, sensorConfig.astep);
+}
+
+// Apply new settings now, or at the next frame boundary if a capture is running
+void requestSettingsUpdate()
+{
+    if (acquisition.busy())
+    {
+        settingsPending = true;
+        return;
+    }
+    updateSettings();
 }
 
 // Function to take a measurement
+// Starts a two-phase capture; loop() drives it and publishes the result
 void takeMeasurement()
 {
+    if (acquisition.busy())
+    {
+        return; // The running capture will publish shortly
+    }
+
     // Update sensor settings first
     updateSettings();
+    settingsPending = false;
+    autoExposure.reset();
 
-    // Turn on LED for measurement
-    sensor.enableLED(true);
-    sensor.setLEDCurrent(25); // 25mA current
-
-    Serial.println("Starting first measurement (F1F4CN)...");
-
-    // First measurement: F1-F4 + Clear + NIR
-    sensor.startMeasure("F1F4CN");
+    LOG_DEBUG("capture started");
+    acquisition.start();
+}
 
-    // Read the spectral data for first 4 channels
-    uint16_t channelData1[6];
-    sensor.getSpectralData(channelData1);
+// Function to publish a finished capture
+void publishMeasurement()
+{
+    const SpectralFrame &frame = acquisition.latest();
 
-    Serial.println("First measurement data:");
-    for (int i = 0; i < 6; i++)
+    // Dark capture for /dark: keep it as the reference for these settings
+    // and go back to corrected frames with the LED on
+    if (darkCapture)
     {
-        Serial.print(i);
-        Serial.print(": ");
-        Serial.println(channelData1[i]);
+        finishDarkCapture();
+        darkFrames.store(frame);
+        LOG_INFO("dark reference stored: gain code %ld, ATIME %ld, ASTEP %ld", frame.gain(SPECTRAL_PHASE_F1F4),
+                 frame.atime, frame.astep);
+        newMeasurementTaken = true;
+        pushFrameEvent();
+        return;
     }
 
-    Serial.println("Starting second measurement (F5F8CN)...");
+    // HDR bracket: capture the next exposure, or restore the normal
+    // settings once the last one is in
+    bool bracketed = hdrExposure >= 0;
+    if (bracketed)
+    {
+        if (!hdr.add(hdrExposure, frame))
+        {
+            sensor.apply(hdr.exposure(++hdrExposure));
+            acquisition.start();
+            return;
+        }
+        hdrExposure = -1;
+        settingsPending = true;
+    }
 
-    // Second measurement: F5-F8 + Clear + NIR
-    sensor.startMeasure("F5F8CN");
+    // Averaging: fold the frame in while the sensor integrates the next one
+    bool averaging = frameAverage.active();
+    if (averaging && frameAverage.add(frame) && averageRunsContinuous)
+    {
+        averageRunsContinuous = false;
+        acquisition.setContinuous(false, continuousPeriodMs);
+    }
 
-    // Read the spectral data for next 4 channels
-    uint16_t channelData2[6];
-    sensor.getSpectralData(channelData2);
+    // Let auto-exposure choose the settings for the next frame (not while
+    // averaging, which needs constant settings)
+    bool retake = false;
+    if (autoExposureEnabled && !bracketed && !averaging && !autoExposure.update(frame, sensorConfig))
+    {
+        gainIndex = sensorConfig.gain; // Gain codes and indices coincide
+        atimeIndex = nearestATimeIndex(sensorConfig.atime);
+        settingsPending = true;
+        retake = !acquisition.continuous() && !autoExposure.limited() && autoExposure.iterations() < AE_MAX_ITERATIONS;
+    }
 
-    Serial.println("Second measurement data:");
-    for (int i = 0; i < 6; i++)
+    // A new flicker measurement moves the lock, unless samples were lost
+    if (flickerLockEnabled && !bracketed && !flicker.result().overflow &&
+        flicker.result().frequencyHz != flickerLock.source())
     {
-        Serial.print(i);
-        Serial.print(": ");
-        Serial.println(channelData2[i]);
+        settingsPending = true;
     }
 
-    // Turn off LED after measurement
-    sensor.enableLED(false);
+    // New settings take effect from the next frame on. In continuous mode
+    // the sensor may already be integrating that frame's first phase; the
+    // acquisition then drops it rather than publish a mixed exposure.
+    if (settingsPending)
+    {
+        settingsPending = false;
+        updateSettings();
+        acquisition.setPeriod(averageRunsContinuous ? ACQ_MIN_PERIOD_MS : continuousPeriodMs);
+    }
 
-    // Map to our spectral data array (F1-F8 + NIR)
-    for (int i = 0; i < 4; i++)
+    if (retake)
     {
-        spectralData[i] = channelData1[i];     // F1-F4
-        spectralData[i + 4] = channelData2[i]; // F5-F8
+        // Not announced: the client keeps waiting while "measuring" is set
+        acquisition.start();
+        return;
     }
 
-    // Use NIR from second measurement (or average both if preferred)
-    spectralData[8] = channelData2[5]; // NIR
+    LOG_DEBUG("frame %ld: ATIME %ld, ASTEP %ld, gain code %ld", frame.sequence, frame.atime, frame.astep,
+              frame.gain(SPECTRAL_PHASE_F1F4));
+    if (frame.saturated())
+    {
+        LOG_WARN("frame %ld saturated", frame.sequence);
+    }
 
-    // Debug output
-    Serial.println("Final Spectral Data:");
-    for (int i = 0; i < 9; i++)
+    // Channel counts for one-shot captures only; in continuous mode they
+    // would push everything else out of the trace
+    if (!acquisition.continuous())
     {
-        Serial.print(wavelengthValues[i]);
-        Serial.print("nm: ");
-        Serial.println(spectralData[i]);
+        LOG_DEBUG("F1-F4: %ld %ld %ld %ld", frame.channel(0), frame.channel(1), frame.channel(2), frame.channel(3));
+        LOG_DEBUG("F5-F8: %ld %ld %ld %ld", frame.channel(4), frame.channel(5), frame.channel(6), frame.channel(7));
+        LOG_DEBUG("NIR: %ld, clear: %ld / %ld", frame.channel(8), frame.clear(SPECTRAL_PHASE_F1F4),
+                  frame.clear(SPECTRAL_PHASE_F5F8));
     }
 
     // Set flag to indicate new measurement
     newMeasurementTaken = true;
+    pushFrameEvent();
 }
 
 // Function to display spectrum on M5StickC Plus screen
 // Function to display spectrum in portrait mode
 void displaySpectrum()
 {
+    LatencyScope timing(metrics, METRIC_DISPLAY_SPECTRUM);
+    const SpectralFrame &frame = acquisition.latest();
+
     // Clear the screen
     M5.Lcd.fillScreen(COLOR_BLACK);
 
@@ -171,7 +363,12 @@ void displaySpectrum()
     M5.Lcd.setTextColor(COLOR_WHITE);
     M5.Lcd.setCursor(5, infoY + 25);
     M5.Lcd.print("Val: ");
-    M5.Lcd.print(spectralData[wavelengthIndex]);
+    M5.Lcd.print(frame.channel(wavelengthIndex));
+    if (frame.saturated())
+    {
+        M5.Lcd.setTextColor(COLOR_RED);
+        M5.Lcd.print(" SAT");
+    }
 
     // Draw separator line
     M5.Lcd.drawLine(0, infoY + 50, M5.Lcd.width(), infoY + 50, COLOR_WHITE);
@@ -189,8 +386,8 @@ void displaySpectrum()
     uint16_t maxVal = 0;
     for (int i = 0; i < 9; i++)
     {
-        if (spectralData[i] > maxVal)
-            maxVal = spectralData[i];
+        if (frame.channel(i) > maxVal)
+            maxVal = frame.channel(i);
     }
 
     // Ensure maxVal is at least 1 to avoid division by zero
@@ -207,7 +404,7 @@ void displaySpectrum()
     for (int i = 0; i < 9; i++)
     {
         // Calculate bar width based on value
-        int barWidth = (spectralData[i] * chartWidth) / maxVal;
+        int barWidth = (frame.channel(i) * chartWidth) / maxVal;
         if (barWidth < 1)
             barWidth = 1; // Ensure at least 1 pixel width
 
@@ -265,15 +462,15 @@ void displaySpectrum()
 
     M5.Lcd.setTextColor(COLOR_CYAN);
     M5.Lcd.setCursor(M5.Lcd.width() / 2, M5.Lcd.height() - 12);
-    float integrationTimeMs = (atimeSettings[atimeIndex] + 1) * 2.78;
     M5.Lcd.print("I:");
-    M5.Lcd.print(integrationTimeMs, 1);
+    M5.Lcd.print(integrationTimeMs(), 1);
     M5.Lcd.print("ms");
 }
 
 // Function to display wavelength selection screen in portrait mode
 void displayWavelengthSelection()
 {
+    LatencyScope timing(metrics, METRIC_DISPLAY_WAVELENGTH);
     M5.Lcd.fillScreen(COLOR_BLACK);
 
     // Title
@@ -332,6 +529,7 @@ void displayWavelengthSelection()
 // Function to display gain settings screen
 void displayGainSettings()
 {
+    LatencyScope timing(metrics, METRIC_DISPLAY_GAIN);
     M5.Lcd.fillScreen(COLOR_BLACK);
 
     // Title
@@ -410,6 +608,7 @@ void displayGainSettings()
 // Function to display integration time settings screen
 void displayIntegrationSettings()
 {
+    LatencyScope timing(metrics, METRIC_DISPLAY_INTEGRATION);
     M5.Lcd.fillScreen(COLOR_BLACK);
 
     // Title - make it fit with word wrapping
@@ -424,7 +623,7 @@ void displayIntegrationSettings()
     M5.Lcd.drawLine(5, 45, M5.Lcd.width() - 5, 45, COLOR_YELLOW);
 
     // Calculate current integration time
-    float integrationTimeMs = (atimeSettings[atimeIndex] + 1) * 2.78;
+    float timeMs = integrationTimeMs();
 
     // Current integration time value - large and centered
     M5.Lcd.setTextSize(3);
@@ -432,7 +631,7 @@ void displayIntegrationSettings()
 
     // Format with one decimal place
     char timeText[10];
-    sprintf(timeText, "%.1f", integrationTimeMs);
+    sprintf(timeText, "%.1f", timeMs);
     String displayText = String(timeText) + " ms";
 
     // Calculate position to center the text
@@ -450,7 +649,8 @@ void displayIntegrationSettings()
     // Calculate position on the slider based on current setting
     float minTime = (atimeSettings[0] + 1) * 2.78;
     float maxTime = (atimeSettings[5] + 1) * 2.78;
-    int markerPosition = ((integrationTimeMs - minTime) / (maxTime - minTime)) * sliderWidth;
+    int markerPosition = ((timeMs - minTime) / (maxTime - minTime)) * sliderWidth;
+    markerPosition = constrain(markerPosition, 0, sliderWidth); // Locked or auto-exposed times may lie outside
 
     // Draw the slider bar
     M5.Lcd.drawRect(10, sliderY, sliderWidth, sliderHeight, COLOR_WHITE);
@@ -497,20 +697,30 @@ void performMeasurement()
     // Center text for portrait mode
     int centerX = (M5.Lcd.width() - 11 * 12) / 2; // 11 chars * ~12 pixels/char at size 2
     M5.Lcd.setCursor(centerX, M5.Lcd.height() / 2 - 20);
-    M5.Lcd.print("MEASURING");
-
-    // Animated dots
-    for (int i = 0; i < 3; i++)
-    {
-        M5.Lcd.print(".");
-        delay(200);
-    }
+    M5.Lcd.print("MEASURING...");
 
-    // Perform the actual measurement
+    // Start the measurement; loop() redraws the spectrum once it is published
     takeMeasurement();
+}
 
-    // Show updated display
-    displaySpectrum();
+// Function to draw the screen for the current display mode
+void displayCurrentMode()
+{
+    switch (displayMode)
+    {
+    case 0:
+        displaySpectrum();
+        break;
+    case 1:
+        displayWavelengthSelection();
+        break;
+    case 2:
+        displayGainSettings();
+        break;
+    case 3:
+        displayIntegrationSettings();
+        break;
+    }
 }
 // Function to handle DNS requests for captive portal
 void handleDNS()
@@ -521,52 +731,675 @@ void handleDNS()
 }
 
 // HTTP request handlers
+// The page as generated into WebAssets.h: gzip-compressed, written out
+// in segment-sized pieces straight from flash. Browsers revalidate it on
+// each load and get a 304 while the firmware's page is unchanged.
 void handleRoot()
 {
-    server.send(200, "text/html", index_html);
+    server.sendHeader("ETag", INDEX_HTML_ETAG);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == INDEX_HTML_ETAG)
+    {
+        server.send(304);
+        return;
+    }
+
+    server.sendHeader("Content-Encoding", "gzip");
+    server.setContentLength(INDEX_HTML_GZ_SIZE);
+    server.send(200, "text/html", "");
+    const char *page = (const char *)index_html_gz;
+    for (size_t sent = 0; sent < INDEX_HTML_GZ_SIZE; sent += WEB_CHUNK_SIZE)
+    {
+        size_t chunk = INDEX_HTML_GZ_SIZE - sent < WEB_CHUNK_SIZE ? INDEX_HTML_GZ_SIZE - sent : WEB_CHUNK_SIZE;
+        server.sendContent_P(page + sent, chunk);
+    }
 }
 
-void handleData()
+// Everything the page shows about the latest frame, for /data and /events.
+// Written into 'buffer'; returns the length, or 0 if it did not fit.
+size_t dataJson(char *buffer, size_t size)
 {
-    String json = "{";
-    json += "\"wavelengths\": [415, 445, 480, 515, 555, 590, 630, 680, 940],";
-    json += "\"names\": [\"Violet\", \"Vio-Blue\", \"Blue\", \"Cyan\", \"Green\", \"Yellow\", \"Orange\", \"Red\", \"NIR\"],";
+    const SpectralFrame &frame = acquisition.latest();
+    JsonWriter json(buffer, size);
+    json.beginObject();
 
-    // Add values array
-    json += "\"values\": [";
+    // Add values array (wavelengths and names are in /meta)
+    json.beginArray("values");
     for (int i = 0; i < 9; i++)
     {
-        json += String(spectralData[i]);
-        if (i < 8)
-            json += ",";
+        json.addUnsigned(NULL, frame.channel(i));
     }
-    json += "],";
+    json.endArray();
+
+    // Everything else the frame was captured with, per SMUX phase
+    json.beginObject("frame");
+    json.addUnsigned("atime", frame.atime);
+    json.addUnsigned("astep", frame.astep);
+    json.addUnsigned("integration_us", frame.integrationMicros());
+    json.addBool("saturated", frame.saturated());
+    json.beginArray("gain_code");
+    json.addUnsigned(NULL, frame.gain(0));
+    json.addUnsigned(NULL, frame.gain(1));
+    json.endArray();
+    json.beginArray("astatus");
+    json.addUnsigned(NULL, frame.astatus[0]);
+    json.addUnsigned(NULL, frame.astatus[1]);
+    json.endArray();
+    json.beginArray("clear");
+    json.addUnsigned(NULL, frame.clear(0));
+    json.addUnsigned(NULL, frame.clear(1));
+    json.endArray();
+    json.beginArray("nir");
+    json.addUnsigned(NULL, frame.nir(0));
+    json.addUnsigned(NULL, frame.nir(1));
+    json.endArray();
+    json.beginArray("timestamps_us");
+    json.addUnsigned(NULL, frame.phaseMicros[0]);
+    json.addUnsigned(NULL, frame.phaseMicros[1]);
+    json.endArray();
+
+    // Basic counts (counts per ms at 1x gain) per channel
+    uint32_t basic[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    basicCounts.normalise(frame, basic);
+    json.beginArray("basic");
+    for (int i = 0; i < 9; i++)
+    {
+        uint32_t value = i < 4 ? basic[SPECTRAL_PHASE_F1F4][i] : (i < 8 ? basic[SPECTRAL_PHASE_F5F8][i - 4] : basic[SPECTRAL_PHASE_F5F8][SPECTRAL_ADC_NIR]);
+        json.addFloat(NULL, BasicCounts::toFloat(value), 4);
+    }
+    json.endArray();
+    const ColorResult &color = colorimetry.compute(frame);
+    json.beginObject("color");
+    json.addBool("valid", color.valid);
+    json.addFloat("lux", color.lux, 2);
+    json.addFloat("cct", color.cct, 0);
+    json.addFloat("duv", color.duv, 4);
+    json.addFloat("x", color.x, 4);
+    json.addFloat("y", color.y, 4);
+    json.endObject();
+    json.endObject();
 
     // Add other parameters
-    json += "\"gain\": " + String(gainFactors[gainIndex]) + ",";
-    float integrationTimeMs = (atimeSettings[atimeIndex] + 1) * 2.78;
-    json += "\"integration_time\": " + String(integrationTimeMs) + ",";
-    json += "\"selected_index\": " + String(wavelengthIndex);
-    json += "}";
+    json.addFloat("gain", gainFactors[gainIndex], 2);
+    json.addFloat("integration_time", integrationTimeMs(), 2);
+    json.addUnsigned("selected_index", wavelengthIndex);
+    json.addUnsigned("sequence", frame.sequence);
+
+    // Last HDR bracket: fused basic counts (counts per ms at 1x) and the
+    // confidence of each channel
+    const HdrSpectrum &fused = hdr.result();
+    if (fused.exposures > 0)
+    {
+        json.beginObject("hdr");
+        json.addUnsigned("sequence", fused.sequence);
+        json.addUnsigned("exposures", fused.exposures);
+        json.addUnsigned("planned_us", fused.plannedMicros);
+        json.addUnsigned("capture_us", fused.captureMicros);
+        json.beginArray("basic");
+        for (int i = 0; i < 9; i++)
+        {
+            json.addFloat(NULL, fused.channel(i), 4);
+        }
+        json.endArray();
+        json.beginArray("weight");
+        for (int i = 0; i < 9; i++)
+        {
+            json.addFloat(NULL, fused.channelWeight(i), 3);
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.beginObject("auto_exposure");
+    json.addBool("enabled", autoExposureEnabled);
+    json.addBool("converged", autoExposure.converged());
+    json.addBool("limited", autoExposure.limited());
+    json.addUnsigned("iterations", autoExposure.iterations());
+    json.addFloat("fill", autoExposure.lastFill(), 3);
+    json.endObject();
+    if (frameAverage.target() > 0)
+    {
+        json.beginObject("average");
+        json.addUnsigned("frames", frameAverage.count());
+        json.addUnsigned("target", frameAverage.target());
+        json.addBool("done", frameAverage.done());
+        json.addUnsigned("first_sequence", frameAverage.firstSequence());
+        json.addUnsigned("elapsed_us", frameAverage.elapsedMicros());
+        const char *fields[] = {"mean", "stddev", "snr"};
+        for (int f = 0; f < 3; f++)
+        {
+            json.beginArray(fields[f]);
+            for (int i = 0; i < 9; i++)
+            {
+                float value = f == 0 ? frameAverage.mean(i) : (f == 1 ? frameAverage.stddev(i) : frameAverage.snr(i));
+                json.addFloat(NULL, value, 2);
+            }
+            json.endArray();
+        }
+        json.endObject();
+    }
+    json.beginObject("dark");
+    json.addBool("corrected", acquisition.darkCorrected());
+    json.addBool("needed", darkFrames.needed(sensorConfig.gain, sensorConfig.atime, sensorConfig.astep));
+    json.addInt("age_s", darkFrames.age(sensorConfig.gain, sensorConfig.atime, sensorConfig.astep));
+    json.addUnsigned("references", darkFrames.count());
+    json.endObject();
+    // Cached flicker result; "age_ms" is -1 until the first one
+    const FlickerResult &flickerResult = flicker.result();
+    json.beginObject("flicker");
+    json.addFloat("frequency_hz", flickerResult.frequencyHz, 1);
+    json.addFloat("modulation_depth", flickerResult.modulationDepth, 4);
+    json.addFloat("flicker_index", flickerResult.flickerIndex, 4);
+    json.addInt("age_ms", flicker.age());
+    json.endObject();
+    json.beginObject("flicker_lock");
+    json.addBool("enabled", flickerLockEnabled);
+    json.addBool("locked", flickerLock.locked());
+    json.addFloat("frequency_hz", flickerLock.frequency(), 2);
+    json.addUnsigned("cycles", flickerLock.cycles());
+    json.addUnsigned("integration_us", flickerLock.integrationMicros());
+    json.addFloat("phase_error_deg", flickerLock.phaseError(), 3);
+    json.addFloat("ripple", flickerLock.ripple(flickerResult.amplitudeDepth), 5);
+    json.endObject();
+    json.addBool("measuring", acquisition.busy());
+    json.addBool("continuous", acquisition.continuous());
+    json.addUnsigned("period", continuousPeriodMs);
+    json.addString("sync_mode", measureModeName(sensorConfig.mode));
+    if (sensorConfig.mode == AS7341_MODE_SYND)
+    {
+        json.addUnsigned("sync_integration_us", sensor.getSyncIntegrationMicros());
+    }
+    json.endObject();
+
+    if (json.overflowed())
+    {
+        LOG_ERROR("/data reply over %ld bytes", size);
+        return 0;
+    }
+    return json.length();
+}
+
+void handleData()
+{
+    unsigned long buildStart = micros();
+    size_t length = dataJson(replyBuffer, sizeof(replyBuffer));
+    metrics.record(METRIC_DATA_JSON, micros() - buildStart);
+    if (length == 0)
+    {
+        server.send(500, "application/json", "{\"error\": \"reply too large\"}");
+        return;
+    }
 
-    Serial.println("Sending JSON data to client:");
-    Serial.println(json);
+    LOG_DEBUG("/data: %ld bytes", length);
+    LatencyScope timing(metrics, METRIC_SEND);
+    server.send_P(200, "application/json", replyBuffer, length);
+}
 
-    server.send(200, "application/json", json);
+// Channel metadata that never changes while the firmware runs, so the
+// browser may keep it: wavelengths, names, the gain factor of each gain
+// code and the /frame.bin layout version
+void handleMeta()
+{
+    JsonWriter json(replyBuffer, sizeof(replyBuffer));
+    json.beginObject();
+    json.beginArray("wavelengths");
+    for (int i = 0; i < 9; i++)
+    {
+        json.addInt(NULL, wavelengthValues[i]);
+    }
+    json.endArray();
+    json.beginArray("names");
+    for (int i = 0; i < 9; i++)
+    {
+        json.addString(NULL, wavelengthNames[i].c_str());
+    }
+    json.endArray();
+    json.beginArray("gain_factors");
+    for (int i = 0; i < 11; i++)
+    {
+        json.addFloat(NULL, gainFactors[i], 1);
+    }
+    json.endArray();
+    json.beginObject("frame_bin");
+    json.addUnsigned("version", FRAME_PACKET_VERSION);
+    json.addUnsigned("size", FRAME_PACKET_SIZE);
+    json.endObject();
+    json.endObject();
+
+    server.sendHeader("Cache-Control", "public, max-age=86400");
+    server.send_P(200, "application/json", replyBuffer, json.length());
 }
 
-void handleMeasure()
+// The latest frame packed as in SpectralFrame.h: 38 bytes instead of the
+// kilobyte and more of /data, for polling the counts alone
+void handleFrameBin()
 {
+    uint8_t flags = 0;
+    flags |= acquisition.darkCorrected() ? FRAME_FLAG_DARK_CORRECTED : 0;
+    flags |= acquisition.busy() ? FRAME_FLAG_MEASURING : 0;
+    flags |= acquisition.continuous() ? FRAME_FLAG_CONTINUOUS : 0;
+
+    uint8_t packet[FRAME_PACKET_SIZE];
+    size_t length = acquisition.latest().pack(flags, packet);
 
-    Serial.println("Web client requested new measurement");
+    server.sendHeader("Cache-Control", "no-store");
+    server.send_P(200, "application/octet-stream", (const char *)packet, length);
+}
+
+// Pushes the latest frame to the event streams as the /data JSON; a
+// stream that cannot take it at once is dropped rather than waited for
+void pushFrameEvent()
+{
+    events.push(acquisition.latest().sequence, dataJson);
+}
 
-    // Take a new measurement
+void handleMeasure()
+{
+    LOG_INFO("measurement requested");
+
+    // Start a new measurement; the client polls /data until the sequence changes
     takeMeasurement();
 
     // Return the same data format as handleData
     handleData();
 }
 
+// Start or stop continuous capture: /continuous?enable=1&period=500
+void handleContinuous()
+{
+    if (server.hasArg("period"))
+    {
+        continuousPeriodMs = server.arg("period").toInt();
+        if (continuousPeriodMs < ACQ_MIN_PERIOD_MS)
+        {
+            continuousPeriodMs = ACQ_MIN_PERIOD_MS;
+        }
+    }
+    bool enable = server.hasArg("enable") ? server.arg("enable").toInt() != 0 : !acquisition.continuous();
+
+    if (enable && !acquisition.continuous())
+    {
+        acquisition.stop(); // A one-shot capture in flight restarts as the first frame
+    }
+    averageRunsContinuous = false; // An average in progress now runs at this period
+    acquisition.setContinuous(enable, continuousPeriodMs);
+    if (enable && !acquisition.busy())
+    {
+        updateSettings();
+        settingsPending = false;
+        acquisition.start();
+    }
+
+    char buffer[48];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addBool("continuous", acquisition.continuous());
+    json.addUnsigned("period", continuousPeriodMs);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+const char *measureModeName(uint8_t mode)
+{
+    switch (mode)
+    {
+    case AS7341_MODE_SYNS:
+        return "syns";
+    case AS7341_MODE_SYND:
+        return "synd";
+    default:
+        return "spm";
+    }
+}
+
+// Select SPM or an externally synced mode: /sync?mode=synd&edges=20&timeout=2000
+// In SYNS each phase integrates ATIME x ASTEP from a sync edge; in SYND it
+// runs from one edge to the 'edges'-th following one.
+void handleSync()
+{
+    String mode = server.arg("mode");
+    if (mode == "syns")
+    {
+        sensorConfig.mode = AS7341_MODE_SYNS;
+    }
+    else if (mode == "synd")
+    {
+        sensorConfig.mode = AS7341_MODE_SYND;
+    }
+    else if (mode == "spm")
+    {
+        sensorConfig.mode = AS7341_MODE_SPM;
+    }
+
+    // The mode can only change with SP_EN off; a continuous run restarts in the new mode
+    bool wasContinuous = acquisition.continuous() && acquisition.busy();
+    acquisition.stop();
+    updateSettings();
+    if (server.hasArg("edges"))
+    {
+        sensor.setSyncEdges(server.arg("edges").toInt());
+    }
+    if (server.hasArg("timeout"))
+    {
+        sensor.setSyncTimeout(server.arg("timeout").toInt());
+    }
+    if (wasContinuous)
+    {
+        acquisition.start();
+    }
+
+    char buffer[40];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addString("sync_mode", measureModeName(sensorConfig.mode));
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Turn auto-exposure on or off: /auto_exposure?enable=1&target=0.5
+void handleAutoExposure()
+{
+    if (server.hasArg("target"))
+    {
+        float target = server.arg("target").toFloat();
+        if (target > 0.05 && target < AE_HIGH_LIMIT)
+        {
+            autoExposure.setTarget(target);
+        }
+    }
+    autoExposureEnabled = server.hasArg("enable") ? server.arg("enable").toInt() != 0 : !autoExposureEnabled;
+    autoExposure.reset();
+    if (!autoExposureEnabled)
+    {
+        requestSettingsUpdate(); // Back to the manual selections
+    }
+
+    char buffer[32];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addBool("auto_exposure", autoExposureEnabled);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Lock the integration time to whole flicker cycles: /flicker_lock?enable=1
+// (toggles without the argument). Uses the cached flicker result and asks
+// for one if there is none yet.
+void handleFlickerLock()
+{
+    flickerLockEnabled = server.hasArg("enable") ? server.arg("enable").toInt() != 0 : !flickerLockEnabled;
+    if (flickerLockEnabled && flicker.age() < 0)
+    {
+        acquisition.refreshFlicker();
+    }
+    if (!flickerLockEnabled)
+    {
+        flickerLock.reset();
+        sensorConfig.astep = SensorConfig().astep;
+    }
+    requestSettingsUpdate();
+
+    char buffer[32];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addBool("flicker_lock", flickerLockEnabled);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Start an HDR bracket around the current settings: /hdr?budget=1000
+// (total integration time in ms). Not available in continuous mode.
+void handleHdr()
+{
+    if (acquisition.continuous() || acquisition.busy())
+    {
+        server.send(409, "application/json", "{\"error\": \"busy\"}");
+        return;
+    }
+    if (server.hasArg("budget"))
+    {
+        hdr.setBudget(server.arg("budget").toInt());
+    }
+
+    uint32_t previous = acquisition.latest().sequence;
+    updateSettings();
+    settingsPending = false;
+    hdr.plan(sensorConfig);
+    hdrExposure = 0;
+    sensor.apply(hdr.exposure(0));
+    acquisition.start();
+
+    char buffer[80];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addUnsigned("sequence", previous);
+    json.addUnsigned("exposures", hdr.exposures());
+    json.addUnsigned("planned_us", hdr.result().plannedMicros);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Average the next N frames: /average?frames=16. Runs back to back in
+// continuous mode (or at the running continuous period) so the sums are
+// updated while the sensor integrates the next frame.
+void handleAverage()
+{
+    if (acquisition.busy() && !acquisition.continuous())
+    {
+        server.send(409, "application/json", "{\"error\": \"busy\"}");
+        return;
+    }
+    uint16_t frames = server.hasArg("frames") ? server.arg("frames").toInt() : 16;
+    uint32_t previous = acquisition.latest().sequence;
+    frameAverage.begin(frames);
+
+    if (!acquisition.continuous())
+    {
+        updateSettings();
+        settingsPending = false;
+        acquisition.setContinuous(true, ACQ_MIN_PERIOD_MS);
+        acquisition.start();
+        averageRunsContinuous = true;
+    }
+
+    char buffer[48];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addUnsigned("sequence", previous);
+    json.addUnsigned("target", frameAverage.target());
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Capture a dark reference for the current settings: /dark (cover the
+// sensor first), or /dark?clear=1 to drop all stored references
+void handleDark()
+{
+    if (server.hasArg("clear") && server.arg("clear").toInt() != 0)
+    {
+        darkFrames.clear();
+        server.send(200, "application/json", "{\"references\": 0}");
+        return;
+    }
+    if (acquisition.continuous() || acquisition.busy())
+    {
+        server.send(409, "application/json", "{\"error\": \"busy\"}");
+        return;
+    }
+
+    // Raw counts with the LED off
+    uint32_t previous = acquisition.latest().sequence;
+    updateSettings();
+    settingsPending = false;
+    darkCapture = true;
+    acquisition.setDarkFrames(NULL);
+    acquisition.setLED(false, sensorConfig.ledCurrent);
+    acquisition.start();
+
+    char buffer[32];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addUnsigned("sequence", previous);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+void finishDarkCapture()
+{
+    darkCapture = false;
+    acquisition.setDarkFrames(&darkFrames);
+    acquisition.setLED(true, sensorConfig.ledCurrent);
+}
+
+// Reconstructed spectrum of the latest frame, RECON_START_NM upwards in
+// RECON_STEP_NM bins, in basic counts per nm
+void handleSpectrum()
+{
+    const SpectralFrame &frame = acquisition.latest();
+    const int32_t *spectrum = reconstruction.compute(frame);
+
+    JsonWriter json(replyBuffer, sizeof(replyBuffer));
+    json.beginObject();
+    json.addUnsigned("sequence", frame.sequence);
+    json.addUnsigned("start_nm", RECON_START_NM);
+    json.addUnsigned("step_nm", RECON_STEP_NM);
+    json.beginArray("values");
+    for (int b = 0; b < RECON_BINS; b++)
+    {
+        json.addFloat(NULL, Reconstruction::toFloat(spectrum[b]), 4);
+    }
+    json.endArray();
+    json.endObject();
+    server.send_P(200, "application/json", replyBuffer, json.length());
+}
+
+// Colorimetry of the latest frame. /color?lux=500 calibrates the lux
+// reading against a reference meter under the same light, /color?reset=1
+// goes back to the nominal scale.
+void handleColor()
+{
+    const SpectralFrame &frame = acquisition.latest();
+    colorimetry.compute(frame);
+    if (server.hasArg("reset") && server.arg("reset").toInt() != 0)
+    {
+        colorimetry.resetCalibration();
+    }
+    else if (server.hasArg("lux") && !colorimetry.calibrate(server.arg("lux").toFloat()))
+    {
+        server.send(409, "application/json", "{\"error\": \"no light\"}");
+        return;
+    }
+    const ColorResult &c = colorimetry.compute(frame);
+
+    char buffer[384];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addUnsigned("sequence", c.sequence);
+    json.addBool("valid", c.valid);
+    json.addBool("saturated", c.saturated);
+    json.addFloat("X", c.X, 3);
+    json.addFloat("Y", c.Y, 3);
+    json.addFloat("Z", c.Z, 3);
+    json.addFloat("x", c.x, 5);
+    json.addFloat("y", c.y, 5);
+    json.addFloat("u", c.u, 5);
+    json.addFloat("v", c.v, 5);
+    json.addFloat("cct", c.cct, 0);
+    json.addFloat("duv", c.duv, 5);
+    json.addFloat("lux", c.lux, 2);
+    json.addFloat("lux_scale", colorimetry.luxScale(), 3);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
+}
+
+// Latency percentiles in the Prometheus text format, for scraping.
+// /metrics?reset=1 clears the histograms after the reply.
+void handleMetrics()
+{
+    static char text[METRICS_TEXT_SIZE];
+    metrics.prometheus(text, sizeof(text));
+    server.send(200, "text/plain; version=0.0.4", text);
+    if (server.hasArg("reset") && server.arg("reset").toInt() != 0)
+    {
+        metrics.reset();
+    }
+}
+
+// Recent log entries, oldest first. /trace?since=<seq> returns only those
+// from that sequence number on; pass "next" from the previous reply to
+// follow the log. Entries above the compiled LOG_LEVEL are never recorded.
+void handleTrace()
+{
+    uint32_t since = server.hasArg("since") ? (uint32_t)server.arg("since").toInt() : 0;
+    uint32_t first = since > traceLog.oldest() ? since : traceLog.oldest();
+
+    JsonWriter json(replyBuffer, sizeof(replyBuffer));
+    json.beginObject();
+    json.addUnsigned("level", LOG_LEVEL);
+    json.addUnsigned("now_us", micros());
+    json.addUnsigned("dropped", traceLog.dropped());
+    json.beginArray("entries");
+    char message[LOG_LINE_SIZE];
+    uint32_t seq = first;
+    // The ring does not fit in the buffer at once: stop while a fully
+    // escaped entry still fits, and let "next" resume from there
+    for (; seq < traceLog.written() && json.length() + TRACE_ENTRY_JSON_SIZE < sizeof(replyBuffer); seq++)
+    {
+        const LogEntry *entry = traceLog.entry(seq);
+        TraceLog::format(*entry, message, sizeof(message), false);
+        char level[2] = {TraceLog::levelLetter(entry->level), '\0'};
+        json.beginObject();
+        json.addUnsigned("seq", seq);
+        json.addUnsigned("t_us", entry->micros);
+        json.addString("level", level);
+        json.addString("msg", message);
+        json.endObject();
+    }
+    json.endArray();
+    json.addUnsigned("next", seq);
+    json.endObject();
+    server.send_P(200, "application/json", replyBuffer, json.length());
+}
+
+// Flicker analysis of the light on the sensor. /flicker?rate=2000&gain=9
+// sets the sample rate (Hz) and FD gain code and asks for a new capture;
+// without arguments it returns the cached result, "age_ms" old. The source
+// must flicker below half the rate.
+void handleFlicker()
+{
+    if (server.hasArg("rate") || server.hasArg("gain"))
+    {
+        float rate = server.hasArg("rate") ? server.arg("rate").toFloat() : FLICKER_DEFAULT_RATE_HZ;
+        uint8_t gain = server.hasArg("gain") ? server.arg("gain").toInt() : FLICKER_DEFAULT_GAIN;
+        flicker.configure(rate, gain);
+        acquisition.refreshFlicker();
+    }
+
+    const FlickerResult &r = flicker.result();
+    JsonWriter json(replyBuffer, sizeof(replyBuffer));
+    json.beginObject();
+    json.addBool("measuring", acquisition.flickerPending());
+    json.addBool("valid", r.valid);
+    json.addInt("age_ms", flicker.age());
+    json.addFloat("frequency_hz", r.frequencyHz, 1);
+    json.addFloat("amplitude_depth", r.amplitudeDepth, 4);
+    json.addFloat("modulation_depth", r.modulationDepth, 4);
+    json.addFloat("flicker_index", r.flickerIndex, 4);
+    json.addFloat("mean", r.meanCounts, 1);
+    json.addFloat("sample_rate_hz", r.sampleRateHz, 1);
+    json.addUnsigned("capture_us", r.captureMicros);
+    json.addBool("saturated", r.saturated);
+    json.addBool("overflow", r.overflow);
+    json.beginArray("samples");
+    const uint16_t *samples = flicker.waveform();
+    for (int i = 0; i < r.samples; i++)
+    {
+        json.addUnsigned(NULL, samples[i]);
+    }
+    json.endArray();
+    json.endObject();
+    server.send_P(200, "application/json", replyBuffer, json.length());
+}
+
 void handleChangeWavelength()
 {
     // Cycle to the next wavelength
@@ -575,39 +1408,50 @@ void handleChangeWavelength()
     // Force UI update on the device
     newMeasurementTaken = true;
     // Return the new selected index
-    String json = "{\"selected_index\": " + String(wavelengthIndex) + "}";
-    server.send(200, "application/json", json);
+    char buffer[32];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addUnsigned("selected_index", wavelengthIndex);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
 }
 
 void handleAdjustGain()
 {
-    // Cycle to the next gain setting
+    // Cycle to the next gain setting (manual control ends auto-exposure)
     gainIndex = (gainIndex + 1) % 11;
-    updateSettings();
+    autoExposureEnabled = false;
+    requestSettingsUpdate();
 
     // Force UI update on the device
     newMeasurementTaken = true;
 
     // Return the new gain value
-    String json = "{\"gain\": " + String(gainFactors[gainIndex]) + "}";
-    server.send(200, "application/json", json);
+    char buffer[32];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addFloat("gain", gainFactors[gainIndex], 2);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
 }
 
 void handleAdjustIntegrationTime()
 {
-    // Cycle to the next integration time setting
+    // Cycle to the next integration time setting (manual control ends auto-exposure)
     atimeIndex = (atimeIndex + 1) % 6;
-    updateSettings();
+    autoExposureEnabled = false;
+    requestSettingsUpdate();
 
     // Force UI update on the device
     newMeasurementTaken = true;
 
-    // Calculate integration time in milliseconds
-    float integrationTimeMs = (atimeSettings[atimeIndex] + 1) * 2.78;
-
     // Return the new integration time
-    String json = "{\"integration_time\": " + String(integrationTimeMs) + "}";
-    server.send(200, "application/json", json);
+    char buffer[40];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addFloat("integration_time", integrationTimeMs(), 2);
+    json.endObject();
+    server.send_P(200, "application/json", buffer, json.length());
 }
 
 void setup()
@@ -615,7 +1459,7 @@ void setup()
     // Initialize serial communication
     Serial.begin(115200);
     delay(100); // Wait for serial monitor to open
-    Serial.println("Pocket Spectrometer starting...");
+    LOG_INFO("Pocket Spectrometer starting");
 
     // Initialize M5StickC Plus
     M5.begin();
@@ -637,13 +1481,15 @@ void setup()
 
     // Initialize I2C
     Wire.begin(32, 33); // SDA=32, SCL=33 for M5StickC Plus
-    Serial.println("I2C initialized");
+    Wire.setClock(400000); // Fast mode: flicker sampling up to 16 kHz
+    LOG_INFO("I2C initialized");
 
     // Initialize AS7341 sensor
     sensor = AS7341(Wire);
+    metrics.attach(sensor);
     if (!sensor.begin())
     {
-        Serial.println("Failed to initialize AS7341 sensor!");
+        LOG_ERROR("AS7341 not found");
         M5.Lcd.setTextSize(2);
         M5.Lcd.setTextColor(COLOR_RED);
         M5.Lcd.setCursor(5, 70);
@@ -651,7 +1497,10 @@ void setup()
         M5.Lcd.setCursor(5, 90);
         M5.Lcd.println("ERROR!");
         while (1)
+        {
+            traceLog.drain(Serial);
             delay(100); // Halt if sensor init fails
+        }
     }
 
     M5.Lcd.setTextSize(1);
@@ -659,19 +1508,38 @@ void setup()
     M5.Lcd.setCursor(5, 70);
     M5.Lcd.println("Sensor initialized!");
 
-    Serial.println("AS7341 sensor initialized successfully");
+    LOG_INFO("AS7341 initialized");
+
+    // Auto-exposure stays within the manual integration range
+    autoExposure.setATimeLimits(atimeSettings[0], atimeSettings[5]);
 
-    // Configure sensor with default settings (matching Python code)
-    sensor.setMeasureMode(AS7341_MODE_SPM);
-    sensor.setATime(29);  // 30 ASTEPS (default)
-    sensor.setAStep(599); // 1.67 ms
-    sensor.setGain(4);    // factor 8 (default)
+    // Dark references survive reboots in NVS
+    darkFrames.begin();
+    colorimetry.begin();
+    acquisition.setDarkFrames(&darkFrames);
+    acquisition.setFlicker(&flicker, FLICKER_REFRESH_MS);
+
+    // Synced captures give up if no strobe arrives
+    sensor.setSyncTimeout(5000);
+
+    // Drive the sync input ourselves when it is wired to the MCU
+    if (syncTriggerPin != AS7341_INT_PIN_NONE)
+    {
+        sensor.setSyncTriggerPin(syncTriggerPin);
+        acquisition.setSyncTrigger(true);
+    }
+
+    // Wake on the INT line instead of polling STATUS_2 when it is wired
+    if (sensorIntPin != AS7341_INT_PIN_NONE)
+    {
+        sensor.enableMeasurementInterrupt(sensorIntPin);
+    }
 
     // Apply initial settings
     updateSettings();
 
     // Set up Access Point with progress indicator
-    Serial.println("Setting up WiFi Access Point...");
+    LOG_INFO("starting access point");
 
     M5.Lcd.setTextColor(COLOR_WHITE);
     M5.Lcd.setCursor(5, 85);
@@ -688,6 +1556,7 @@ void setup()
 
     if (!apSuccess)
     {
+        LOG_ERROR("access point failed");
         M5.Lcd.setTextColor(COLOR_RED);
         M5.Lcd.setCursor(5, 100);
         M5.Lcd.println("AP Creation Failed!");
@@ -730,9 +1599,25 @@ void setup()
     M5.Lcd.println(WiFi.softAPIP().toString());
 
     // Set up web server routes
+    const char *requestHeaders[] = {"If-None-Match"};
+    server.collectHeaders(requestHeaders, 1);
     server.on("/", HTTP_GET, handleRoot);
     server.on("/data", HTTP_GET, handleData);
+    server.on("/meta", HTTP_GET, handleMeta);
+    server.on("/frame.bin", HTTP_GET, handleFrameBin);
     server.on("/measure", HTTP_GET, handleMeasure);
+    server.on("/continuous", HTTP_GET, handleContinuous);
+    server.on("/sync", HTTP_GET, handleSync);
+    server.on("/auto_exposure", HTTP_GET, handleAutoExposure);
+    server.on("/hdr", HTTP_GET, handleHdr);
+    server.on("/spectrum", HTTP_GET, handleSpectrum);
+    server.on("/color", HTTP_GET, handleColor);
+    server.on("/dark", HTTP_GET, handleDark);
+    server.on("/average", HTTP_GET, handleAverage);
+    server.on("/flicker", HTTP_GET, handleFlicker);
+    server.on("/flicker_lock", HTTP_GET, handleFlickerLock);
+    server.on("/trace", HTTP_GET, handleTrace);
+    server.on("/metrics", HTTP_GET, handleMetrics);
     server.on("/change_wavelength", HTTP_GET, handleChangeWavelength);
     server.on("/adjust_gain", HTTP_GET, handleAdjustGain);
     server.on("/adjust_integration", HTTP_GET, handleAdjustIntegrationTime);
@@ -742,6 +1627,7 @@ void setup()
 
     // Start server
     server.begin();
+    events.begin();
 
     M5.Lcd.setTextSize(1);
     M5.Lcd.setTextColor(COLOR_GREEN);
@@ -756,7 +1642,7 @@ void setup()
 
     delay(4000); // Give user time to read the instructions
 
-    // Take an initial measurement
+    // Start an initial measurement; loop() publishes it
     takeMeasurement();
 
     // Show the spectrum display
@@ -765,7 +1651,27 @@ void setup()
 
 void loop()
 {
+    // Advance a running capture by one short step
+    if (acquisition.update())
+    {
+        publishMeasurement();
+    }
+    else if (hdrExposure >= 0 && !acquisition.busy())
+    {
+        // A bracket capture failed; drop the bracket and restore the settings
+        hdrExposure = -1;
+        updateSettings();
+    }
+    else if (darkCapture && !acquisition.busy())
+    {
+        finishDarkCapture(); // Failed, nothing stored
+    }
+
     server.handleClient();
+    if (events.service())
+    {
+        pushFrameEvent(); // The current frame, so the page does not wait for the next
+    }
     M5.update();
 
     // Handle button presses based on current display mode
@@ -784,13 +1690,15 @@ void loop()
 
         case 2: // Gain settings - Change gain
             gainIndex = (gainIndex + 1) % 11;
-            updateSettings();
+            autoExposureEnabled = false;
+            requestSettingsUpdate();
             displayGainSettings();
             break;
 
         case 3: // Integration time - Change integration time
             atimeIndex = (atimeIndex + 1) % 6;
-            updateSettings();
+            autoExposureEnabled = false;
+            requestSettingsUpdate();
             displayIntegrationSettings();
             break;
         }
@@ -830,28 +1738,19 @@ void loop()
 
         M5.Lcd.setCursor(centerX, centerY);
         M5.Lcd.print(modeText);
-        delay(300); // Brief pause to show the mode change
 
-        // Update the display to the new mode
-        switch (displayMode)
-        {
-        case 0:
-            displaySpectrum();
-            break;
-        case 1:
-            displayWavelengthSelection();
-            break;
-        case 2:
-            displayGainSettings();
-            break;
-        case 3:
-            displayIntegrationSettings();
-            break;
-        }
+        // Update the display to the new mode once the banner has been seen
+        modeRedrawAt = millis() + modeBannerTime;
+    }
+
+    if (modeRedrawAt != 0 && (long)(millis() - modeRedrawAt) >= 0)
+    {
+        modeRedrawAt = 0;
+        displayCurrentMode();
     }
 
     // Update the display periodically in spectrum mode
-    if (displayMode == 0 && millis() - lastUIUpdate > uiUpdateInterval)
+    if (modeRedrawAt == 0 && displayMode == 0 && millis() - lastUIUpdate > uiUpdateInterval)
     {
         lastUIUpdate = millis();
         // Only redraw if new measurement was taken
@@ -863,7 +1762,7 @@ void loop()
     }
 
     // Check if we need to update the UI due to web interface changes when not in spectrum mode
-    if (displayMode != 0 && newMeasurementTaken)
+    if (modeRedrawAt == 0 && displayMode != 0 && newMeasurementTaken)
     {
         switch (displayMode)
         {
@@ -880,5 +1779,8 @@ void loop()
         newMeasurementTaken = false; // Reset the flag after displaying
     }
 
-    delay(10);
+    // Log output goes out as the UART has room for it
+    traceLog.drain(Serial);
+
+    delay(1); // Yield without stalling the capture or the server
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "Arduino.h"
+
+#define HOST_MAX_LISTENERS 4
+
+static uint64_t nowUs = 0;
+static uint64_t blockedUs = 0;
+
+static HostAdvanceFn listeners[HOST_MAX_LISTENERS];
+static void *listenerArgs[HOST_MAX_LISTENERS];
+static int listenerCount = 0;
+
+struct HostPin
+{
+    uint8_t mode;
+    int level;
+    void (*isr)(void *);
+    void *isrArg;
+    int isrMode;
+    HostPinFn listener;
+    void *listenerArg;
+};
+
+static HostPin pins[HOST_PIN_COUNT];
+
+uint64_t hostMicros()
+{
+    return nowUs;
+}
+
+void hostAdvanceMicros(uint64_t us)
+{
+    nowUs += us;
+    for (int i = 0; i < listenerCount; i++)
+    {
+        listeners[i](listenerArgs[i]);
+    }
+}
+
+void hostOnAdvance(HostAdvanceFn fn, void *arg)
+{
+    if (listenerCount < HOST_MAX_LISTENERS)
+    {
+        listeners[listenerCount] = fn;
+        listenerArgs[listenerCount] = arg;
+        listenerCount++;
+    }
+}
+
+uint64_t hostBlockedMicros()
+{
+    return blockedUs;
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(nowUs / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)nowUs;
+}
+
+void delay(unsigned long ms)
+{
+    blockedUs += (uint64_t)ms * 1000;
+    hostAdvanceMicros((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    blockedUs += us;
+    hostAdvanceMicros(us);
+}
+
+void yield()
+{
+}
+
+// GPIO
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin >= HOST_PIN_COUNT)
+    {
+        return;
+    }
+    pins[pin].mode = mode;
+    if (mode == INPUT_PULLUP)
+    {
+        pins[pin].level = HIGH;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pin < HOST_PIN_COUNT ? pins[pin].level : LOW;
+}
+
+void hostDrivePin(uint8_t pin, int level)
+{
+    if (pin >= HOST_PIN_COUNT)
+    {
+        return;
+    }
+    HostPin &p = pins[pin];
+    int old = p.level;
+    p.level = level ? HIGH : LOW;
+    if (old == p.level)
+    {
+        return;
+    }
+    if (p.listener != NULL)
+    {
+        p.listener(p.listenerArg, p.level);
+    }
+    if (p.isr == NULL)
+    {
+        return;
+    }
+    bool rising = p.level == HIGH;
+    if (p.isrMode == CHANGE || (rising && p.isrMode == RISING) || (!rising && p.isrMode == FALLING))
+    {
+        p.isr(p.isrArg);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    hostDrivePin(pin, value);
+}
+
+void hostOnPinChange(uint8_t pin, HostPinFn fn, void *arg)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        pins[pin].listener = fn;
+        pins[pin].listenerArg = arg;
+    }
+}
+
+void attachInterruptArg(uint8_t pin, void (*fn)(void *), void *arg, int mode)
+{
+    if (pin >= HOST_PIN_COUNT)
+    {
+        return;
+    }
+    pins[pin].isr = fn;
+    pins[pin].isrArg = arg;
+    pins[pin].isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        pins[pin].isr = NULL;
+    }
+}
+
+// Serial
+
+HardwareSerial Serial;
+
+HardwareSerial::HardwareSerial()
+{
+    _echo = false;
+    _bytes = 0;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+    (void)baud;
+}
+
+void HardwareSerial::setEcho(bool echo)
+{
+    _echo = echo;
+}
+
+size_t HardwareSerial::bytesWritten()
+{
+    return _bytes;
+}
+
+int HardwareSerial::availableForWrite()
+{
+    return HOST_SERIAL_TX_BUFFER;
+}
+
+size_t HardwareSerial::write(const char *str)
+{
+    size_t n = strlen(str);
+    if (_echo)
+    {
+        fwrite(str, 1, n, stdout);
+    }
+    _bytes += n;
+    return n;
+}
+
+size_t HardwareSerial::print(const char *str)
+{
+    return write(str);
+}
+
+size_t HardwareSerial::print(char c)
+{
+    char buf[2] = {c, 0};
+    return write(buf);
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return print((long)value);
+}
+
+size_t HardwareSerial::print(unsigned int value)
+{
+    return print((unsigned long)value);
+}
+
+size_t HardwareSerial::print(long value)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", value);
+    return write(buf);
+}
+
+size_t HardwareSerial::print(unsigned long value)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%lu", value);
+    return write(buf);
+}
+
+size_t HardwareSerial::print(double value, int digits)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+}
+
+size_t HardwareSerial::println()
+{
+    return write("\r\n");
+}
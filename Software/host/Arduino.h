@@ -0,0 +1,95 @@
+// Minimal Arduino core for building the sketch modules on a Linux host.
+// Time is virtual: delay() and I2C transfers advance a simulated clock so
+// that benchmark runs are deterministic and independent of the host CPU.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PROGMEM
+#define IRAM_ATTR
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define HOST_PIN_COUNT 40
+#define HOST_SERIAL_TX_BUFFER 128 // ESP32 UART transmit FIFO
+
+typedef uint8_t byte;
+
+// Virtual clock
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Host-side clock control and accounting
+uint64_t hostMicros();
+void hostAdvanceMicros(uint64_t us);
+uint64_t hostBlockedMicros(); // Time spent inside delay()/delayMicroseconds()
+
+// Simulated peripherals register here to follow the virtual clock
+typedef void (*HostAdvanceFn)(void *arg);
+void hostOnAdvance(HostAdvanceFn fn, void *arg);
+
+// GPIO and pin interrupts
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+#define digitalPinToInterrupt(p) (p)
+void attachInterruptArg(uint8_t pin, void (*fn)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+// Drives a pin from outside the MCU (e.g. a simulated INT line)
+void hostDrivePin(uint8_t pin, int level);
+
+// Simulated devices wired to a pin are told about every level change
+typedef void (*HostPinFn)(void *arg, int level);
+void hostOnPinChange(uint8_t pin, HostPinFn fn, void *arg);
+
+// Serial stand-in: output is counted and optionally echoed to stdout
+class HardwareSerial
+{
+public:
+    HardwareSerial();
+    void begin(unsigned long baud);
+    void setEcho(bool echo);
+    size_t bytesWritten();
+    int availableForWrite(); // Always the full FIFO: host output never blocks
+
+    size_t write(const char *str);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+    size_t println();
+    template <typename T>
+    size_t println(T value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+
+private:
+    bool _echo;
+    size_t _bytes;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,132 @@
+#include "Preferences.h"
+
+struct NvsEntry
+{
+    bool used;
+    char space[HOST_NVS_KEY_LENGTH];
+    char key[HOST_NVS_KEY_LENGTH];
+    uint8_t value[HOST_NVS_MAX_VALUE];
+    size_t length;
+};
+
+static NvsEntry nvs[HOST_NVS_MAX_ENTRIES];
+
+NvsStats Preferences::stats = {0, 0};
+
+Preferences::Preferences()
+{
+    _namespace[0] = '\0';
+    _open = false;
+    _readOnly = false;
+}
+
+bool Preferences::begin(const char *name, bool readOnly)
+{
+    if (strlen(name) >= HOST_NVS_KEY_LENGTH)
+    {
+        return false;
+    }
+    strcpy(_namespace, name);
+    _open = true;
+    _readOnly = readOnly;
+    return true;
+}
+
+void Preferences::end()
+{
+    _open = false;
+}
+
+int Preferences::find(const char *key)
+{
+    for (int i = 0; i < HOST_NVS_MAX_ENTRIES; i++)
+    {
+        if (nvs[i].used && strcmp(nvs[i].space, _namespace) == 0 && strcmp(nvs[i].key, key) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t length)
+{
+    if (!_open || _readOnly || strlen(key) >= HOST_NVS_KEY_LENGTH || length > HOST_NVS_MAX_VALUE)
+    {
+        return 0;
+    }
+    int index = find(key);
+    for (int i = 0; index < 0 && i < HOST_NVS_MAX_ENTRIES; i++)
+    {
+        if (!nvs[i].used)
+        {
+            index = i;
+            nvs[i].used = true;
+            strcpy(nvs[i].space, _namespace);
+            strcpy(nvs[i].key, key);
+        }
+    }
+    if (index < 0)
+    {
+        return 0;
+    }
+    memcpy(nvs[index].value, value, length);
+    nvs[index].length = length;
+    stats.writes++;
+    stats.bytesWritten += length;
+    return length;
+}
+
+size_t Preferences::getBytes(const char *key, void *buffer, size_t maxLength)
+{
+    int index = _open ? find(key) : -1;
+    if (index < 0 || nvs[index].length > maxLength)
+    {
+        return 0;
+    }
+    memcpy(buffer, nvs[index].value, nvs[index].length);
+    return nvs[index].length;
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    int index = _open ? find(key) : -1;
+    return index < 0 ? 0 : nvs[index].length;
+}
+
+bool Preferences::isKey(const char *key)
+{
+    return _open && find(key) >= 0;
+}
+
+bool Preferences::remove(const char *key)
+{
+    int index = _open && !_readOnly ? find(key) : -1;
+    if (index < 0)
+    {
+        return false;
+    }
+    nvs[index].used = false;
+    return true;
+}
+
+bool Preferences::clear()
+{
+    if (!_open || _readOnly)
+    {
+        return false;
+    }
+    for (int i = 0; i < HOST_NVS_MAX_ENTRIES; i++)
+    {
+        if (nvs[i].used && strcmp(nvs[i].space, _namespace) == 0)
+        {
+            nvs[i].used = false;
+        }
+    }
+    return true;
+}
+
+void Preferences::hostErase()
+{
+    memset(nvs, 0, sizeof(nvs));
+}
@@ -0,0 +1,45 @@
+// Host Preferences: the ESP32 NVS key/value store kept in memory. Values
+// outlive the Preferences object, so a module can be "rebooted" by
+// constructing it again; writes are counted to keep an eye on flash wear.
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+#define HOST_NVS_MAX_ENTRIES 32
+#define HOST_NVS_KEY_LENGTH 16 // NVS limit including the terminator
+#define HOST_NVS_MAX_VALUE 64
+
+struct NvsStats
+{
+    uint32_t writes;
+    uint32_t bytesWritten;
+};
+
+class Preferences
+{
+public:
+    Preferences();
+
+    bool begin(const char *name, bool readOnly = false);
+    void end();
+
+    size_t putBytes(const char *key, const void *value, size_t length);
+    size_t getBytes(const char *key, void *buffer, size_t maxLength);
+    size_t getBytesLength(const char *key);
+    bool isKey(const char *key);
+    bool remove(const char *key);
+    bool clear();
+
+    static NvsStats stats;
+    static void hostErase(); // Wipe the whole store
+
+private:
+    char _namespace[HOST_NVS_KEY_LENGTH];
+    bool _open;
+    bool _readOnly;
+
+    int find(const char *key);
+};
+
+#endif
@@ -0,0 +1,854 @@
+#include "SimAS7341.h"
+
+// Register addresses the model gives special treatment. Kept local so the
+// model does not depend on the driver header it is meant to check.
+#define REG_CONFIG 0x70
+#define REG_STAT 0x71
+#define REG_ITIME_L 0x63
+#define REG_EDGE 0x72
+#define REG_GPIO 0x73
+#define REG_LED 0x74
+#define REG_ENABLE 0x80
+#define REG_ATIME 0x81
+#define REG_WTIME 0x83
+#define REG_SP_TH_L 0x84
+#define REG_SP_TH_H 0x86
+#define REG_AUXID 0x90
+#define REG_REVID 0x91
+#define REG_ID 0x92
+#define REG_STATUS 0x93
+#define REG_ASTATUS 0x94
+#define REG_CH0_DATA_L 0x95
+#define REG_CH5_DATA_H 0xA0
+#define REG_STATUS_2 0xA3
+#define REG_STATUS_6 0xA7
+#define REG_CFG_0 0xA9
+#define REG_CFG_1 0xAA
+#define REG_CFG_6 0xAF
+#define REG_CFG_8 0xB1
+#define REG_CFG_12 0xB5
+#define REG_PERS 0xBD
+#define REG_GPIO_2 0xBE
+#define REG_ASTEP_L 0xCA
+#define REG_ASTEP_H 0xCB
+#define REG_FD_CFG0 0xD7
+#define REG_FD_TIME_1 0xD8
+#define REG_FD_TIME_2 0xDA
+#define REG_FD_STATUS 0xDB
+#define REG_INTENAB 0xF9
+#define REG_CONTROL 0xFA
+#define REG_FIFO_MAP 0xFC
+#define REG_FIFO_LVL 0xFD
+#define REG_FDATA_L 0xFE
+#define REG_FDATA_H 0xFF
+
+#define ENABLE_PON 0x01
+#define ENABLE_SP_EN 0x02
+#define ENABLE_WEN 0x08
+#define ENABLE_SMUXEN 0x10
+#define ENABLE_FDEN 0x40
+
+#define MODE_SPM 0x00
+#define MODE_SYNS 0x01
+#define MODE_SYND 0x03
+#define GPIO_2_IN_EN 0x04
+
+#define SMUX_EXECUTION_US 20     // SMUX command execution time
+#define FD_WINDOW_SAMPLES 512    // Samples per flicker measurement
+#define FD_CALC_SAMPLES 64       // Samples until the 100/120 Hz decision
+
+// Pixel-to-photodiode map of the SMUX (two pixels per SMUX RAM byte)
+static const uint8_t PIXEL_DIODE[40] = {
+    SIM_NONE, SIM_F3, SIM_F1, SIM_NONE, SIM_NONE, SIM_NONE, SIM_NONE, SIM_F8,
+    SIM_F6, SIM_NONE, SIM_F2, SIM_F4, SIM_NONE, SIM_F5, SIM_F7, SIM_NONE,
+    SIM_NONE, SIM_CLEAR, SIM_NONE, SIM_F5, SIM_F7, SIM_NONE, SIM_NONE, SIM_NONE,
+    SIM_NONE, SIM_F2, SIM_F4, SIM_NONE, SIM_F8, SIM_F6, SIM_NONE, SIM_F3,
+    SIM_F1, SIM_NONE, SIM_NONE, SIM_CLEAR, SIM_NONE, SIM_NONE, SIM_NIR, SIM_FLICKER};
+
+// Pixels per photodiode type, used to split a filter's light across them
+static const uint8_t DIODE_PIXELS[SIM_DIODE_COUNT] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1};
+
+// ROM default SMUX configuration: F1-F4, Clear, NIR
+static const uint8_t SMUX_ROM[20] = {0x30, 0x01, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x50, 0x00,
+                                     0x00, 0x00, 0x20, 0x04, 0x00, 0x30, 0x01, 0x50, 0x00, 0x06};
+
+SimAS7341::SimAS7341()
+{
+    _scene = defaultScene();
+    _intPin = -1;
+    _syncPin = -1;
+    _gpioLevel = HIGH;
+    reset();
+    hostOnAdvance(onAdvance, this);
+}
+
+SimScene SimAS7341::defaultScene()
+{
+    // Warm white LED lamp at a few hundred lux
+    SimScene scene;
+    static const float rate[SIM_DIODE_COUNT] = {2.0f, 5.0f, 8.0f, 9.0f, 11.0f, 12.0f, 10.0f, 7.0f, 30.0f, 3.0f, 30.0f};
+    static const float led[SIM_DIODE_COUNT] = {0.01f, 0.02f, 0.04f, 0.05f, 0.06f, 0.05f, 0.04f, 0.03f, 0.15f, 0.01f, 0.15f};
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        scene.rate[i] = rate[i];
+        scene.ledRatePerMa[i] = led[i];
+    }
+    scene.darkRate = 0.05f;
+    scene.flickerHz = 0.0f;
+    scene.flickerDepth = 0.0f;
+    scene.flickerDuty = 0.0f;
+    scene.noise = 0.0f;
+    return scene;
+}
+
+void SimAS7341::reset()
+{
+    memset(_regs, 0, sizeof(_regs));
+    _regs[REG_ATIME] = 0x00;
+    _regs[REG_ASTEP_L] = 0xE7; // ASTEP 999
+    _regs[REG_ASTEP_H] = 0x03;
+    _regs[REG_CFG_1] = 0x09;   // 256x
+    _regs[REG_CONFIG] = 0x00;
+    _regs[REG_FD_TIME_1] = 0x68;
+    _regs[REG_FD_TIME_2] = 0x48;
+    memset(_smuxRam, 0, sizeof(_smuxRam));
+    memset(_smuxRoute, SIM_NONE, sizeof(_smuxRoute));
+    _pointer = 0;
+    _now = hostMicros();
+
+    _spState = SP_IDLE;
+    _spStart = 0;
+    _spEventAt = 0;
+    _cycleSteps = 1;
+    _cycleGainCode = 0;
+    memset(_result, 0, sizeof(_result));
+    memset(_latched, 0, sizeof(_latched));
+    _resultStatus = 0;
+    _latchedStatus = 0;
+    _avalid = false;
+    _asatDigital = false;
+    _asatAnalog = false;
+
+    _smuxBusy = false;
+    _smuxDoneAt = 0;
+
+    _fdRunning = false;
+    _fdStart = 0;
+    _fdNextSample = 0;
+    _fdCount = 0;
+    _fifoHead = 0;
+    _fifoCount = 0;
+    _fifoOverflow = false;
+    _fdataHigh = 0;
+
+    _intAsserted = false;
+    _edgesLeft = 0;
+
+    _rng = 12345;
+    _errorCount = 0;
+    smuxCommands = 0;
+    spectralCycles = 0;
+    fdSamples = 0;
+    interruptsRaised = 0;
+    syncEdges = 0;
+    lastSyncStart = 0;
+}
+
+SimScene &SimAS7341::scene()
+{
+    return _scene;
+}
+
+uint8_t SimAS7341::address()
+{
+    return 0x39;
+}
+
+uint32_t SimAS7341::protocolErrors()
+{
+    return _errorCount;
+}
+
+const char *SimAS7341::protocolError(uint8_t index)
+{
+    if (index >= _errorCount || index >= SIM_AS7341_MAX_ERRORS)
+    {
+        return "";
+    }
+    return _errors[index];
+}
+
+void SimAS7341::onAdvance(void *arg)
+{
+    ((SimAS7341 *)arg)->update();
+}
+
+void SimAS7341::connectInterrupt(uint8_t pin)
+{
+    _intPin = pin;
+    _intAsserted = false;
+    hostDrivePin(pin, HIGH);
+    updateInterrupt();
+}
+
+void SimAS7341::connectSync(uint8_t pin)
+{
+    _syncPin = pin;
+    _gpioLevel = digitalRead(pin);
+    hostOnPinChange(pin, onSyncPin, this);
+}
+
+void SimAS7341::onSyncPin(void *arg, int level)
+{
+    SimAS7341 *sim = (SimAS7341 *)arg;
+    sim->update();
+    bool falling = sim->_gpioLevel == HIGH && level == LOW;
+    sim->_gpioLevel = level;
+    if (falling)
+    {
+        sim->syncEdge();
+        sim->updateInterrupt();
+    }
+}
+
+uint8_t SimAS7341::syncMode()
+{
+    return _regs[REG_CONFIG] & 0x03;
+}
+
+void SimAS7341::syncEdge()
+{
+    if (!(_regs[REG_GPIO_2] & GPIO_2_IN_EN) || (_regs[REG_GPIO] & 0x02))
+    {
+        return; // Input buffer disabled or GPIO powered down
+    }
+    syncEdges++;
+    if (_spState == SP_WAIT_SYNC)
+    {
+        startIntegration();
+        lastSyncStart = _now;
+        if (syncMode() == MODE_SYND)
+        {
+            // Runs until the EDGE-th following falling edge
+            _edgesLeft = _regs[REG_EDGE] > 0 ? _regs[REG_EDGE] : 1;
+            _spEventAt = UINT64_MAX;
+        }
+    }
+    else if (_spState == SP_INTEGRATING && syncMode() == MODE_SYND && --_edgesLeft == 0)
+    {
+        uint32_t itime = (uint32_t)((_now - _spStart) / 2.78);
+        _regs[REG_ITIME_L] = itime & 0xFF;
+        _regs[REG_ITIME_L + 1] = (itime >> 8) & 0xFF;
+        _regs[REG_ITIME_L + 2] = (itime >> 16) & 0xFF;
+        finishIntegration();
+    }
+}
+
+void SimAS7341::updateInterrupt()
+{
+    // INT is asserted (low) while any enabled interrupt source is pending
+    bool asserted = (_regs[REG_STATUS] & _regs[REG_INTENAB] & 0x8D) != 0;
+    if (asserted == _intAsserted)
+    {
+        return;
+    }
+    _intAsserted = asserted;
+    if (asserted)
+    {
+        interruptsRaised++;
+    }
+    if (_intPin >= 0)
+    {
+        hostDrivePin(_intPin, asserted ? LOW : HIGH);
+    }
+}
+
+void SimAS7341::error(const char *message)
+{
+    if (_errorCount < SIM_AS7341_MAX_ERRORS)
+    {
+        snprintf(_errors[_errorCount], sizeof(_errors[0]), "%s", message);
+    }
+    _errorCount++;
+}
+
+// I2C
+
+void SimAS7341::i2cWrite(const uint8_t *data, size_t length)
+{
+    update();
+    _pointer = data[0];
+    for (size_t i = 1; i < length; i++)
+    {
+        writeReg(_pointer++, data[i]);
+    }
+    updateInterrupt();
+}
+
+void SimAS7341::i2cRead(uint8_t *data, size_t length)
+{
+    update();
+    for (size_t i = 0; i < length; i++)
+    {
+        data[i] = readReg(_pointer, i == 0);
+        // Burst reads of FDATA stay inside the FIFO window
+        _pointer = (_pointer == REG_FDATA_H) ? REG_FDATA_L : _pointer + 1;
+    }
+}
+
+bool SimAS7341::bankOk(uint8_t reg)
+{
+    bool bank1 = (_regs[REG_CFG_0] & 0x10) != 0;
+    if (reg >= 0x60 && reg <= 0x74 && !bank1)
+    {
+        error("bank 1 register accessed with REG_BANK=0");
+        return false;
+    }
+    return true;
+}
+
+uint8_t SimAS7341::readReg(uint8_t reg, bool first)
+{
+    if (!bankOk(reg))
+    {
+        return 0;
+    }
+
+    switch (reg)
+    {
+    case REG_AUXID:
+    case REG_REVID:
+        return 0x00;
+    case REG_ID:
+        return 0x24;
+    case REG_STAT:
+        return ((_regs[REG_ENABLE] & ENABLE_PON) ? 0x01 : 0x00) | (_spState == SP_WAIT_SYNC ? 0x02 : 0x00);
+    case REG_GPIO_2:
+        return (_regs[REG_GPIO_2] & ~0x01) | ((_regs[REG_GPIO_2] & GPIO_2_IN_EN) && _gpioLevel ? 0x01 : 0x00);
+    case REG_ENABLE:
+        return _regs[REG_ENABLE] | (_smuxBusy ? ENABLE_SMUXEN : 0);
+    case REG_ASTATUS:
+        // Reading ASTATUS latches all channel data
+        memcpy(_latched, _result, sizeof(_latched));
+        _latchedStatus = _resultStatus;
+        _avalid = false;
+        return _latchedStatus;
+    case REG_STATUS_2:
+        return (_avalid ? 0x40 : 0) | (_asatDigital ? 0x10 : 0) | (_asatAnalog ? 0x08 : 0);
+    case REG_STATUS_6:
+        return _fifoOverflow ? 0x80 : 0x00;
+    case REG_FIFO_LVL:
+        return _fifoCount;
+    case REG_FDATA_L:
+    {
+        uint16_t value = fifoPop();
+        _fdataHigh = value >> 8;
+        return value & 0xFF;
+    }
+    case REG_FDATA_H:
+        return _fdataHigh;
+    default:
+        break;
+    }
+
+    if (reg >= REG_CH0_DATA_L && reg <= REG_CH5_DATA_H)
+    {
+        if (first && reg == REG_CH0_DATA_L)
+        {
+            memcpy(_latched, _result, sizeof(_latched));
+            _latchedStatus = _resultStatus;
+            _avalid = false;
+        }
+        uint8_t offset = reg - REG_CH0_DATA_L;
+        uint16_t value = _latched[offset / 2];
+        return (offset & 1) ? (value >> 8) : (value & 0xFF);
+    }
+
+    return _regs[reg];
+}
+
+void SimAS7341::writeReg(uint8_t reg, uint8_t value)
+{
+    if (!bankOk(reg))
+    {
+        return;
+    }
+
+    if (reg < sizeof(_smuxRam))
+    {
+        if (_smuxBusy)
+        {
+            error("SMUX RAM written while a SMUX command is running");
+        }
+        _smuxRam[reg] = value;
+        return;
+    }
+
+    switch (reg)
+    {
+    case REG_ENABLE:
+        writeEnable(value);
+        return;
+    case REG_STATUS:
+        _regs[REG_STATUS] &= ~value; // Write 1 to clear
+        return;
+    case REG_FD_STATUS:
+        _regs[REG_FD_STATUS] &= ~(value & 0x3C);
+        return;
+    case REG_CONTROL:
+        if (value & 0x02)
+        {
+            _fifoCount = 0;
+            _fifoHead = 0;
+            _fifoOverflow = false;
+        }
+        return;
+    case REG_AUXID:
+    case REG_REVID:
+    case REG_ID:
+    case REG_ASTATUS:
+    case REG_STATUS_2:
+    case REG_STATUS_6:
+    case REG_FIFO_LVL:
+    case REG_FDATA_L:
+    case REG_FDATA_H:
+        return; // Read-only
+    default:
+        break;
+    }
+
+    if (reg >= REG_CH0_DATA_L && reg <= REG_CH5_DATA_H)
+    {
+        return; // Read-only
+    }
+
+    _regs[reg] = value;
+}
+
+void SimAS7341::writeEnable(uint8_t value)
+{
+    uint8_t old = _regs[REG_ENABLE];
+    _regs[REG_ENABLE] = value & ~ENABLE_SMUXEN;
+
+    bool pon = value & ENABLE_PON;
+    bool spEn = pon && (value & ENABLE_SP_EN);
+    bool fdEn = pon && (value & ENABLE_FDEN);
+
+    if (value & ENABLE_SMUXEN)
+    {
+        if (!pon)
+        {
+            error("SMUX command while powered down");
+        }
+        else if (spEn)
+        {
+            error("SMUX command while SP_EN is set");
+        }
+        else if (_smuxBusy)
+        {
+            error("SMUX command while previous command is running");
+        }
+        else
+        {
+            _smuxBusy = true;
+            _smuxDoneAt = _now + SMUX_EXECUTION_US;
+            smuxCommands++;
+        }
+    }
+
+    bool wasSpEn = (old & ENABLE_PON) && (old & ENABLE_SP_EN);
+    if (spEn && !wasSpEn)
+    {
+        if (_smuxBusy)
+        {
+            error("SP_EN set while a SMUX command is running");
+        }
+        _avalid = false;
+        if (syncMode() != MODE_SPM)
+        {
+            if (!(_regs[REG_GPIO_2] & GPIO_2_IN_EN))
+            {
+                error("sync mode armed without the GPIO input enabled");
+            }
+            _spState = SP_WAIT_SYNC;
+            _spEventAt = UINT64_MAX;
+        }
+        else
+        {
+            startIntegration();
+        }
+    }
+    else if (!spEn)
+    {
+        _spState = SP_IDLE;
+    }
+
+    bool wasFdEn = (old & ENABLE_PON) && (old & ENABLE_FDEN);
+    if (fdEn && !wasFdEn)
+    {
+        _fdRunning = true;
+        _fdStart = _now;
+        _fdCount = 0;
+        uint16_t fdTime = _regs[REG_FD_TIME_1] | ((_regs[REG_FD_TIME_2] & 0x07) << 8);
+        _fdNextSample = _now + (uint64_t)((fdTime + 1) * 1.388);
+        _regs[REG_FD_STATUS] &= ~0x3F;
+    }
+    else if (!fdEn)
+    {
+        _fdRunning = false;
+    }
+}
+
+void SimAS7341::executeSmux()
+{
+    _smuxBusy = false;
+    uint8_t command = (_regs[REG_CFG_6] >> 3) & 0x03;
+    const uint8_t *source = NULL;
+    if (command == 0)
+    {
+        source = SMUX_ROM;
+    }
+    else if (command == 2)
+    {
+        source = _smuxRam;
+    }
+    else if (command == 1)
+    {
+        // Read back the active configuration into RAM
+        for (int i = 0; i < 20; i++)
+        {
+            uint8_t low = _smuxRoute[2 * i] == SIM_NONE ? 0 : _smuxRoute[2 * i] + 1;
+            uint8_t high = _smuxRoute[2 * i + 1] == SIM_NONE ? 0 : _smuxRoute[2 * i + 1] + 1;
+            _smuxRam[i] = low | (high << 4);
+        }
+        return;
+    }
+    else
+    {
+        error("reserved SMUX command");
+        return;
+    }
+
+    for (int i = 0; i < 20; i++)
+    {
+        uint8_t low = source[i] & 0x0F;
+        uint8_t high = source[i] >> 4;
+        _smuxRoute[2 * i] = (low >= 1 && low <= 6) ? low - 1 : SIM_NONE;
+        _smuxRoute[2 * i + 1] = (high >= 1 && high <= 6) ? high - 1 : SIM_NONE;
+    }
+}
+
+// Time model
+
+uint64_t SimAS7341::integrationMicros()
+{
+    uint32_t astep = _regs[REG_ASTEP_L] | (_regs[REG_ASTEP_H] << 8);
+    uint32_t atime = _regs[REG_ATIME];
+    return (uint64_t)((atime + 1) * (astep + 1) * 2.78);
+}
+
+uint64_t SimAS7341::waitMicros()
+{
+    uint64_t us = (uint64_t)((_regs[REG_WTIME] + 1) * 2780.0);
+    if (_regs[REG_CFG_0] & 0x04)
+    {
+        us *= 16; // WLONG
+    }
+    return us;
+}
+
+float SimAS7341::gainFactor(uint8_t code)
+{
+    if (code > 10)
+    {
+        code = 10;
+    }
+    return code == 0 ? 0.5f : (float)(1 << (code - 1));
+}
+
+double SimAS7341::exposure(int diode, uint64_t t0, uint64_t t1)
+{
+    // Light integrated over [t0, t1] in counts at 1x gain
+    double ms = (t1 - t0) / 1000.0;
+    double ambient = _scene.rate[diode] * ms;
+    if (_scene.flickerHz > 0.0f && _scene.flickerDepth > 0.0f && _scene.flickerDuty > 0.0f)
+    {
+        // Light lost while the PWM is off
+        double offMs = ms - (pwmOnTime(t1) - pwmOnTime(t0)) / 1000.0;
+        ambient -= _scene.rate[diode] * _scene.flickerDepth * offMs;
+    }
+    else if (_scene.flickerHz > 0.0f && _scene.flickerDepth > 0.0f)
+    {
+        double w = 2.0 * M_PI * _scene.flickerHz / 1e6;
+        ambient += _scene.rate[diode] * _scene.flickerDepth *
+                   (cos(w * t0) - cos(w * t1)) / w / 1000.0;
+    }
+    bool ledOn = (_regs[REG_CONFIG] & 0x08) && (_regs[REG_LED] & 0x80);
+    if (ledOn)
+    {
+        float ma = 4 + 2 * (_regs[REG_LED] & 0x7F);
+        ambient += _scene.ledRatePerMa[diode] * ma * ms;
+    }
+    return ambient + _scene.darkRate * ms / DIODE_PIXELS[diode];
+}
+
+double SimAS7341::pwmOnTime(uint64_t t)
+{
+    // Time the PWM has been on in [0, t], in us
+    double period = 1e6 / _scene.flickerHz;
+    double on = period * _scene.flickerDuty;
+    double cycles = floor(t / period);
+    double phase = t - cycles * period;
+    return cycles * on + (phase < on ? phase : on);
+}
+
+float SimAS7341::noise(double counts)
+{
+    if (_scene.noise <= 0.0f || counts <= 0.0)
+    {
+        return 0.0f;
+    }
+    // Sum of uniforms approximates a unit normal
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++)
+    {
+        _rng = _rng * 1103515245u + 12345u;
+        sum += ((_rng >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+    }
+    return sum * 1.732f * _scene.noise * sqrtf((float)counts);
+}
+
+void SimAS7341::update()
+{
+    uint64_t target = hostMicros();
+    while (true)
+    {
+        uint64_t next = UINT64_MAX;
+        if (_smuxBusy && _smuxDoneAt < next)
+        {
+            next = _smuxDoneAt;
+        }
+        if (_spState != SP_IDLE && _spEventAt < next)
+        {
+            next = _spEventAt;
+        }
+        if (_fdRunning && _fdNextSample < next)
+        {
+            next = _fdNextSample;
+        }
+        if (next > target)
+        {
+            break;
+        }
+
+        _now = next;
+        if (_smuxBusy && _smuxDoneAt == next)
+        {
+            executeSmux();
+        }
+        else if (_spState != SP_IDLE && _spEventAt == next)
+        {
+            if (_spState == SP_INTEGRATING)
+            {
+                finishIntegration();
+            }
+            else
+            {
+                startIntegration();
+            }
+        }
+        else
+        {
+            fdSample();
+        }
+        updateInterrupt();
+    }
+    _now = target;
+}
+
+void SimAS7341::startIntegration()
+{
+    // Settings are sampled when a cycle starts; later writes apply to the next one
+    _cycleSteps = (uint32_t)(_regs[REG_ATIME] + 1) * ((_regs[REG_ASTEP_L] | (_regs[REG_ASTEP_H] << 8)) + 1);
+    _cycleGainCode = _regs[REG_CFG_1] & 0x1F;
+    _spState = SP_INTEGRATING;
+    _spStart = _now;
+    _spEventAt = _now + integrationMicros();
+}
+
+void SimAS7341::finishIntegration()
+{
+    // In SYND the edges, not ATIME, set the integration length
+    uint32_t fullScale = (_cycleSteps > 65535 || syncMode() == MODE_SYND) ? 65535 : _cycleSteps;
+    uint8_t gainCode = _cycleGainCode;
+    float gain = gainFactor(gainCode);
+
+    double counts[6] = {0, 0, 0, 0, 0, 0};
+    for (int pixel = 0; pixel < 40; pixel++)
+    {
+        uint8_t adc = _smuxRoute[pixel];
+        uint8_t diode = PIXEL_DIODE[pixel];
+        if (adc == SIM_NONE || diode == SIM_NONE)
+        {
+            continue;
+        }
+        counts[adc] += exposure(diode, _spStart, _now) / DIODE_PIXELS[diode];
+    }
+
+    bool saturated = false;
+    for (int i = 0; i < 6; i++)
+    {
+        double value = counts[i] * gain;
+        value += noise(value);
+        if (value < 0)
+        {
+            value = 0;
+        }
+        if (value >= fullScale)
+        {
+            value = fullScale;
+            saturated = true;
+        }
+        _result[i] = (uint16_t)value;
+    }
+
+    _resultStatus = (saturated ? 0x80 : 0x00) | (gainCode & 0x0F);
+    _asatDigital = saturated;
+    _avalid = true;
+    spectralCycles++;
+
+    // Spectral interrupt: thresholds on the selected channel with persistence
+    uint8_t channel = _regs[REG_CFG_12] & 0x07;
+    uint16_t low = _regs[REG_SP_TH_L] | (_regs[REG_SP_TH_L + 1] << 8);
+    uint16_t high = _regs[REG_SP_TH_H] | (_regs[REG_SP_TH_H + 1] << 8);
+    uint16_t value = _result[channel < 6 ? channel : 0];
+    uint8_t pers = _regs[REG_PERS] & 0x0F;
+    if (pers == 0 || value < low || value > high)
+    {
+        _regs[REG_STATUS] |= 0x08; // AINT
+    }
+    if (saturated)
+    {
+        _regs[REG_STATUS] |= 0x80; // ASAT
+    }
+
+    // Spectral results mapped into the FIFO
+    uint8_t map = _regs[REG_FIFO_MAP];
+    if (map & 0x01)
+    {
+        fifoPush(_resultStatus);
+    }
+    for (int i = 0; i < 6; i++)
+    {
+        if (map & (0x02 << i))
+        {
+            fifoPush(_result[i]);
+        }
+    }
+
+    if (syncMode() != MODE_SPM)
+    {
+        _spState = SP_WAIT_SYNC; // Re-arms for the next sync edge
+        _spEventAt = UINT64_MAX;
+    }
+    else if (_regs[REG_ENABLE] & ENABLE_WEN)
+    {
+        _spState = SP_WAITING;
+        _spEventAt = _now + waitMicros();
+    }
+    else
+    {
+        startIntegration();
+    }
+}
+
+// Flicker detection
+
+void SimAS7341::fdSample()
+{
+    uint16_t fdTime = _regs[REG_FD_TIME_1] | ((_regs[REG_FD_TIME_2] & 0x07) << 8);
+    uint64_t period = (uint64_t)((fdTime + 1) * 1.388);
+    if (period == 0)
+    {
+        period = 1;
+    }
+    float gain = gainFactor(_regs[REG_FD_TIME_2] >> 3);
+
+    // The FD engine only sees light when the flicker pixel is routed
+    double value = 0.0;
+    if (_smuxRoute[39] != SIM_NONE)
+    {
+        value = exposure(SIM_FLICKER, _now - period, _now) * gain;
+        value += noise(value);
+    }
+    bool saturated = value >= 65535.0;
+    uint16_t sample = saturated ? 65535 : (value < 0 ? 0 : (uint16_t)value);
+    fdSamples++;
+    _fdCount++;
+
+    if (_regs[REG_FD_CFG0] & 0x80)
+    {
+        fifoPush(sample);
+    }
+    if (saturated)
+    {
+        _regs[REG_FD_STATUS] |= 0x10;
+    }
+
+    if (_fdCount == FD_WINDOW_SAMPLES)
+    {
+        _regs[REG_FD_STATUS] |= 0x20; // FD_MEAS_VALID
+    }
+    else if (_fdCount == FD_WINDOW_SAMPLES + FD_CALC_SAMPLES)
+    {
+        fdFinish();
+    }
+    _fdNextSample = _now + period;
+}
+
+void SimAS7341::fdFinish()
+{
+    uint8_t status = _regs[REG_FD_STATUS] | 0x0C; // Both decisions valid
+    bool routed = _smuxRoute[39] != SIM_NONE;
+    bool modulated = routed && _scene.flickerDepth > 0.05f;
+    if (modulated && fabsf(_scene.flickerHz - 100.0f) < 5.0f)
+    {
+        status |= 0x01;
+    }
+    if (modulated && fabsf(_scene.flickerHz - 120.0f) < 6.0f)
+    {
+        status |= 0x02;
+    }
+    _regs[REG_FD_STATUS] = status;
+}
+
+// FIFO
+
+void SimAS7341::fifoPush(uint16_t value)
+{
+    if (_fifoCount >= SIM_AS7341_FIFO_SIZE)
+    {
+        _fifoOverflow = true;
+        return;
+    }
+    _fifo[(_fifoHead + _fifoCount) % SIM_AS7341_FIFO_SIZE] = value;
+    _fifoCount++;
+
+    static const uint8_t thresholds[4] = {1, 4, 8, 16};
+    if (_fifoCount >= thresholds[_regs[REG_CFG_8] >> 6])
+    {
+        _regs[REG_STATUS] |= 0x04; // FINT
+    }
+}
+
+uint16_t SimAS7341::fifoPop()
+{
+    if (_fifoCount == 0)
+    {
+        return 0;
+    }
+    uint16_t value = _fifo[_fifoHead];
+    _fifoHead = (_fifoHead + 1) % SIM_AS7341_FIFO_SIZE;
+    _fifoCount--;
+    return value;
+}
@@ -0,0 +1,167 @@
+// Register-level model of the AS7341 for host builds.
+//
+// Covers register banks, SMUX RAM and commands, ATIME/ASTEP integration
+// timing with the WEN/WTIME wait cycle, ASTATUS data latching, STATUS /
+// STATUS_2 flags, flicker detection (FD_STATUS) and the FIFO. The light
+// falling on the sensor is described by a SimScene.
+#ifndef SIM_AS7341_H
+#define SIM_AS7341_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+// Photodiode types the SMUX can route to an ADC
+enum SimDiode
+{
+    SIM_F1,
+    SIM_F2,
+    SIM_F3,
+    SIM_F4,
+    SIM_F5,
+    SIM_F6,
+    SIM_F7,
+    SIM_F8,
+    SIM_CLEAR,
+    SIM_NIR,
+    SIM_FLICKER,
+    SIM_DIODE_COUNT,
+    SIM_NONE = 0xFF
+};
+
+struct SimScene
+{
+    // Basic counts per millisecond at 1x gain for each filter (all of its
+    // pixels together), excluding the on-board LED
+    float rate[SIM_DIODE_COUNT];
+    // Extra counts per millisecond per mA of LED drive when the LED is on
+    float ledRatePerMa[SIM_DIODE_COUNT];
+    // Dark current in counts per millisecond at 1x gain
+    float darkRate;
+    // Intensity modulation of the ambient light: sinusoidal, or with a
+    // duty cycle set a PWM square wave that drops to (1 - depth) when off
+    float flickerHz;
+    float flickerDepth; // 0..1
+    float flickerDuty;  // 0 for sinusoidal, else the on fraction (0..1)
+    // Relative shot noise (0 disables noise)
+    float noise;
+};
+
+#define SIM_AS7341_FIFO_SIZE 128 // Entries of 16 bit
+#define SIM_AS7341_MAX_ERRORS 8
+
+class SimAS7341 : public I2cDevice
+{
+public:
+    SimAS7341();
+
+    void reset();
+    SimScene &scene();
+    static SimScene defaultScene();
+
+    // I2cDevice
+    uint8_t address();
+    void i2cWrite(const uint8_t *data, size_t length);
+    void i2cRead(uint8_t *data, size_t length);
+
+    // Brings the model up to the current virtual time
+    void update();
+
+    // Wires the open-drain INT output to a host pin
+    void connectInterrupt(uint8_t pin);
+
+    // Wires the GPIO (sync input in SYNS/SYND) to a host pin
+    void connectSync(uint8_t pin);
+
+    // Driver protocol violations (e.g. SMUX command while SP_EN is set)
+    uint32_t protocolErrors();
+    const char *protocolError(uint8_t index);
+
+    // Event counters
+    uint32_t smuxCommands;
+    uint32_t spectralCycles;
+    uint32_t fdSamples;
+    uint32_t interruptsRaised;
+    uint32_t syncEdges;
+    uint64_t lastSyncStart; // Integration start of the last synced cycle
+
+private:
+    SimScene _scene;
+    uint8_t _regs[256];
+    uint8_t _smuxRam[20];
+    uint8_t _smuxRoute[40]; // ADC (0-5) per pixel, or SIM_NONE
+    uint8_t _pointer;
+    uint64_t _now;
+
+    // Spectral engine
+    enum SpectralState
+    {
+        SP_IDLE,
+        SP_INTEGRATING,
+        SP_WAITING,
+        SP_WAIT_SYNC
+    };
+    SpectralState _spState;
+    uint64_t _spStart;
+    uint64_t _spEventAt;
+    uint32_t _cycleSteps;
+    uint8_t _cycleGainCode;
+    uint16_t _result[6];
+    uint8_t _resultStatus;
+    uint16_t _latched[6];
+    uint8_t _latchedStatus;
+    bool _avalid;
+    bool _asatDigital;
+    bool _asatAnalog;
+
+    // SMUX
+    bool _smuxBusy;
+    uint64_t _smuxDoneAt;
+
+    // Flicker detection
+    bool _fdRunning;
+    uint64_t _fdStart;
+    uint64_t _fdNextSample;
+    uint32_t _fdCount;
+    uint16_t _fifo[SIM_AS7341_FIFO_SIZE];
+    uint8_t _fifoHead;
+    uint8_t _fifoCount;
+    bool _fifoOverflow;
+    uint8_t _fdataHigh;
+
+    int _intPin;
+    bool _intAsserted;
+    int _syncPin;
+    int _gpioLevel;
+    uint8_t _edgesLeft;
+
+    uint32_t _rng;
+    uint32_t _errorCount;
+    char _errors[SIM_AS7341_MAX_ERRORS][64];
+
+    static void onAdvance(void *arg);
+    static void onSyncPin(void *arg, int level);
+    uint8_t syncMode();
+    void syncEdge();
+    void updateInterrupt();
+    void error(const char *message);
+    bool bankOk(uint8_t reg);
+    uint8_t readReg(uint8_t reg, bool first);
+    void writeReg(uint8_t reg, uint8_t value);
+    void writeEnable(uint8_t value);
+    void executeSmux();
+
+    uint64_t integrationMicros();
+    uint64_t waitMicros();
+    float gainFactor(uint8_t code);
+    double exposure(int diode, uint64_t t0, uint64_t t1);
+    double pwmOnTime(uint64_t t);
+    float noise(double counts);
+    void startIntegration();
+    void finishIntegration();
+    void fdSample();
+    void fdFinish();
+    void fifoPush(uint16_t value);
+    uint16_t fifoPop();
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "WiFi.h"
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <errno.h>
+
+WiFiClient::WiFiClient()
+{
+    _fd = -1;
+}
+
+WiFiClient::WiFiClient(int fd)
+{
+    _fd = fd;
+}
+
+int WiFiClient::fd() const
+{
+    return _fd;
+}
+
+uint8_t WiFiClient::connected()
+{
+    if (_fd < 0)
+    {
+        return 0;
+    }
+    char c;
+    ssize_t peeked = recv(_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return peeked > 0 || (peeked < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+}
+
+int WiFiClient::available()
+{
+    int count = 0;
+    return _fd >= 0 && ioctl(_fd, FIONREAD, &count) == 0 ? count : 0;
+}
+
+int WiFiClient::read()
+{
+    unsigned char c;
+    return _fd >= 0 && recv(_fd, &c, 1, MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::write(const uint8_t *data, size_t length)
+{
+    ssize_t sent = _fd >= 0 ? send(_fd, data, length, MSG_DONTWAIT | MSG_NOSIGNAL) : -1;
+    if (sent < (ssize_t)length)
+    {
+        hostAdvanceMicros(HOST_WIFI_WRITE_TIMEOUT_US);
+    }
+    return sent > 0 ? sent : 0;
+}
+
+size_t WiFiClient::print(const char *text)
+{
+    return write((const uint8_t *)text, strlen(text));
+}
+
+void WiFiClient::setNoDelay(bool noDelay)
+{
+    (void)noDelay; // No Nagle on a local socket
+}
+
+void WiFiClient::stop()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+WiFiClient::operator bool()
+{
+    return _fd >= 0;
+}
+
+WiFiServer::WiFiServer(uint16_t port)
+{
+    (void)port;
+    _count = 0;
+}
+
+void WiFiServer::begin()
+{
+}
+
+WiFiClient WiFiServer::available()
+{
+    if (_count == 0)
+    {
+        return WiFiClient();
+    }
+    WiFiClient client(_pending[0]);
+    _count--;
+    memmove(_pending, _pending + 1, _count * sizeof(int));
+    return client;
+}
+
+int WiFiServer::hostConnect()
+{
+    int ends[2];
+    if (_count == HOST_WIFI_MAX_PENDING || socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0)
+    {
+        return -1;
+    }
+    int size = HOST_WIFI_SEND_BUFFER;
+    setsockopt(ends[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    _pending[_count++] = ends[0];
+    return ends[1];
+}
@@ -0,0 +1,54 @@
+// Host WiFi: WiFiServer and WiFiClient over local socket pairs, so the
+// sketch modules send through real sockets with real buffer limits. The
+// bench plays the browser on the other end of each pair.
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+
+#define HOST_WIFI_MAX_PENDING 4
+#define HOST_WIFI_SEND_BUFFER 5744 // lwIP TCP_SND_BUF of the ESP32 core
+// WiFiClient::write() on the ESP32 retries a full socket 10 times with a
+// 1 s select() timeout before it gives up
+#define HOST_WIFI_WRITE_TIMEOUT_US 10000000ULL
+
+class WiFiClient
+{
+public:
+    WiFiClient();
+    explicit WiFiClient(int fd);
+
+    int fd() const;
+    uint8_t connected();
+    int available();
+    int read();
+    // Blocks like the ESP32 core: a write the socket cannot take advances
+    // the clock by HOST_WIFI_WRITE_TIMEOUT_US and returns what was sent
+    size_t write(const uint8_t *data, size_t length);
+    size_t print(const char *text);
+    void setNoDelay(bool noDelay);
+    void stop();
+    operator bool();
+
+private:
+    int _fd;
+};
+
+class WiFiServer
+{
+public:
+    WiFiServer(uint16_t port);
+
+    void begin();
+    WiFiClient available();
+
+    // Host only: a browser connects. Returns its end of the connection,
+    // which the caller reads, writes and closes.
+    int hostConnect();
+
+private:
+    int _pending[HOST_WIFI_MAX_PENDING];
+    uint8_t _count;
+};
+
+#endif
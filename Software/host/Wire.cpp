@@ -0,0 +1,142 @@
+#include "Wire.h"
+
+TwoWire Wire;
+
+void WireStats::reset()
+{
+    transactions = 0;
+    bytes = 0;
+    busMicros = 0;
+    nacks = 0;
+}
+
+TwoWire::TwoWire()
+{
+    _deviceCount = 0;
+    _frequency = 100000; // ESP32 Arduino default
+    _txLength = 0;
+    _rxLength = 0;
+    _rxIndex = 0;
+    stats.reset();
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency)
+{
+    (void)sda;
+    (void)scl;
+    if (frequency != 0)
+    {
+        _frequency = frequency;
+    }
+    return true;
+}
+
+void TwoWire::setClock(uint32_t frequency)
+{
+    _frequency = frequency;
+}
+
+uint32_t TwoWire::getClock()
+{
+    return _frequency;
+}
+
+void TwoWire::attach(I2cDevice *device)
+{
+    if (_deviceCount < HOST_WIRE_MAX_DEVICES)
+    {
+        _devices[_deviceCount++] = device;
+    }
+}
+
+I2cDevice *TwoWire::find(uint8_t address)
+{
+    for (uint8_t i = 0; i < _deviceCount; i++)
+    {
+        if (_devices[i]->address() == address)
+        {
+            return _devices[i];
+        }
+    }
+    return NULL;
+}
+
+void TwoWire::account(size_t dataBytes)
+{
+    // START + address byte + data bytes (9 clocks each with ACK) + STOP
+    size_t wireBytes = dataBytes + 1;
+    uint64_t clocks = wireBytes * 9 + 2;
+    uint64_t us = (clocks * 1000000ULL + _frequency - 1) / _frequency;
+
+    stats.transactions++;
+    stats.bytes += wireBytes;
+    stats.busMicros += us;
+    hostAdvanceMicros(us);
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    _txAddress = address;
+    _txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t value)
+{
+    if (_txLength >= HOST_WIRE_BUFFER_SIZE)
+    {
+        return 0;
+    }
+    _txBuffer[_txLength++] = value;
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    (void)sendStop;
+    account(_txLength);
+    I2cDevice *device = find(_txAddress);
+    if (device == NULL)
+    {
+        stats.nacks++;
+        return 2; // NACK on address
+    }
+    if (_txLength > 0)
+    {
+        device->i2cWrite(_txBuffer, _txLength);
+    }
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity)
+{
+    if (quantity > HOST_WIRE_BUFFER_SIZE)
+    {
+        quantity = HOST_WIRE_BUFFER_SIZE;
+    }
+    account(quantity);
+    _rxLength = 0;
+    _rxIndex = 0;
+    I2cDevice *device = find(address);
+    if (device == NULL)
+    {
+        stats.nacks++;
+        return 0;
+    }
+    device->i2cRead(_rxBuffer, quantity);
+    _rxLength = quantity;
+    return quantity;
+}
+
+int TwoWire::available()
+{
+    return (int)(_rxLength - _rxIndex);
+}
+
+int TwoWire::read()
+{
+    if (_rxIndex >= _rxLength)
+    {
+        return -1;
+    }
+    return _rxBuffer[_rxIndex++];
+}
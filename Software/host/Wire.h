@@ -0,0 +1,69 @@
+// Host TwoWire: routes transactions to simulated I2C devices and counts
+// what a real bus would have carried.
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define HOST_WIRE_MAX_DEVICES 4
+#define HOST_WIRE_BUFFER_SIZE 128
+
+// Interface implemented by simulated I2C targets
+class I2cDevice
+{
+public:
+    virtual ~I2cDevice() {}
+    virtual uint8_t address() = 0;
+    // Write transaction: data[0] is the register pointer
+    virtual void i2cWrite(const uint8_t *data, size_t length) = 0;
+    // Read transaction from the current register pointer
+    virtual void i2cRead(uint8_t *data, size_t length) = 0;
+};
+
+struct WireStats
+{
+    uint32_t transactions;
+    uint32_t bytes;      // Including the address byte of each transaction
+    uint64_t busMicros;  // Time the bus was occupied at the configured clock
+    uint32_t nacks;
+
+    void reset();
+};
+
+class TwoWire
+{
+public:
+    TwoWire();
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    void setClock(uint32_t frequency);
+    uint32_t getClock();
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t value);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    int available();
+    int read();
+
+    // Host side
+    void attach(I2cDevice *device);
+    WireStats stats;
+
+private:
+    I2cDevice *_devices[HOST_WIRE_MAX_DEVICES];
+    uint8_t _deviceCount;
+    uint32_t _frequency;
+    uint8_t _txAddress;
+    uint8_t _txBuffer[HOST_WIRE_BUFFER_SIZE];
+    size_t _txLength;
+    uint8_t _rxBuffer[HOST_WIRE_BUFFER_SIZE];
+    size_t _rxLength;
+    size_t _rxIndex;
+
+    I2cDevice *find(uint8_t address);
+    void account(size_t dataBytes);
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,1519 @@
+// Bus-cost benchmark for the AS7341 driver against the simulated device.
+//
+// Reports, per driver operation, the I2C transactions and bytes it puts on
+// the wire, the simulated bus time and the time spent blocked in delays.
+// Exits non-zero if the driver violated the device protocol.
+#include "Arduino.h"
+#include "Wire.h"
+#include "AS7341.h"
+#include "SimAS7341.h"
+#include "Acquisition.h"
+#include "AutoExposure.h"
+#include "HdrFusion.h"
+#include "BasicCounts.h"
+#include "Reconstruction.h"
+#include "Colorimetry.h"
+#include "DarkFrames.h"
+#include "Preferences.h"
+#include "FrameAverage.h"
+#include "FlickerAnalyzer.h"
+#include "FlickerLock.h"
+#include "TraceLog.h"
+#include "LatencyMetrics.h"
+#include "JsonWriter.h"
+#include "EventStreams.h"
+#include "WiFi.h"
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <math.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define INT_PIN 25
+#define SYNC_PIN 26
+
+static SimAS7341 device;
+
+// Every heap allocation of the process (glibc), new and Arduino-style
+// String growth included
+static uint64_t heapAllocations = 0;
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *pointer, size_t size);
+extern "C" void *malloc(size_t size)
+{
+    heapAllocations++;
+    return __libc_malloc(size);
+}
+extern "C" void *calloc(size_t count, size_t size)
+{
+    heapAllocations++;
+    return __libc_calloc(count, size);
+}
+extern "C" void *realloc(void *pointer, size_t size)
+{
+    heapAllocations++;
+    return __libc_realloc(pointer, size);
+}
+
+struct Cost
+{
+    uint32_t transactions;
+    uint32_t bytes;
+    uint64_t busUs;
+    uint64_t blockedUs;
+    uint64_t elapsedUs;
+};
+
+class Meter
+{
+public:
+    void start()
+    {
+        _transactions = Wire.stats.transactions;
+        _bytes = Wire.stats.bytes;
+        _busUs = Wire.stats.busMicros;
+        _blockedUs = hostBlockedMicros();
+        _startUs = hostMicros();
+    }
+
+    Cost stop()
+    {
+        Cost cost;
+        cost.transactions = Wire.stats.transactions - _transactions;
+        cost.bytes = Wire.stats.bytes - _bytes;
+        cost.busUs = Wire.stats.busMicros - _busUs;
+        cost.blockedUs = hostBlockedMicros() - _blockedUs;
+        cost.elapsedUs = hostMicros() - _startUs;
+        return cost;
+    }
+
+private:
+    uint32_t _transactions;
+    uint32_t _bytes;
+    uint64_t _busUs;
+    uint64_t _blockedUs;
+    uint64_t _startUs;
+};
+
+static void printHeader()
+{
+    printf("%-28s %8s %8s %12s %12s %12s\n", "operation", "i2c_tx", "bytes", "bus_us", "blocked_us", "elapsed_us");
+}
+
+static void printCost(const char *name, const Cost &cost)
+{
+    printf("%-28s %8u %8u %12llu %12llu %12llu\n", name, cost.transactions, cost.bytes,
+           (unsigned long long)cost.busUs, (unsigned long long)cost.blockedUs,
+           (unsigned long long)cost.elapsedUs);
+}
+
+// Polls the way loop() does until the capture reaches 'target' or finishes
+static uint8_t pollUntil(AS7341 &sensor, uint8_t target)
+{
+    while (true)
+    {
+        uint8_t state = sensor.poll();
+        if (state == target || state == AS7341_MEASURE_READY || state == AS7341_MEASURE_TIMEOUT ||
+            state == AS7341_MEASURE_IDLE)
+        {
+            return state;
+        }
+        delay(1);
+    }
+}
+
+// One-shot capture driven the way loop() does
+static bool captureFrame(Acquisition &acquisition)
+{
+    acquisition.start();
+    while (acquisition.busy())
+    {
+        if (acquisition.update())
+        {
+            return true;
+        }
+        delay(1);
+    }
+    return false;
+}
+
+// Auto-exposure from the default settings in a scene scaled by 'light'
+static void autoExposureRun(AS7341 &sensor, Acquisition &acquisition, const char *name, float light)
+{
+    SimScene base = SimAS7341::defaultScene();
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        device.scene().rate[i] = base.rate[i] * light;
+        device.scene().ledRatePerMa[i] = base.ledRatePerMa[i] * light;
+    }
+
+    SensorConfig config;
+    sensor.apply(config);
+    AutoExposure autoExposure;
+    autoExposure.setATimeLimits(9, 59);
+    Meter meter;
+    meter.start();
+    bool converged = false;
+    while (!converged && !autoExposure.limited() && autoExposure.iterations() < 6)
+    {
+        if (!captureFrame(acquisition))
+        {
+            break;
+        }
+        converged = autoExposure.update(acquisition.latest(), config);
+        sensor.apply(config);
+    }
+    printCost(name, meter.stop());
+    printf("  %s after %u capture(s): gain code %u, ATIME %u, peak at %.0f%% of full scale\n",
+           converged ? "converged" : (autoExposure.limited() ? "at limits" : "NOT converged"), autoExposure.iterations(), config.gain, config.atime,
+           autoExposure.lastFill() * 100);
+}
+
+// HDR bracket around the default settings in a scene with a strong line at
+// F7 and little light at F1; compares the fused spectrum with the scene
+// (ambient only, so the LED left on by earlier runs does not count)
+static void hdrRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        device.scene().ledRatePerMa[i] = 0;
+    }
+    device.scene().rate[SIM_F1] = 0.5f;
+    device.scene().rate[SIM_F7] = 500.0f;
+
+    SensorConfig config;
+    HdrFusion hdr;
+    hdr.plan(config);
+    Meter meter;
+    meter.start();
+    bool done = false;
+    for (uint8_t i = 0; i < hdr.exposures() && !done; i++)
+    {
+        sensor.apply(hdr.exposure(i));
+        if (!captureFrame(acquisition))
+        {
+            break;
+        }
+        done = hdr.add(i, acquisition.latest());
+    }
+    printCost("HDR bracket", meter.stop());
+
+    const HdrSpectrum &fused = hdr.result();
+    printf("HDR: %u exposures, planned %lu us, captured in %lu us%s\n", fused.exposures,
+           (unsigned long)fused.plannedMicros, (unsigned long)fused.captureMicros, done ? "" : " (INCOMPLETE)");
+    static const uint8_t diode[SPECTRAL_CHANNELS] = {SIM_F1, SIM_F2, SIM_F3, SIM_F4, SIM_F5, SIM_F6, SIM_F7, SIM_F8, SIM_NIR};
+    printf("  %-4s %10s %10s %7s %7s %4s\n", "ch", "scene", "fused", "err%", "weight", "exp");
+    for (uint8_t i = 0; i < SPECTRAL_CHANNELS; i++)
+    {
+        float truth = device.scene().rate[diode[i]] + device.scene().darkRate;
+        uint8_t phase = i < 4 ? SPECTRAL_PHASE_F1F4 : SPECTRAL_PHASE_F5F8;
+        uint8_t adc = i < 4 ? i : (i < 8 ? i - 4 : SPECTRAL_ADC_NIR);
+        printf("  %-4u %10.3f %10.3f %7.2f %7.2f %4u\n", i + 1, truth, fused.channel(i),
+               (fused.channel(i) - truth) / truth * 100, fused.channelWeight(i), fused.source[phase][adc]);
+    }
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// Raw counts to basic counts: the float path the sketch used before
+// (pow() for the gain, float integration time) against BasicCounts.
+// Host wall-clock time, so only the ratio is meaningful for the ESP32.
+static void normalisationRun(AS7341 &sensor)
+{
+    // Bus cost of reading gain and integration time through the driver,
+    // cold (after invalidateCache) and from the register shadow
+    sensor.apply(SensorConfig());
+    sensor.invalidateCache();
+    Meter meter;
+    meter.start();
+    sensor.getAgainFactor();
+    sensor.getIntegrationTime();
+    printCost("gain+time getters, cold", meter.stop());
+    meter.start();
+    sensor.getAgainFactor();
+    sensor.getIntegrationTime();
+    printCost("gain+time getters, cached", meter.stop());
+
+    const uint32_t count = 1 << 20;
+    static uint16_t counts[1 << 10];
+    for (uint32_t i = 0; i < (1 << 10); i++)
+    {
+        counts[i] = (uint16_t)((i * 2654435761UL) >> 16);
+    }
+    static const uint8_t atimes[] = {0, 9, 29, 59, 255};
+    static const uint16_t asteps[] = {0, 599, 999, 65534};
+
+    volatile float floatSink = 0;
+    volatile uint32_t fixedSink = 0;
+    double worstError = 0;
+    double floatNs = 0;
+    double fixedNs = 0;
+    for (uint8_t t = 0; t < sizeof(atimes); t++)
+    {
+        for (uint8_t a = 0; a < sizeof(asteps) / sizeof(asteps[0]); a++)
+        {
+            uint8_t atime = atimes[t];
+            uint16_t astep = asteps[a];
+            uint32_t steps = (atime + 1UL) * (astep + 1UL);
+            uint16_t fullScale = steps < 65535 ? steps : 65535;
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uint8_t gain = i % 11;
+                float integrationMs = (astep + 1) * (atime + 1) * 2.78 / 1000.0;
+                floatSink = (counts[i & 1023] % (fullScale + 1)) / (pow(2, gain - 1) * integrationMs);
+            }
+            auto middle = std::chrono::steady_clock::now();
+            BasicCounts basic;
+            basic.setTiming(atime, astep);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                fixedSink = basic.normalise(counts[i & 1023] % (fullScale + 1), i % 11);
+            }
+            auto end = std::chrono::steady_clock::now();
+            floatNs += std::chrono::duration<double, std::nano>(middle - start).count();
+            fixedNs += std::chrono::duration<double, std::nano>(end - middle).count();
+
+            // Accuracy against a double reference, ignoring the Q16.16
+            // resolution for readings that round to (nearly) zero
+            for (uint32_t i = 0; i < 1024; i++)
+            {
+                uint16_t raw = counts[i] % (fullScale + 1);
+                uint8_t gain = i % 11;
+                double reference = raw / (pow(2.0, gain - 1) * steps * 0.00278);
+                double value = BasicCounts::toFloat(basic.normalise(raw, gain));
+                if (reference > 0.01)
+                {
+                    double error = fabs(value - reference) / reference;
+                    worstError = error > worstError ? error : worstError;
+                }
+            }
+        }
+    }
+    uint32_t conversions = count * sizeof(atimes) * (sizeof(asteps) / sizeof(asteps[0]));
+    printf("normalisation: float %.2f ns, fixed-point %.2f ns per reading (host), worst error %.2e above 0.01\n",
+           floatNs / conversions, fixedNs / conversions, worstError);
+    (void)floatSink;
+    (void)fixedSink;
+}
+
+// Dense spectrum of one captured frame; times the scalar kernel (what the
+// ESP32 runs, though the host compiler may vectorise it as well) against
+// the explicitly vectorised host kernel and checks they agree
+static void reconstructionRun(Acquisition &acquisition)
+{
+    if (!captureFrame(acquisition))
+    {
+        printf("reconstruction: capture failed\n");
+        return;
+    }
+    Reconstruction reconstruction;
+    const int32_t *spectrum = reconstruction.compute(acquisition.latest());
+
+    int32_t x[RECON_CHANNELS];
+    for (uint8_t c = 0; c < RECON_CHANNELS; c++)
+    {
+        x[c] = (int32_t)(((c + 1) * 2654435761UL) & ((1 << RECON_INPUT_BITS) - 1));
+    }
+    static int32_t scalarOut[RECON_BINS_PADDED];
+    static int32_t simdOut[RECON_BINS_PADDED];
+    const uint32_t rounds = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        x[i % RECON_CHANNELS] ^= 1;
+        Reconstruction::kernelScalar(reconMatrix, x, scalarOut);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        x[i % RECON_CHANNELS] ^= 1;
+        Reconstruction::kernel(reconMatrix, x, simdOut);
+    }
+    auto end = std::chrono::steady_clock::now();
+    Reconstruction::kernelScalar(reconMatrix, x, scalarOut);
+    bool match = memcmp(scalarOut, simdOut, sizeof(scalarOut)) == 0;
+
+    printf("reconstruction: %u bins, scalar %.1f ns, %s %.1f ns per spectrum (host), kernels %s\n", RECON_BINS,
+           std::chrono::duration<double, std::nano>(middle - start).count() / rounds, RECON_SIMD ? "SIMD" : "scalar",
+           std::chrono::duration<double, std::nano>(end - middle).count() / rounds, match ? "agree" : "DIFFER");
+    printf("  nm:");
+    for (uint16_t b = 0; b < RECON_BINS; b += 10)
+    {
+        printf(" %u=%.3f", Reconstruction::wavelength(b), Reconstruction::toFloat(spectrum[b]));
+    }
+    printf("\n");
+}
+
+// A blackbody at 'kelvin' seen through the nominal Gaussian channel
+// responses of gen_reconstruction.py, brightest channel at 10 basic counts
+static void blackbodyScene(float kelvin)
+{
+    static const float centre[9] = {415, 445, 480, 515, 555, 590, 630, 680, 940};
+    static const float fwhm[9] = {26, 30, 36, 39, 39, 40, 50, 52, 60};
+    static const SimDiode diodes[9] = {SIM_F1, SIM_F2, SIM_F3, SIM_F4, SIM_F5, SIM_F6, SIM_F7, SIM_F8, SIM_NIR};
+    float response[9];
+    float peak = 0.0f;
+    for (int c = 0; c < 9; c++)
+    {
+        float sigma = fwhm[c] / 2.3548f;
+        response[c] = 0.0f;
+        for (int nm = 300; nm < 1100; nm++)
+        {
+            double metres = nm * 1e-9;
+            double planck = pow(metres, -5) / expm1(1.4388e-2 / (metres * kelvin));
+            response[c] += (float)(exp(-0.5 * pow((nm - centre[c]) / sigma, 2)) * planck * 1e-30);
+        }
+        peak = response[c] > peak ? response[c] : peak;
+    }
+
+    SimScene &scene = device.scene();
+    scene = SimAS7341::defaultScene();
+    for (int c = 0; c < 9; c++)
+    {
+        scene.rate[diodes[c]] = 10.0f * response[c] / peak;
+        scene.ledRatePerMa[diodes[c]] = 0.0f;
+    }
+}
+
+// CCT and chromaticity of captured blackbody scenes against the known
+// temperature, and the cost of a colorimetry update per new frame
+static void colorimetryRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    sensor.apply(SensorConfig());
+    Colorimetry colorimetry;
+    static const float kelvin[] = {2700.0f, 4000.0f, 6500.0f};
+    for (float t : kelvin)
+    {
+        blackbodyScene(t);
+        if (!captureFrame(acquisition))
+        {
+            printf("colorimetry: capture failed\n");
+            return;
+        }
+        const ColorResult &c = colorimetry.compute(acquisition.latest());
+        printf("colorimetry, %.0f K blackbody: CCT %.0f K (%+.2f%%), Duv %+.4f, x %.4f y %.4f, %.1f lux (nominal)\n",
+               t, c.cct, (c.cct - t) * 100.0f / t, c.duv, c.x, c.y, c.lux);
+    }
+
+    // New frames: every compute() redoes the conversion; repeats of the
+    // same frame come from the cache
+    SpectralFrame frame = acquisition.latest();
+    const uint32_t rounds = 100000;
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        frame.sequence++;
+        frame.adc[i & 1][i % 4] ^= 1;
+        sink += colorimetry.compute(frame).cct;
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        sink += colorimetry.compute(frame).cct;
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("colorimetry: %.1f ns per new frame, %.1f ns cached (host)\n",
+           std::chrono::duration<double, std::nano>(middle - start).count() / rounds,
+           std::chrono::duration<double, std::nano>(end - middle).count() / rounds);
+    (void)sink;
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// Dark reference captured with no light, applied to the next frame,
+// then reloaded from NVS as after a reboot
+static void darkRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    Preferences::hostErase();
+    sensor.apply(SensorConfig());
+    device.scene() = SimAS7341::defaultScene();
+    device.scene().darkRate = 2.0f; // Exaggerated so the offset is visible
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        device.scene().ledRatePerMa[i] = 0; // Ambient only
+    }
+
+    DarkFrames darks;
+    darks.begin();
+    SimScene lit = device.scene();
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        device.scene().rate[i] = 0;
+    }
+    uint32_t nvsWrites = Preferences::stats.writes;
+    bool captured = captureFrame(acquisition);
+    darks.store(acquisition.latest());
+    device.scene() = lit;
+
+    acquisition.setDarkFrames(&darks);
+    Meter meter;
+    meter.start();
+    captured = captureFrame(acquisition) && captured;
+    printCost("frame with dark correction", meter.stop());
+    const SpectralFrame &frame = acquisition.latest();
+
+    printf("dark: %s, %u reference(s), %lu NVS write(s); corrected vs expected:", captured ? "captured" : "FAILED",
+           darks.count(), (unsigned long)(Preferences::stats.writes - nvsWrites));
+    static const uint8_t diode[SPECTRAL_CHANNELS] = {SIM_F1, SIM_F2, SIM_F3, SIM_F4, SIM_F5, SIM_F6, SIM_F7, SIM_F8, SIM_NIR};
+    float gain = frame.gain(SPECTRAL_PHASE_F1F4) == 0 ? 0.5f : (float)(1UL << (frame.gain(SPECTRAL_PHASE_F1F4) - 1));
+    float ms = frame.integrationMicros() / 1000.0f;
+    for (uint8_t i = 0; i < SPECTRAL_CHANNELS; i++)
+    {
+        float expected = lit.rate[diode[i]] * gain * ms;
+        printf(" %u/%.0f", frame.channel(i), expected);
+    }
+    printf(" (%s)\n", acquisition.darkCorrected() ? "corrected" : "NOT corrected");
+
+    // A fresh cache finds the reference again and still subtracts it, but
+    // asks for a new one: its capture time was lost with the reboot.
+    // Other settings need one anyway; recapturing clears the request.
+    DarkFrames reloaded;
+    reloaded.begin();
+    acquisition.setDarkFrames(&reloaded);
+    bool corrected = captureFrame(acquisition) && acquisition.darkCorrected();
+    SensorConfig other;
+    other.gain = 6;
+    printf("dark after reload: %u reference(s), %s, needed for default %s, for gain code 6 %s",
+           reloaded.count(), corrected ? "corrected" : "NOT corrected",
+           reloaded.needed(SensorConfig().gain, SensorConfig().atime, SensorConfig().astep) ? "yes" : "NO",
+           reloaded.needed(other.gain, other.atime, other.astep) ? "yes" : "no");
+    for (int i = 0; i < SIM_DIODE_COUNT; i++)
+    {
+        device.scene().rate[i] = 0;
+    }
+    acquisition.setDarkFrames(NULL);
+    captureFrame(acquisition);
+    reloaded.store(acquisition.latest());
+    device.scene() = lit;
+    printf(", after recapture %s\n",
+           reloaded.needed(SensorConfig().gain, SensorConfig().atime, SensorConfig().astep) ? "YES" : "no");
+
+    acquisition.setDarkFrames(NULL);
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// 16-frame average pipelined with continuous capture at the shortest
+// period, in a scene with shot noise (SNR should follow sqrt(counts))
+static void averageRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    sensor.apply(SensorConfig());
+    device.scene() = SimAS7341::defaultScene();
+    device.scene().noise = 1.0f;
+
+    FrameAverage average;
+    average.begin(16);
+    Meter meter;
+    meter.start();
+    acquisition.setContinuous(true, ACQ_MIN_PERIOD_MS);
+    acquisition.start();
+    while (acquisition.busy() && average.active())
+    {
+        if (acquisition.update())
+        {
+            average.add(acquisition.latest());
+        }
+        delay(1);
+    }
+    acquisition.setContinuous(false, ACQ_MIN_PERIOD_MS);
+    Cost cost = meter.stop();
+    printCost("average, 16 frames", cost);
+
+    uint32_t integrationUs = (uint32_t)(sensor.getIntegrationTime() * 1000);
+    printf("average: %u frames in %lu us (first to last readout), %lu us of integration per frame\n", average.count(),
+           (unsigned long)average.elapsedMicros(), (unsigned long)(2 * integrationUs));
+    printf("  %-4s %9s %8s %7s %9s\n", "ch", "mean", "stddev", "snr", "sqrt(mean)");
+    for (uint8_t i = 0; i < SPECTRAL_CHANNELS; i++)
+    {
+        printf("  %-4u %9.1f %8.2f %7.1f %9.1f\n", i + 1, average.mean(i), average.stddev(i), average.snr(i),
+               sqrtf(average.mean(i)));
+    }
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// One flicker capture of the FIFO waveform against a known source. The
+// expected flicker index is depth / pi for a sine and (1 - duty) for a
+// PWM that switches fully off.
+static void flickerCase(FlickerAnalyzer &flicker, const char *name, float hz, float depth, float duty, float rate,
+                        uint32_t busHz)
+{
+    device.scene() = SimAS7341::defaultScene();
+    device.scene().flickerHz = hz;
+    device.scene().flickerDepth = depth;
+    device.scene().flickerDuty = duty;
+    Wire.setClock(busHz);
+
+    Meter meter;
+    meter.start();
+    flicker.configure(rate, FLICKER_DEFAULT_GAIN);
+    flicker.start();
+    while (!flicker.update())
+    {
+        delay(1); // loop() granularity
+    }
+    Cost cost = meter.stop();
+    printCost(name, cost);
+    Wire.setClock(100000);
+
+    const FlickerResult &r = flicker.result();
+    float index = depth == 0.0f ? 0.0f : (duty > 0.0f ? duty * (1.0f - duty) * depth / (1.0f - depth * (1.0f - duty)) : depth / (float)M_PI);
+    printf("  %.0f Hz at %.0f Hz: found %.1f Hz, depth %.3f (amplitude %.3f), flicker index %.3f (expect %.3f)%s%s\n",
+           hz, r.sampleRateHz, r.frequencyHz, r.modulationDepth, r.amplitudeDepth, r.flickerIndex, index,
+           r.overflow ? ", FIFO OVERFLOW" : "", r.saturated ? ", saturated" : "");
+    printf("  %u samples in %lu bursts, %.1f bytes/sample on the bus\n", r.samples, (unsigned long)flicker.getBursts(),
+           (float)cost.bytes / r.samples);
+}
+
+static void flickerRun(AS7341 &sensor)
+{
+    FlickerAnalyzer flicker(sensor);
+    flickerCase(flicker, "flicker, steady light", 0.0f, 0.0f, 0.0f, 2000, 100000);
+    flickerCase(flicker, "flicker, 100 Hz sine", 100.0f, 0.3f, 0.0f, 2000, 100000);
+    flickerCase(flicker, "flicker, 120 Hz sine", 120.0f, 0.05f, 0.0f, 2000, 100000);
+    flickerCase(flicker, "flicker, 370 Hz PWM 30%", 370.0f, 1.0f, 0.3f, 2000, 100000);
+    // 8 kHz asked for at 100 kHz: capped to what the bus can drain
+    flickerCase(flicker, "flicker, 1.2 kHz PWM 100k", 1200.0f, 1.0f, 0.5f, 8000, 100000);
+    flickerCase(flicker, "flicker, 1.2 kHz PWM 400k", 1200.0f, 1.0f, 0.5f, 8000, 400000);
+    flickerCase(flicker, "flicker, 2.5 kHz PWM 400k", 2500.0f, 0.8f, 0.25f, 10000, 400000);
+
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// Continuous frames at 'periodMs' for 'frames' frames; returns the mean
+// and worst frame interval and counts the flicker results that came in
+static void continuousRun(Acquisition &acquisition, FlickerAnalyzer &flicker, uint32_t periodMs, int frames,
+                          float &meanMs, float &worstMs, int &refreshes)
+{
+    acquisition.setContinuous(true, periodMs);
+    acquisition.start();
+    unsigned long first = 0;
+    unsigned long last = 0;
+    float worst = periodMs;
+    int published = 0;
+    long age = flicker.age();
+    refreshes = 0;
+    while (published < frames + 10)
+    {
+        if (acquisition.update())
+        {
+            // Skip the first frames while the wait timer trims in
+            unsigned long now = micros();
+            if (++published > 10)
+            {
+                float interval = (now - last) / 1000.0f;
+                worst = fabsf(interval - periodMs) > fabsf(worst - periodMs) ? interval : worst;
+            }
+            else
+            {
+                first = now;
+            }
+            last = now;
+        }
+        long nowAge = flicker.age();
+        refreshes += nowAge >= 0 && (age < 0 || nowAge < age) ? 1 : 0;
+        age = nowAge;
+        delay(1);
+    }
+    acquisition.setContinuous(false, periodMs);
+    meanMs = (last - first) / 1000.0f / frames;
+    worstMs = worst;
+}
+
+// Continuous mode at the shortest period with ATIME changed mid-run: the
+// sensor restarts the next frame straight away, so the first frame after
+// the change may have one phase at each ATIME. Both phases see the same
+// light through Clear; a published frame must show no step between them.
+static void settingsChangeRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    SensorConfig config;
+    sensor.apply(config);
+    acquisition.setContinuous(true, ACQ_MIN_PERIOD_MS);
+    acquisition.start();
+    uint32_t discarded = acquisition.discarded();
+    int published = 0;
+    float worst = 0.0f;
+    while (published < 8)
+    {
+        if (acquisition.update())
+        {
+            const SpectralFrame &frame = acquisition.latest();
+            float step = (float)frame.clear(0) / frame.clear(1) - 1.0f;
+            worst = fabsf(step) > fabsf(worst) ? step : worst;
+            if (++published % 3 == 0)
+            {
+                config.atime = config.atime == 29 ? 59 : 29;
+                sensor.apply(config);
+            }
+        }
+        delay(1);
+    }
+    acquisition.setContinuous(false, ACQ_MIN_PERIOD_MS);
+    sensor.apply(SensorConfig());
+    printf("continuous, ATIME changed mid-run: %d frames published, %lu dropped, worst Clear step between phases "
+           "%+.1f%%\n",
+           published, (unsigned long)(acquisition.discarded() - discarded), worst * 100.0f);
+}
+
+// Flicker analysis as a background job of the acquisition: it must not
+// stretch one-shot frames or the continuous cadence, and the SMUX is only
+// restored when a spectral phase needs it
+static void flickerInterleaveRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    sensor.apply(SensorConfig());
+    device.scene() = SimAS7341::defaultScene();
+    device.scene().flickerHz = 100.0f;
+    device.scene().flickerDepth = 0.3f;
+    FlickerAnalyzer flicker(sensor);
+    Meter meter;
+
+    float meanMs;
+    float worstMs;
+    int refreshes;
+    continuousRun(acquisition, flicker, 500, 12, meanMs, worstMs, refreshes);
+    printf("continuous 500 ms, no flicker job: mean interval %.1f ms, worst %.1f ms\n", meanMs, worstMs);
+    acquisition.setFlicker(&flicker, 1000);
+    continuousRun(acquisition, flicker, 500, 12, meanMs, worstMs, refreshes);
+    printf("continuous 500 ms, flicker every 1 s: mean interval %.1f ms, worst %.1f ms, %d flicker result(s), "
+           "%.1f Hz, age %ld ms\n",
+           meanMs, worstMs, refreshes, flicker.result().frequencyHz, flicker.age());
+    continuousRun(acquisition, flicker, 150, 12, meanMs, worstMs, refreshes);
+    printf("continuous 150 ms (no room for it): mean interval %.1f ms, %d flicker result(s)\n", meanMs, refreshes);
+
+    // One-shot: the job runs while idle after the frame
+    acquisition.setFlicker(&flicker, 0);
+    acquisition.refreshFlicker();
+    meter.start();
+    captureFrame(acquisition);
+    printCost("one-shot, flicker due", meter.stop());
+    meter.start();
+    while (acquisition.flickerPending())
+    {
+        acquisition.update();
+        delay(1);
+    }
+    printCost("flicker job while idle", meter.stop());
+
+    // The SMUX now holds the flicker routing: the next frame restores it,
+    // a frame following a frame does not
+    uint32_t skips = sensor.getSmuxSkips();
+    meter.start();
+    captureFrame(acquisition);
+    printCost("one-shot after flicker", meter.stop());
+    acquisition.setContinuous(true, 500);
+    meter.start();
+    acquisition.start();
+    Cost cost = meter.stop();
+    acquisition.setContinuous(false, 500);
+    printCost("continuous start, half loaded", cost);
+    printf("SMUX setups skipped: %lu (continuous start reuses the half loaded by the one-shot frame)\n",
+           (unsigned long)(sensor.getSmuxSkips() - skips));
+
+    acquisition.setFlicker(NULL, 0);
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// Spread of one channel over one-shot frames started at scattered phases
+// of the flicker: peak-to-peak over the mean
+static float captureSpread(Acquisition &acquisition, int frames)
+{
+    float lo = 1e9f;
+    float hi = 0.0f;
+    float sum = 0.0f;
+    for (int i = 0; i < frames; i++)
+    {
+        delay(3 + 7 * i);
+        captureFrame(acquisition);
+        float value = acquisition.latest().channel(4);
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+        sum += value;
+    }
+    return (hi - lo) / (sum / frames);
+}
+
+// Readings under 100 Hz and 137 Hz sine flicker with ATIME 9 (16.7 ms,
+// 1.67 cycles at 100 Hz), then with the integration locked to the
+// frequency found by the flicker analysis
+static void flickerLockCase(AS7341 &sensor, Acquisition &acquisition, float hz)
+{
+    device.scene() = SimAS7341::defaultScene();
+    device.scene().flickerHz = hz;
+    device.scene().flickerDepth = 0.3f;
+    SensorConfig config;
+    config.atime = 9;
+    sensor.apply(config);
+    float spreadFree = captureSpread(acquisition, 12);
+    float cyclesFree = (config.atime + 1) * (config.astep + 1) * LOCK_STEP_NS / 1e9f * hz;
+
+    FlickerAnalyzer flicker(sensor);
+    flicker.measure();
+    FlickerLock lock;
+    lock.apply(flicker.result().frequencyHz, config);
+    sensor.apply(config);
+    float spreadLocked = captureSpread(acquisition, 12);
+
+    printf("flicker lock, %.0f Hz sine 30%%: measured %.2f Hz, locked to %.2f Hz\n", hz, flicker.result().frequencyHz,
+           lock.frequency());
+    printf("  free:   %.2f cycles, spread %.2f%% p-p (predicted %.2f%%)\n", cyclesFree, 100 * spreadFree,
+           200 * FlickerLock::ripple(0.3f, cyclesFree));
+    printf("  locked: ATIME %u ASTEP %u, %u cycles in %lu us, phase error %.3f deg, spread %.2f%% p-p (predicted "
+           "%.3f%%)\n",
+           config.atime, config.astep, lock.cycles(), (unsigned long)lock.integrationMicros(), lock.phaseError(),
+           100 * spreadLocked, 200 * lock.ripple(0.3f));
+}
+
+static void flickerLockRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    flickerLockCase(sensor, acquisition, 100.0f);
+    flickerLockCase(sensor, acquisition, 137.0f);
+
+    // A capture that overflowed the FIFO must not move the lock
+    FlickerLock lock;
+    SensorConfig config;
+    FlickerResult result;
+    memset(&result, 0, sizeof(result));
+    result.frequencyHz = 100.0f;
+    lock.apply(result, config);
+    result.frequencyHz = 437.0f;
+    result.overflow = true;
+    lock.apply(result, config);
+    printf("flicker lock, overflowed capture at %.0f Hz: %s %.2f Hz\n", result.frequencyHz,
+           lock.locked() ? "still locked to" : "UNLOCKED from", lock.frequency());
+    sensor.apply(SensorConfig());
+    device.scene() = SimAS7341::defaultScene();
+}
+
+// Cost of recording a log entry, levels above LOG_LEVEL compiling out, and
+// a burst larger than the ring drained to the serial port
+static void logRun()
+{
+    const uint32_t rounds = 1000000;
+    uint32_t before = traceLog.written();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        LOG_INFO("frame %ld: ATIME %ld, ASTEP %ld, gain code %ld", i, 29, 599, 4);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        LOG_DEBUG("F1-F4: %ld %ld %ld %ld", i, i, i, i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    uint32_t debugWritten = traceLog.written() - before - rounds;
+    printf("log: %.1f ns per entry, LOG_DEBUG %.1f ns and %u entries (level %d) (host)\n",
+           std::chrono::duration<double, std::nano>(middle - start).count() / rounds,
+           std::chrono::duration<double, std::nano>(end - middle).count() / rounds, debugWritten, LOG_LEVEL);
+
+    TraceLog burst;
+    for (uint32_t i = 0; i < LOG_RING_SIZE + 72; i++)
+    {
+        burst.write(LOG_LEVEL_INFO, "frame %ld: ATIME %ld, ASTEP %ld, gain code %ld", i, 29, 599, 4);
+    }
+    size_t serialBefore = Serial.bytesWritten();
+    burst.drain(Serial);
+    char line[LOG_LINE_SIZE];
+    TraceLog::format(*burst.entry(burst.written() - 1), line, sizeof(line), true);
+    printf("log: burst of %u, %u dropped, %u drained as %u bytes; last \"%s\"\n", burst.written(), burst.dropped(),
+           burst.written() - burst.dropped(), (unsigned)(Serial.bytesWritten() - serialBefore), line);
+}
+
+// Driver phase and register latencies over a run of one-shot captures (on
+// the simulated clock, so they include the modelled bus time), histogram
+// percentiles against exact ones, and the cost of recording a sample
+static void metricsRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    LatencyMetrics metrics;
+    metrics.attach(sensor);
+    sensor.apply(SensorConfig());
+    for (int i = 0; i < 20; i++)
+    {
+        captureFrame(acquisition);
+    }
+    sensor.setTimingCallback(NULL, NULL);
+
+    for (uint8_t m = METRIC_SMUX; m <= METRIC_REG_WRITE; m++)
+    {
+        LatencyHistogram &h = metrics.histogram(m);
+        printf("metrics, %-15s %5u samples, p50 %6u us, p95 %6u us, p99 %6u us, max %6u us\n", LatencyMetrics::name(m),
+               h.count(), h.percentile(0.5f), h.percentile(0.95f), h.percentile(0.99f), h.max());
+    }
+
+    // Log-normal durations around 2 ms
+    LatencyHistogram h;
+    std::vector<uint32_t> samples;
+    uint32_t seed = 12345;
+    for (int i = 0; i < 100000; i++)
+    {
+        float u = 0.0f;
+        for (int k = 0; k < 4; k++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            u += (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        }
+        samples.push_back((uint32_t)(2000.0f * expf(u)));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t us : samples)
+    {
+        h.record(us);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::sort(samples.begin(), samples.end());
+    float worst = 0.0f;
+    static const float fractions[] = {0.5f, 0.95f, 0.99f};
+    for (float f : fractions)
+    {
+        uint32_t exact = samples[(size_t)ceilf(f * samples.size()) - 1];
+        float error = (float)h.percentile(f) / exact - 1.0f;
+        worst = fabsf(error) > fabsf(worst) ? error : worst;
+    }
+    static char text[METRICS_TEXT_SIZE];
+    size_t length = metrics.prometheus(text, sizeof(text));
+    printf("metrics: %.1f ns per sample (host), percentiles within %+.1f%% of exact, /metrics %u of %u bytes\n",
+           std::chrono::duration<double, std::nano>(end - start).count() / samples.size(), worst * 100.0f,
+           (unsigned)length, (unsigned)sizeof(text));
+}
+
+// /frame.bin: the packed frame decoded back as the page does, against the
+// same fields written as JSON the way /data writes them
+static void packRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    sensor.apply(SensorConfig());
+    captureFrame(acquisition);
+    const SpectralFrame &frame = acquisition.latest();
+
+    uint8_t packet[FRAME_PACKET_SIZE];
+    size_t length = frame.pack(FRAME_FLAG_CONTINUOUS, packet);
+    auto le = [&](int offset, int bytes) {
+        uint32_t value = 0;
+        for (int i = bytes - 1; i >= 0; i--)
+        {
+            value = value << 8 | packet[offset + i];
+        }
+        return value;
+    };
+    bool match = packet[0] == FRAME_PACKET_VERSION && packet[1] == FRAME_FLAG_CONTINUOUS &&
+                 packet[2] == frame.gain(0) && packet[3] == frame.gain(1) && le(4, 4) == frame.sequence &&
+                 le(8, 4) == frame.phaseMicros[1] && le(12, 2) == frame.astep && packet[14] == frame.atime &&
+                 packet[15] == frame.mode && le(34, 2) == frame.clear(0) && le(36, 2) == frame.clear(1);
+    for (int i = 0; i < 9; i++)
+    {
+        match = match && le(16 + 2 * i, 2) == frame.channel(i);
+    }
+
+    char json[512];
+    int n = snprintf(json, sizeof(json), "{\"values\": [");
+    for (int i = 0; i < 9; i++)
+    {
+        n += snprintf(json + n, sizeof(json) - n, "%u%s", frame.channel(i), i < 8 ? "," : "],");
+    }
+    n += snprintf(json + n, sizeof(json) - n,
+                  "\"frame\": {\"atime\": %u,\"astep\": %u,\"saturated\": %s,\"gain_code\": [%u,%u],"
+                  "\"clear\": [%u,%u],\"timestamps_us\": [%lu,%lu]},\"sequence\": %lu,\"measuring\": false,"
+                  "\"continuous\": true}",
+                  frame.atime, frame.astep, frame.saturated() ? "true" : "false", frame.gain(0), frame.gain(1),
+                  frame.clear(0), frame.clear(1), (unsigned long)frame.phaseMicros[0],
+                  (unsigned long)frame.phaseMicros[1], (unsigned long)frame.sequence);
+
+    const uint32_t rounds = 1000000;
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        frame.pack(i & 0x0E, packet);
+        sink = sink + packet[17];
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("frame.bin: %u bytes (same fields as JSON: %d), decodes %s, %.1f ns per pack (host)\n", (unsigned)length, n,
+           match ? "back exactly" : "WRONG", std::chrono::duration<double, std::nano>(end - start).count() / rounds);
+}
+
+// The frame part of the /data reply, as handleData() writes it
+static size_t frameJson(const SpectralFrame &frame, BasicCounts &basic, Colorimetry &colorimetry, char *buffer,
+                        size_t size)
+{
+    JsonWriter json(buffer, size);
+    json.beginObject();
+    json.beginArray("values");
+    for (int i = 0; i < 9; i++)
+    {
+        json.addUnsigned(NULL, frame.channel(i));
+    }
+    json.endArray();
+    json.beginObject("frame");
+    json.addUnsigned("atime", frame.atime);
+    json.addUnsigned("astep", frame.astep);
+    json.addUnsigned("integration_us", frame.integrationMicros());
+    json.addBool("saturated", frame.saturated());
+    json.beginArray("timestamps_us");
+    json.addUnsigned(NULL, frame.phaseMicros[0]);
+    json.addUnsigned(NULL, frame.phaseMicros[1]);
+    json.endArray();
+    uint32_t counts[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    basic.normalise(frame, counts);
+    json.beginArray("basic");
+    for (int i = 0; i < 9; i++)
+    {
+        json.addFloat(NULL, BasicCounts::toFloat(counts[i / 4 < 2 ? i / 4 : 1][i < 8 ? i % 4 : SPECTRAL_ADC_NIR]), 4);
+    }
+    json.endArray();
+    const ColorResult &color = colorimetry.compute(frame);
+    json.beginObject("color");
+    json.addBool("valid", color.valid);
+    json.addFloat("lux", color.lux, 2);
+    json.addFloat("cct", color.cct, 0);
+    json.addFloat("duv", color.duv, 4);
+    json.addFloat("x", color.x, 4);
+    json.addFloat("y", color.y, 4);
+    json.endObject();
+    json.endObject();
+    json.addUnsigned("sequence", frame.sequence);
+    json.addString("sync_mode", "spm");
+    json.endObject();
+    return json.overflowed() ? 0 : json.length();
+}
+
+// The same by concatenation, standing in for the String code it replaced
+static std::string fixed(float value, int decimals)
+{
+    char text[24];
+    snprintf(text, sizeof(text), "%.*f", decimals, value);
+    return std::string(text);
+}
+
+static std::string frameString(const SpectralFrame &frame, BasicCounts &basic, Colorimetry &colorimetry)
+{
+    std::string json = "{";
+    json += "\"values\":[";
+    for (int i = 0; i < 9; i++)
+    {
+        json += std::to_string(frame.channel(i)) + (i < 8 ? "," : "],");
+    }
+    json += "\"frame\":{\"atime\":" + std::to_string(frame.atime) + ",";
+    json += "\"astep\":" + std::to_string(frame.astep) + ",";
+    json += "\"integration_us\":" + std::to_string(frame.integrationMicros()) + ",";
+    json += "\"saturated\":" + std::string(frame.saturated() ? "true" : "false") + ",";
+    json += "\"timestamps_us\":[" + std::to_string(frame.phaseMicros[0]) + "," + std::to_string(frame.phaseMicros[1]) + "],";
+    uint32_t counts[SPECTRAL_PHASES][SPECTRAL_ADCS];
+    basic.normalise(frame, counts);
+    json += "\"basic\":[";
+    for (int i = 0; i < 9; i++)
+    {
+        json += fixed(BasicCounts::toFloat(counts[i / 4 < 2 ? i / 4 : 1][i < 8 ? i % 4 : SPECTRAL_ADC_NIR]), 4) +
+                (i < 8 ? "," : "],");
+    }
+    const ColorResult &color = colorimetry.compute(frame);
+    json += "\"color\":{\"valid\":" + std::string(color.valid ? "true" : "false") + ",\"lux\":" + fixed(color.lux, 2) +
+            ",\"cct\":" + fixed(color.cct, 0) + ",\"duv\":" + fixed(color.duv, 4) + ",\"x\":" + fixed(color.x, 4) +
+            ",\"y\":" + fixed(color.y, 4) + "}},";
+    json += "\"sequence\":" + std::to_string(frame.sequence) + ",\"sync_mode\":\"spm\"}";
+    return json;
+}
+
+// JsonWriter against concatenation on the same document: heap allocations
+// and time per reply, and its decimals against printf's
+static void jsonRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    sensor.apply(SensorConfig());
+    captureFrame(acquisition);
+    const SpectralFrame &frame = acquisition.latest();
+    BasicCounts basic;
+    Colorimetry colorimetry;
+    colorimetry.begin();
+
+    static char buffer[1024];
+    const int rounds = 100000;
+    uint64_t before = heapAllocations;
+    auto start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    for (int i = 0; i < rounds; i++)
+    {
+        length = frameJson(frame, basic, colorimetry, buffer, sizeof(buffer));
+    }
+    auto middle = std::chrono::steady_clock::now();
+    uint64_t writerAllocations = heapAllocations - before;
+    size_t stringLength = 0;
+    for (int i = 0; i < rounds; i++)
+    {
+        stringLength = frameString(frame, basic, colorimetry).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    uint64_t stringAllocations = heapAllocations - before - writerAllocations;
+    bool same = frameString(frame, basic, colorimetry) == std::string(buffer, length);
+
+    // Decimals against printf over values of all magnitudes
+    uint32_t seed = 1;
+    int differ = 0;
+    double worst = 0.0;
+    for (int i = 0; i < 100000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        float value = ((int32_t)seed / 2147483648.0f) * powf(10.0f, (float)(i % 8) - 2.0f);
+        uint8_t decimals = i % 5;
+        char ours[24];
+        JsonWriter json(ours, sizeof(ours));
+        json.addFloat(NULL, value, decimals);
+        std::string theirs = fixed(value, decimals);
+        if (theirs[0] == '-' && theirs.find_first_not_of("-0.") == std::string::npos)
+        {
+            theirs.erase(0, 1); // printf keeps the sign of a negative zero
+        }
+        if (theirs != ours)
+        {
+            differ++;
+            double unit = atof(theirs.c_str()) - atof(ours);
+            worst = std::max(worst, fabs(unit) * pow(10.0, decimals));
+        }
+    }
+    printf("json: %u bytes, %.0f ns and %.1f allocations per reply; concatenated %.0f ns and %.1f allocations, "
+           "output %s\n",
+           (unsigned)length, std::chrono::duration<double, std::nano>(middle - start).count() / rounds,
+           (double)writerAllocations / rounds, std::chrono::duration<double, std::nano>(end - middle).count() / rounds,
+           (double)stringAllocations / rounds, same && length == stringLength ? "identical" : "DIFFERENT");
+    printf("json: decimals differ from printf in %d of 100000 values, by at most %.0f in the last place\n", differ,
+           worst);
+}
+
+// Same sequence as takeMeasurement() in the sketch
+static void twoPhaseSpectrum(AS7341 &sensor, uint16_t *spectrum)
+{
+    sensor.setATime(29);
+    sensor.setGain(4);
+    sensor.enableLED(true);
+    sensor.setLEDCurrent(25);
+
+    uint16_t channelData1[6];
+    uint16_t channelData2[6];
+    sensor.startMeasure("F1F4CN");
+    sensor.getSpectralData(channelData1);
+    sensor.startMeasure("F5F8CN");
+    sensor.getSpectralData(channelData2);
+    sensor.enableLED(false);
+
+    for (int i = 0; i < 4; i++)
+    {
+        spectrum[i] = channelData1[i];
+        spectrum[i + 4] = channelData2[i];
+    }
+    spectrum[8] = channelData2[5];
+}
+
+// Frame events carry the frame part of /data
+static Acquisition *eventAcquisition;
+static BasicCounts eventBasic;
+static Colorimetry eventColorimetry;
+
+static size_t eventData(char *buffer, size_t size)
+{
+    return frameJson(eventAcquisition->latest(), eventBasic, eventColorimetry, buffer, size);
+}
+
+// Reads whatever reached the browser's end and counts the frame events
+static uint32_t browserRead(int browser, std::string &pending)
+{
+    char chunk[1024];
+    ssize_t got;
+    while ((got = recv(browser, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0)
+    {
+        pending.append(chunk, got);
+    }
+    uint32_t events = 0;
+    size_t at;
+    while ((at = pending.find("\n\n")) != std::string::npos)
+    {
+        events += pending.compare(0, 3, "id:") == 0 ? 1 : 0;
+        pending.erase(0, at + 2);
+    }
+    return events;
+}
+
+// Continuous frames at 'periodMs' pushed to two event streams the way
+// loop() does it, while the second browser never reads. With 'blocking'
+// the stalled browser is written with WiFiClient::write() instead, as
+// the streams were before. Returns the mean frame interval in ms, from
+// the fifth frame on while the wait timer trims in.
+static float eventsCase(Acquisition &acquisition, uint32_t periodMs, int frames, bool blocking, uint32_t &received,
+                        uint32_t &dropped, uint64_t &longestUs)
+{
+    static char buffer[2048];
+    static const char request[] = "GET /events HTTP/1.1\r\nHost: spectrometer\r\n\r\n";
+    WiFiServer server(81);
+    WiFiServer plain(82);
+    EventStreams events(server, buffer, sizeof(buffer));
+    events.begin();
+    int reader = server.hostConnect();
+    send(reader, request, sizeof(request) - 1, 0);
+    int stalled = blocking ? plain.hostConnect() : server.hostConnect();
+    WiFiClient stalledClient = blocking ? plain.available() : WiFiClient();
+    if (!blocking)
+    {
+        send(stalled, request, sizeof(request) - 1, 0);
+    }
+    std::string pending;
+
+    acquisition.setContinuous(true, periodMs);
+    acquisition.start();
+    unsigned long first = 0;
+    unsigned long last = 0;
+    int published = 0;
+    received = 0;
+    longestUs = 0;
+    while (published < frames + 5)
+    {
+        uint64_t stepStart = hostMicros();
+        if (events.service())
+        {
+            events.push(acquisition.latest().sequence, eventData);
+        }
+        if (acquisition.update())
+        {
+            events.push(acquisition.latest().sequence, eventData);
+            if (blocking)
+            {
+                size_t length = eventData(buffer, sizeof(buffer));
+                stalledClient.write((const uint8_t *)buffer, length);
+            }
+            unsigned long now = micros();
+            first = ++published <= 5 ? now : first;
+            last = now;
+        }
+        uint64_t stepUs = hostMicros() - stepStart;
+        longestUs = stepUs > longestUs ? stepUs : longestUs;
+        received += browserRead(reader, pending);
+        delay(1);
+    }
+    acquisition.setContinuous(false, periodMs);
+    while (acquisition.busy())
+    {
+        acquisition.update();
+        delay(1);
+    }
+    dropped = events.dropped();
+    stalledClient.stop();
+    close(reader);
+    close(stalled);
+    return (last - first) / 1000.0f / frames;
+}
+
+// A phone whose TCP window stalls must not slow the acquisition: its
+// stream is dropped once the socket buffer is full, and the other stream
+// keeps every frame
+static void eventsRun(AS7341 &sensor, Acquisition &acquisition)
+{
+    signal(SIGPIPE, SIG_IGN); // lwIP reports a closed peer as an error, not a signal
+    sensor.apply(SensorConfig());
+    eventAcquisition = &acquisition;
+    eventColorimetry.begin();
+    const uint32_t periodMs = 200;
+    const int frames = 40;
+    uint32_t received;
+    uint32_t dropped;
+    uint64_t longestUs;
+    float mean = eventsCase(acquisition, periodMs, frames, false, received, dropped, longestUs);
+    // The reader also gets the frame current when it connected
+    printf("events, one browser stalled: %d frames at %lu ms, mean interval %.1f ms, longest iteration %llu us, "
+           "%lu of %d events read, %lu stream(s) dropped\n",
+           frames, (unsigned long)periodMs, mean, (unsigned long long)longestUs, (unsigned long)received, frames + 6,
+           (unsigned long)dropped);
+    mean = eventsCase(acquisition, periodMs, 20, true, received, dropped, longestUs);
+    printf("events, blocking write() to the stalled browser instead: mean interval %.1f ms, longest iteration "
+           "%llu us\n",
+           mean, (unsigned long long)longestUs);
+}
+
+int main()
+{
+    Wire.attach(&device);
+    Wire.begin();
+
+    AS7341 sensor(Wire);
+    Meter meter;
+    uint16_t data[6];
+    uint16_t spectrum[9];
+
+    printf("AS7341 driver bus cost (I2C at 100 kHz, simulated device)\n\n");
+    printHeader();
+
+    meter.start();
+    bool ok = sensor.begin();
+    printCost("begin", meter.stop());
+    if (!ok)
+    {
+        printf("begin() failed\n");
+        return 1;
+    }
+
+    meter.start();
+    sensor.setMeasureMode(AS7341_MODE_SPM);
+    sensor.setATime(29);
+    sensor.setAStep(599);
+    sensor.setGain(4);
+    printCost("configure", meter.stop());
+
+    SensorConfig config;
+    meter.start();
+    uint8_t written = sensor.apply(config);
+    printCost("apply(config)", meter.stop());
+    printf("  %u register(s) written\n", written);
+
+    meter.start();
+    written = sensor.apply(config);
+    printCost("apply(config), unchanged", meter.stop());
+    printf("  %u register(s) written\n", written);
+
+    config.atime = 39;
+    config.wtime = 10;
+    config.thresholdLow = 100;
+    config.thresholdHigh = 60000;
+    config.astep = 999;
+    meter.start();
+    written = sensor.apply(config);
+    printCost("apply(config), 5 fields", meter.stop());
+    printf("  %u register(s) written\n", written);
+    config = SensorConfig();
+    sensor.apply(config);
+
+    meter.start();
+    sensor.startMeasure("F1F4CN");
+    printCost("startMeasure(F1F4CN)", meter.stop());
+
+    meter.start();
+    sensor.getSpectralData(data);
+    printCost("getSpectralData", meter.stop());
+
+    meter.start();
+    twoPhaseSpectrum(sensor, spectrum);
+    printCost("two-phase spectrum", meter.stop());
+
+    meter.start();
+    twoPhaseSpectrum(sensor, spectrum);
+    printCost("two-phase spectrum (again)", meter.stop());
+
+    device.scene().flickerHz = 100.0f;
+    device.scene().flickerDepth = 0.3f;
+    meter.start();
+    uint8_t flicker = sensor.getFlickerFrequency();
+    printCost("getFlickerFrequency", meter.stop());
+    device.scene().flickerDepth = 0.0f;
+
+    meter.start();
+    twoPhaseSpectrum(sensor, spectrum);
+    printCost("two-phase after flicker", meter.stop());
+
+    uint32_t polls = sensor.getCompletionPolls();
+    device.connectInterrupt(INT_PIN);
+    sensor.enableMeasurementInterrupt(INT_PIN);
+    meter.start();
+    twoPhaseSpectrum(sensor, spectrum);
+    printCost("two-phase, INT completion", meter.stop());
+    printf("\ncompletion: %lu polls before INT, %lu INT wake-ups, %lu polls, %lu timeouts with INT\n",
+           (unsigned long)polls, (unsigned long)sensor.getInterruptWakeups(),
+           (unsigned long)(sensor.getCompletionPolls() - polls), (unsigned long)sensor.getInterruptTimeouts());
+    sensor.disableMeasurementInterrupt();
+
+    // Non-blocking capture driven the way loop() does: update(), then yield 1 ms
+    Acquisition acquisition(sensor);
+    uint64_t longestStepUs = 0;
+    uint32_t iterations = 0;
+    meter.start();
+    acquisition.start();
+    while (true)
+    {
+        uint64_t stepStart = hostMicros();
+        bool published = acquisition.update();
+        uint64_t stepUs = hostMicros() - stepStart;
+        longestStepUs = stepUs > longestStepUs ? stepUs : longestStepUs;
+        iterations++;
+        if (published || !acquisition.busy())
+        {
+            break;
+        }
+        delay(1);
+    }
+    printCost("two-phase, non-blocking", meter.stop());
+    printf("non-blocking: %lu loop iterations, longest update() %llu us, %lu errors\n",
+           (unsigned long)iterations, (unsigned long long)longestStepUs, (unsigned long)acquisition.errors());
+    const SpectralFrame &frame = acquisition.latest();
+    for (int i = 0; i < 9; i++)
+    {
+        spectrum[i] = frame.channel(i);
+    }
+    printf("frame #%lu: %u bytes, ATIME %u ASTEP %u, gain code %u/%u, clear %u/%u, %s, phases %lu us apart\n",
+           (unsigned long)frame.sequence, (unsigned)sizeof(SpectralFrame), frame.atime, frame.astep,
+           frame.gain(0), frame.gain(1), frame.clear(0), frame.clear(1),
+           frame.saturated() ? "saturated" : "not saturated",
+           (unsigned long)(frame.phaseMicros[1] - frame.phaseMicros[0]));
+
+    // Continuous mode: the wait timer paces frames, one SMUX switch per frame
+    const uint32_t frames = 10;
+    const uint32_t periodMs = 200;
+    uint32_t smux = device.smuxCommands;
+    uint32_t firstSequence = acquisition.sequence();
+    uint64_t firstFrameUs = 0;
+    uint64_t lastFrameUs = 0;
+    longestStepUs = 0;
+    acquisition.setContinuous(true, periodMs);
+    acquisition.start();
+    meter.start();
+    while (acquisition.sequence() - firstSequence < frames + 1 && acquisition.busy())
+    {
+        uint64_t stepStart = hostMicros();
+        bool published = acquisition.update();
+        uint64_t stepUs = hostMicros() - stepStart;
+        longestStepUs = stepUs > longestStepUs ? stepUs : longestStepUs;
+        if (published)
+        {
+            // Measure from the first frame so start-up is excluded
+            if (acquisition.sequence() - firstSequence == 1)
+            {
+                firstFrameUs = hostMicros();
+                smux = device.smuxCommands;
+                meter.start();
+            }
+            lastFrameUs = hostMicros();
+        }
+        delay(1);
+    }
+    Cost perFrame = meter.stop();
+    acquisition.setContinuous(false, periodMs);
+    perFrame.transactions /= frames;
+    perFrame.bytes /= frames;
+    perFrame.busUs /= frames;
+    perFrame.blockedUs /= frames;
+    perFrame.elapsedUs /= frames;
+    printCost("continuous, per frame", perFrame);
+    printf("continuous: %lu frames at %lu ms, mean interval %llu us, %.1f SMUX/frame, "
+           "longest update() %llu us, %u in ring, %lu errors\n",
+           (unsigned long)frames, (unsigned long)periodMs,
+           (unsigned long long)((lastFrameUs - firstFrameUs) / frames),
+           (double)(device.smuxCommands - smux) / frames, (unsigned long long)longestStepUs,
+           acquisition.frames().count(), (unsigned long)acquisition.errors());
+
+    // External sync. SYNS: one edge from our own trigger pin starts the
+    // integration; the same edge would fire a pulsed light source.
+    device.connectSync(SYNC_PIN);
+    sensor.setSyncTriggerPin(SYNC_PIN);
+    sensor.setMeasureMode(AS7341_MODE_SYNS);
+    meter.start();
+    sensor.beginMeasure("F1F4CN");
+    uint8_t syncState = pollUntil(sensor, AS7341_MEASURE_WAIT_SYNC);
+    delay(5);
+    uint64_t edgeUs = hostMicros();
+    sensor.triggerSync();
+    syncState = pollUntil(sensor, AS7341_MEASURE_READY);
+    sensor.result(data);
+    printCost("SYNS, triggered", meter.stop());
+    printf("SYNS: edge to integration start %lld us, state %u\n",
+           (long long)(device.lastSyncStart - edgeUs), syncState);
+
+    // SYNS from an external strobe: the driver only sees STAT.WAIT_SYNC
+    sensor.setSyncTriggerPin(AS7341_INT_PIN_NONE);
+    meter.start();
+    sensor.beginMeasure("F1F4CN");
+    pollUntil(sensor, AS7341_MEASURE_WAIT_SYNC);
+    delay(20);
+    edgeUs = hostMicros();
+    hostDrivePin(SYNC_PIN, LOW);
+    delayMicroseconds(AS7341_SYNC_PULSE_US);
+    hostDrivePin(SYNC_PIN, HIGH);
+    syncState = pollUntil(sensor, AS7341_MEASURE_READY);
+    uint64_t readyUs = hostMicros();
+    sensor.result(data);
+    printCost("SYNS, external strobe", meter.stop());
+    printf("SYNS external: ready %llu us after the edge (integration %lu us), state %u\n",
+           (unsigned long long)(readyUs - edgeUs), (unsigned long)(sensor.getIntegrationTime() * 1000), syncState);
+
+    // SYND: integration gated by 1 kHz strobe edges, 20 periods
+    sensor.setSyncTriggerPin(SYNC_PIN);
+    sensor.setMeasureMode(AS7341_MODE_SYND);
+    sensor.setSyncEdges(20);
+    meter.start();
+    sensor.beginMeasure("F1F4CN");
+    pollUntil(sensor, AS7341_MEASURE_WAIT_SYNC);
+    for (int edge = 0; edge <= 20; edge++)
+    {
+        sensor.triggerSync();
+        if (edge < 20)
+        {
+            delayMicroseconds(1000 - AS7341_SYNC_PULSE_US);
+        }
+    }
+    syncState = pollUntil(sensor, AS7341_MEASURE_READY);
+    sensor.result(data);
+    printCost("SYND, 20 edges", meter.stop());
+    printf("SYND: integration %lu us by ITIME, %lu synced captures, %lu edges seen by sensor, state %u\n",
+           (unsigned long)sensor.getSyncIntegrationMicros(), (unsigned long)sensor.getSyncCaptures(),
+           (unsigned long)device.syncEdges, syncState);
+    sensor.setMeasureMode(AS7341_MODE_SPM);
+
+    // SYND as the sketch runs it with syncTriggerPin set: the acquisition
+    // opens each phase on arming and the driver issues the closing edges
+    SensorConfig synd;
+    synd.mode = AS7341_MODE_SYND;
+    sensor.apply(synd);
+    sensor.setSyncEdges(4);
+    sensor.setSyncTimeout(5000);
+    acquisition.setSyncTrigger(true);
+    uint32_t syndErrors = acquisition.errors();
+    uint32_t syndEdges = device.syncEdges;
+    meter.start();
+    bool syndCaptured = captureFrame(acquisition);
+    printCost("SYND, own edges, frame", meter.stop());
+    printf("SYND own edges: %s, integration %lu us by ITIME (programmed %lu us), %lu edges, %lu errors\n",
+           syndCaptured ? "captured" : "NOT CAPTURED", (unsigned long)sensor.getSyncIntegrationMicros(),
+           (unsigned long)acquisition.latest().integrationMicros(), (unsigned long)(device.syncEdges - syndEdges),
+           (unsigned long)(acquisition.errors() - syndErrors));
+    acquisition.setSyncTrigger(false);
+    sensor.setSyncEdges(1);
+    sensor.setSyncTimeout(0);
+    sensor.apply(SensorConfig());
+
+    // Auto-exposure from the default 8x / ATIME 29 in three scenes
+    autoExposureRun(sensor, acquisition, "auto-exposure, normal", 1.0f);
+    autoExposureRun(sensor, acquisition, "auto-exposure, dim", 0.01f);
+    autoExposureRun(sensor, acquisition, "auto-exposure, bright", 10.0f);
+    autoExposureRun(sensor, acquisition, "auto-exposure, too bright", 50.0f);
+    device.scene() = SimAS7341::defaultScene();
+
+    hdrRun(sensor, acquisition);
+    normalisationRun(sensor);
+    sensor.apply(SensorConfig());
+    settingsChangeRun(sensor, acquisition);
+    reconstructionRun(acquisition);
+    colorimetryRun(sensor, acquisition);
+    darkRun(sensor, acquisition);
+    averageRun(sensor, acquisition);
+    flickerRun(sensor);
+    flickerInterleaveRun(sensor, acquisition);
+    flickerLockRun(sensor, acquisition);
+    logRun();
+    metricsRun(sensor, acquisition);
+    packRun(sensor, acquisition);
+    jsonRun(sensor, acquisition);
+    eventsRun(sensor, acquisition);
+    sensor.apply(SensorConfig());
+
+    printf("spectrum:");
+    for (int i = 0; i < 9; i++)
+    {
+        printf(" %u", spectrum[i]);
+    }
+    printf("\nflicker: %u Hz\n", flicker);
+    printf("driver-reported blocked time, last call: %lu us\n", (unsigned long)sensor.getLastBlockedMicros());
+
+    if (device.protocolErrors() > 0)
+    {
+        printf("\n%u protocol error(s):\n", device.protocolErrors());
+        for (uint8_t i = 0; i < device.protocolErrors() && i < SIM_AS7341_MAX_ERRORS; i++)
+        {
+            printf("  %s\n", device.protocolError(i));
+        }
+        return 1;
+    }
+    return 0;
+}
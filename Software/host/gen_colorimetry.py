@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+Generates ColorimetryTables.h: the tables the firmware uses for CIE XYZ,
+chromaticity and correlated colour temperature.
+
+The channel-to-XYZ matrix is the CIE 1931 2 degree colour matching
+functions applied to the reconstructed spectrum, folded into one 3 x 9
+matrix: XYZ = CMF R, with R the Wiener reconstruction of
+gen_reconstruction.py (taken before quantisation). XYZ come out in basic
+counts; the firmware scales them to lux.
+
+The colour matching functions are the multi-lobe Gaussian fit of Wyman,
+Sloan and Shirley (JCGT 2013), within a few percent of the tabulated
+data; substitute the CIE tables for a calibrated instrument.
+
+The CCT table holds Robertson-style isotemperature lines: points of the
+Planckian locus in CIE 1960 (u, v) at equal steps in mired, with the unit
+tangent of the locus there. The firmware finds the pair of lines the
+chromaticity falls between and interpolates, with no iteration.
+
+Usage: python3 gen_colorimetry.py [mired_step] > ../arduino/ColorimetryTables.h
+"""
+
+import math
+import sys
+
+from gen_reconstruction import RESPONSES, wiener_matrix
+
+MIRED_MAX = 1000  # 1000 K
+C2 = 1.4388e-2    # Second radiation constant, m K
+
+# (weight, centre nm, sigma below, sigma above) per lobe
+CMF_LOBES = [
+    [(1.056, 599.8, 37.9, 31.0), (0.362, 442.0, 16.0, 26.7), (-0.065, 501.1, 20.4, 26.2)],
+    [(0.821, 568.8, 46.9, 40.5), (0.286, 530.9, 16.3, 31.1)],
+    [(1.217, 437.0, 11.8, 36.0), (0.681, 459.0, 26.0, 13.8)],
+]
+
+
+def cmf(i, nm):
+    total = 0.0
+    for weight, centre, below, above in CMF_LOBES[i]:
+        sigma = below if nm < centre else above
+        total += weight * math.exp(-0.5 * ((nm - centre) / sigma) ** 2)
+    return total
+
+
+def planck(nm, mired):
+    """Relative spectral radiance; mired 0 is the infinite-temperature limit."""
+    metres = nm * 1e-9
+    if mired == 0:
+        return metres ** -4
+    return metres ** -5 / math.expm1(C2 * mired * 1e-6 / metres)
+
+
+def locus_uv(mired):
+    x = y = z = 0.0
+    for nm in range(360, 831):
+        s = planck(nm, mired)
+        x += cmf(0, nm) * s
+        y += cmf(1, nm) * s
+        z += cmf(2, nm) * s
+    d = x + 15 * y + 3 * z
+    return 4 * x / d, 6 * y / d
+
+
+def main():
+    step = int(sys.argv[1]) if len(sys.argv) > 1 else 10
+    wavelengths, m = wiener_matrix(5)
+    bin_nm = wavelengths[1] - wavelengths[0]
+    channels = len(RESPONSES)
+
+    xyz = [[sum(cmf(i, w) * bin_nm * m[b][c] for b, w in enumerate(wavelengths)) for c in range(channels)]
+           for i in range(3)]
+
+    lines = []
+    for mired in range(0, MIRED_MAX + 1, step):
+        u, v = locus_uv(mired)
+        lo, hi = max(mired - 0.5, 0), mired + 0.5
+        u0, v0 = locus_uv(lo)
+        u1, v1 = locus_uv(hi)
+        length = math.hypot(u1 - u0, v1 - v0)
+        lines.append((mired, u, v, (u1 - u0) / length, (v1 - v0) / length))
+
+    out = sys.stdout
+    out.write("// Generated by Software/host/gen_colorimetry.py - do not edit.\n")
+    out.write("//\n")
+    out.write("// F1-F8, NIR basic counts to CIE 1931 XYZ through the %d-%d nm\n" % (wavelengths[0], wavelengths[-1]))
+    out.write("// reconstruction, and the Planckian locus in CIE 1960 (u, v) every\n")
+    out.write("// %d mired up to %d K with its unit tangent (towards higher mired).\n" % (step, 1000000 // MIRED_MAX))
+    out.write("#ifndef COLORIMETRY_TABLES_H\n")
+    out.write("#define COLORIMETRY_TABLES_H\n\n")
+    out.write("#include <Arduino.h>\n\n")
+    out.write("#define COLOR_CHANNELS %d\n" % channels)
+    out.write("#define COLOR_MIRED_STEP %d\n" % step)
+    out.write("#define COLOR_LOCUS_POINTS %d\n\n" % len(lines))
+    out.write("const float colorXyzMatrix[3][COLOR_CHANNELS] PROGMEM = {\n")
+    for i, name in enumerate("XYZ"):
+        out.write("    {" + ", ".join("%.6ef" % v for v in xyz[i]) + "}, // %s\n" % name)
+    out.write("};\n\n")
+    out.write("// mired, u, v, du, dv\n")
+    out.write("const float colorLocus[COLOR_LOCUS_POINTS][5] PROGMEM = {\n")
+    for mired, u, v, du, dv in lines:
+        out.write("    {%d, %.6ff, %.6ff, %.6ff, %.6ff},\n" % (mired, u, v, du, dv))
+    out.write("};\n\n")
+    out.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main()
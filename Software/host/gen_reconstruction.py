@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+Generates ReconstructionMatrix.h: the matrix that maps the nine AS7341
+channel readings (F1-F8, NIR, in basic counts) to a dense spectrum.
+
+The channel responses are modelled as Gaussians with the nominal centre
+wavelengths and FWHM of the datasheet, all with the same peak
+responsivity. The matrix is the linear minimum mean square error (Wiener)
+estimate for a smooth spectrum:
+
+    M = P R^T (R P R^T + lambda I)^-1
+
+with R the 9 x N channel response, P a Gaussian covariance between
+wavelength bins (correlation length CORRELATION_NM) and lambda a small
+regulariser. Replace RESPONSES with measured curves for a calibrated
+instrument.
+
+The matrix is written column-major (one column of N bins per channel,
+padded to a multiple of 8 bins) as int16 with COEF_FRAC_BITS fraction
+bits, chosen so that no bin's sum of absolute coefficients exceeds 2^16.
+With inputs limited to 2^14 the int32 accumulator then cannot overflow.
+
+Usage: python3 gen_reconstruction.py [step_nm] > ../arduino/ReconstructionMatrix.h
+"""
+
+import math
+import sys
+
+START_NM = 380
+END_NM = 1000
+CORRELATION_NM = 30.0
+REGULARISATION = 1e-2
+BIN_ALIGN = 8
+ACC_LIMIT = 1 << 16
+
+# (centre nm, FWHM nm) for F1-F8 and NIR, in the firmware's channel order
+RESPONSES = [
+    (415, 26), (445, 30), (480, 36), (515, 39),
+    (555, 39), (590, 40), (630, 50), (680, 52),
+    (940, 60),
+]
+
+
+def solve(a, b):
+    """Solves a x = b for square a by Gauss-Jordan elimination."""
+    n = len(a)
+    m = [row[:] + [b[i]] for i, row in enumerate(a)]
+    for col in range(n):
+        pivot = max(range(col, n), key=lambda r: abs(m[r][col]))
+        m[col], m[pivot] = m[pivot], m[col]
+        for r in range(n):
+            if r != col:
+                f = m[r][col] / m[col][col]
+                for c in range(col, n + 1):
+                    m[r][c] -= f * m[col][c]
+    return [m[i][n] / m[i][i] for i in range(n)]
+
+
+def wiener_matrix(step):
+    """Returns the bin wavelengths and the N x 9 reconstruction matrix."""
+    wavelengths = list(range(START_NM, END_NM + 1, step))
+    bins = len(wavelengths)
+    channels = len(RESPONSES)
+
+    # Channel response per bin, integrated over the bin width
+    r = []
+    for centre, fwhm in RESPONSES:
+        sigma = fwhm / (2 * math.sqrt(2 * math.log(2)))
+        r.append([math.exp(-0.5 * ((w - centre) / sigma) ** 2) * step for w in wavelengths])
+
+    p = [[math.exp(-0.5 * ((wi - wj) / CORRELATION_NM) ** 2) for wj in wavelengths] for wi in wavelengths]
+
+    # R P (9 x N), then R P R^T + lambda I (9 x 9)
+    rp = [[sum(r[k][i] * p[i][j] for i in range(bins)) for j in range(bins)] for k in range(channels)]
+    g = [[sum(rp[k][i] * r[l][i] for i in range(bins)) for l in range(channels)] for k in range(channels)]
+    scale = sum(g[k][k] for k in range(channels)) / channels
+    for k in range(channels):
+        g[k][k] += REGULARISATION * scale
+
+    # M = (R P)^T G^-1, column by column of G^-1 (G is symmetric)
+    m = [[0.0] * channels for _ in range(bins)]
+    for l in range(channels):
+        e = [1.0 if i == l else 0.0 for i in range(channels)]
+        column = solve(g, e)
+        for b in range(bins):
+            m[b][l] = sum(rp[k][b] * column[k] for k in range(channels))
+    return wavelengths, m
+
+
+def main():
+    step = int(sys.argv[1]) if len(sys.argv) > 1 else 5
+    wavelengths, m = wiener_matrix(step)
+    bins = len(wavelengths)
+    channels = len(RESPONSES)
+
+    # Largest fraction width that keeps coefficients in int16 and each
+    # bin's accumulator within ACC_LIMIT times the input range
+    worst_sum = max(sum(abs(v) for v in row) for row in m)
+    worst = max(abs(v) for row in m for v in row)
+    frac = 0
+    while worst_sum * (1 << (frac + 1)) <= ACC_LIMIT and worst * (1 << (frac + 1)) < 32767:
+        frac += 1
+
+    padded = (bins + BIN_ALIGN - 1) // BIN_ALIGN * BIN_ALIGN
+
+    out = sys.stdout
+    out.write("// Generated by Software/host/gen_reconstruction.py - do not edit.\n")
+    out.write("//\n")
+    out.write("// Channels (F1-F8, NIR in basic counts) to a %d-%d nm spectrum in\n" % (START_NM, wavelengths[-1]))
+    out.write("// %d nm bins (basic counts per nm), Wiener estimate from nominal\n" % step)
+    out.write("// Gaussian channel responses. Column-major: RECON_BINS_PADDED coefficients\n")
+    out.write("// per channel, Q%d.\n" % frac)
+    out.write("#ifndef RECONSTRUCTION_MATRIX_H\n")
+    out.write("#define RECONSTRUCTION_MATRIX_H\n\n")
+    out.write("#include <Arduino.h>\n\n")
+    out.write("#define RECON_START_NM %d\n" % START_NM)
+    out.write("#define RECON_STEP_NM %d\n" % step)
+    out.write("#define RECON_BINS %d\n" % bins)
+    out.write("#define RECON_BINS_PADDED %d\n" % padded)
+    out.write("#define RECON_CHANNELS %d\n" % channels)
+    out.write("#define RECON_COEF_FRAC_BITS %d\n\n" % frac)
+    out.write("const int16_t reconMatrix[RECON_CHANNELS * RECON_BINS_PADDED] PROGMEM = {\n")
+    for l in range(channels):
+        out.write("    // %s\n" % ("F%d" % (l + 1) if l < 8 else "NIR"))
+        values = [int(round(m[b][l] * (1 << frac))) if b < bins else 0 for b in range(padded)]
+        for i in range(0, padded, 12):
+            out.write("    " + " ".join("%d," % v for v in values[i:i + 12]) + "\n")
+    out.write("};\n\n")
+    out.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Generates WebAssets.h: the web UI from html_content.h, gzip-compressed,
+for the firmware to serve as it is stored.
+
+The page is taken from the index_html raw string literal and compressed
+at the highest level with a zero timestamp, so the output only changes
+when the page does. The ETag is the start of the SHA-256 of the
+uncompressed page.
+
+Usage: python3 gen_web_assets.py [html_content.h] > ../arduino/WebAssets.h
+"""
+
+import gzip
+import hashlib
+import sys
+
+OPEN = 'R"rawliteral('
+CLOSE = ')rawliteral"'
+
+
+def page(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    start = text.index(OPEN) + len(OPEN)
+    return text[start:text.index(CLOSE, start)].encode("utf-8")
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else "../arduino/html_content.h"
+    html = page(path)
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(html).hexdigest()[:16]
+
+    out = sys.stdout
+    out.write("// Generated by Software/host/gen_web_assets.py - do not edit.\n")
+    out.write("//\n")
+    out.write("// index_html from html_content.h, %d bytes gzip-compressed to %d.\n" % (len(html), len(data)))
+    out.write("#ifndef WEB_ASSETS_H\n")
+    out.write("#define WEB_ASSETS_H\n\n")
+    out.write("#include <Arduino.h>\n\n")
+    out.write("#define INDEX_HTML_GZ_SIZE %d\n" % len(data))
+    out.write("#define INDEX_HTML_ETAG \"\\\"%s\\\"\"\n\n" % etag)
+    out.write("const uint8_t index_html_gz[INDEX_HTML_GZ_SIZE] PROGMEM = {\n")
+    for i in range(0, len(data), 16):
+        out.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+    out.write("};\n\n")
+    out.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main()
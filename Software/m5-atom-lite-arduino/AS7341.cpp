@@ -14,20 +14,48 @@ AS7341::AS7341(TwoWire &wire)
     _connected = false;
     _currentGain = 4;   // Default gain code (factor 8)
     _currentATime = 29; // Default ATIME
+    _callBlockedUs = 0;
+    _lastBlockedUs = 0;
+    _totalBlockedUs = 0;
+    _callDepth = 0;
+    _interruptPin = AS7341_INT_PIN_NONE;
+    _interruptPending = false;
+    _interruptWakeups = 0;
+    _interruptTimeouts = 0;
+    _completionPolls = 0;
+    _interruptMissed = false;
+    _measureState = AS7341_MEASURE_IDLE;
+    _measureStart = 0;
+    _nextPollAt = 0;
+    _integrationUs = 0;
+    _syncEdges = 1;
+    _syncEdgesSeen = 0;
+    _syncTimeoutMs = 0;
+    _syncTriggerPin = AS7341_INT_PIN_NONE;
+    _syncIntegrationUs = 0;
+    _syncCaptures = 0;
+    _smuxSkips = 0;
+    _timing = NULL;
+    _timingArg = NULL;
+    invalidateCache();
 }
 
 bool AS7341::begin()
 {
+    BlockingScope scope(this);
+
+    // Register contents are unknown until we have written or read them
+    invalidateCache();
+
     // Cycle power and check if AS7341 is connected
     disable();
-    delay(50);
 
     // Power on
     if (!writeByte(AS7341_ENABLE, AS7341_ENABLE_PON))
     {
         return false;
     }
-    delay(50);
+    sleepMicros(AS7341_PON_SETTLE_US);
 
     // Check device ID
     uint8_t id = readByte(AS7341_ID);
@@ -51,9 +79,10 @@ void AS7341::disable()
 {
     // Disable all functions and power off
     setBank(1);
-    writeByte(AS7341_CONFIG, 0x00);
+    writeReg(AS7341_CONFIG, 0x00);
     setBank(0);
-    writeByte(AS7341_ENABLE, 0x00);
+    writeReg(AS7341_ENABLE, 0x00);
+    _smuxLoaded = NULL; // Not known to survive power-down
 }
 
 void AS7341::setMeasureMode(uint8_t mode)
@@ -62,66 +91,83 @@ void AS7341::setMeasureMode(uint8_t mode)
     {
         _measureMode = mode;
         setBank(1);
-        uint8_t data = readByte(AS7341_CONFIG) & (~0x03);
+        uint8_t data = readReg(AS7341_CONFIG) & (~0x03);
         data |= mode;
-        writeByte(AS7341_CONFIG, data);
+        writeReg(AS7341_CONFIG, data);
         setBank(0);
     }
 }
 
+uint8_t AS7341::getMeasureMode()
+{
+    return _measureMode;
+}
+
 void AS7341::setGain(uint8_t gain)
 {
     if (gain <= 10)
     {
         _currentGain = gain;
-        writeByte(AS7341_CFG_1, gain);
+        writeReg(AS7341_CFG_1, gain);
     }
 }
 
 uint8_t AS7341::getAgain()
 {
-    return readByte(AS7341_CFG_1);
+    return readReg(AS7341_CFG_1);
 }
 
 float AS7341::getAgainFactor()
 {
-    uint8_t code = readByte(AS7341_CFG_1);
-    return pow(2, code - 1);
+    // Gain code n is 2^(n-1), code 0 is 0.5x
+    uint8_t code = readReg(AS7341_CFG_1);
+    return code == 0 ? 0.5f : (float)(1UL << (code - 1));
 }
 
 void AS7341::setAgainFactor(float factor)
 {
-    uint8_t code = 0;
-    for (code = 10; code >= 0; code--)
+    // Largest gain not above 'factor', 0.5x at the least
+    uint8_t code = 10;
+    while (code > 0 && (float)(1UL << (code - 1)) > factor)
     {
-        if (pow(2, code - 1) <= factor)
-        {
-            break;
-        }
+        code--;
     }
-    writeByte(AS7341_CFG_1, code);
+    setGain(code);
 }
 
 void AS7341::setATime(uint8_t atime)
 {
     _currentATime = atime;
-    writeByte(AS7341_ATIME, atime);
+    writeReg(AS7341_ATIME, atime);
 }
 
 void AS7341::setAStep(uint16_t astep)
 {
+    if (shadowMatches(AS7341_ASTEP_L, astep & 0xFF) && shadowMatches(AS7341_ASTEP_H, astep >> 8))
+    {
+        return;
+    }
     writeWord(AS7341_ASTEP, astep);
 }
 
+uint8_t AS7341::getATime()
+{
+    return readReg(AS7341_ATIME);
+}
+
+uint16_t AS7341::getAStep()
+{
+    return ((uint16_t)readReg(AS7341_ASTEP_H) << 8) | readReg(AS7341_ASTEP_L);
+}
+
 float AS7341::getIntegrationTime()
 {
-    uint16_t astep = readWord(AS7341_ASTEP);
-    uint8_t atime = readByte(AS7341_ATIME);
-    return ((astep + 1) * (atime + 1) * 2.78 / 1000.0);
+    return integrationMicros() / 1000.0f;
 }
 
 bool AS7341::measurementCompleted()
 {
+    _completionPolls++;
     return (readByte(AS7341_STATUS_2) & AS7341_STATUS_2_AVALID) != 0;
 }
 
@@ -132,62 +178,430 @@ void AS7341::setSpectralMeasurement(bool flag)
 
 void AS7341::setSmux(bool flag)
 {
+    BlockingScope scope(this);
+
     modifyReg(AS7341_ENABLE, AS7341_ENABLE_SMUXEN, flag);
+    if (flag)
+    {
+        // SMUXEN clears itself once the SMUX command has been executed
+        waitSmuxComplete();
+    }
 }
 
-void AS7341::channelSelect(const char *selection)
+const uint8_t *AS7341::smuxConfig(const char *selection)
 {
-    const uint8_t *smuxConfig = NULL;
-
     if (strcmp(selection, "F1F4CN") == 0)
     {
-        smuxConfig = SMUX_F1F4CN;
+        return SMUX_F1F4CN;
     }
     else if (strcmp(selection, "F5F8CN") == 0)
     {
-        smuxConfig = SMUX_F5F8CN;
+        return SMUX_F5F8CN;
     }
     else if (strcmp(selection, "FD") == 0)
     {
-        smuxConfig = SMUX_FD;
+        return SMUX_FD;
     }
-    else
+    return NULL; // Unknown selection
+}
+
+void AS7341::channelSelect(const char *selection)
+{
+    const uint8_t *config = smuxConfig(selection);
+    if (config == NULL)
     {
-        return; // Unknown selection
+        return;
     }
 
-    writeBurst(0x00, smuxConfig, 20);
+    writeBurst(0x00, config, 20);
+    _smuxLoaded = config; // Once the SMUX command that follows has run
+}
+
+SensorConfig::SensorConfig()
+{
+    gain = 4;  // 8x
+    atime = 29;
+    astep = 599; // 1.67 ms
+    wtime = 0;
+    ledCurrent = 25;
+    mode = AS7341_MODE_SPM;
+    thresholdLow = 0;
+    thresholdHigh = 0;
+    persistence = 0;
+}
+
+// Configuration registers covered by apply(), ascending within each bank
+static const uint8_t CONFIG_REGS_BANK0[] = {
+    AS7341_ATIME, AS7341_WTIME,
+    AS7341_SP_TH_L_LSB, AS7341_SP_TH_L_MSB, AS7341_SP_TH_H_LSB, AS7341_SP_TH_H_MSB,
+    AS7341_CFG_1, AS7341_PERS, AS7341_ASTEP_L, AS7341_ASTEP_H};
+static const uint8_t CONFIG_REGS_BANK1[] = {AS7341_CONFIG, AS7341_LED};
+
+uint8_t AS7341::apply(const SensorConfig &config)
+{
+    uint16_t led = config.ledCurrent > 258 ? 258 : (config.ledCurrent < 4 ? 4 : config.ledCurrent);
+
+    uint8_t bank0[] = {
+        config.atime, config.wtime,
+        (uint8_t)(config.thresholdLow & 0xFF), (uint8_t)(config.thresholdLow >> 8),
+        (uint8_t)(config.thresholdHigh & 0xFF), (uint8_t)(config.thresholdHigh >> 8),
+        config.gain <= 10 ? config.gain : readReg(AS7341_CFG_1),
+        (uint8_t)(config.persistence & 0x0F),
+        (uint8_t)(config.astep & 0xFF), (uint8_t)(config.astep >> 8)};
+    uint8_t written = writeDirty(CONFIG_REGS_BANK0, bank0, sizeof(bank0));
+
+    // Bank 1 is only selected when one of its registers actually changes
+    // (or is not known yet)
+    uint8_t mode = config.mode == AS7341_MODE_SYNS || config.mode == AS7341_MODE_SYND ? config.mode : AS7341_MODE_SPM;
+    uint8_t drive = (led - 4) / 2;
+    bool bank1Clean = shadowKnown(AS7341_CONFIG) && shadowKnown(AS7341_LED) &&
+                      shadowMatches(AS7341_CONFIG, (readReg(AS7341_CONFIG) & ~0x03) | mode) &&
+                      shadowMatches(AS7341_LED, (readReg(AS7341_LED) & AS7341_LED_LED_ACT) | drive);
+    if (!bank1Clean)
+    {
+        setBank(1);
+        uint8_t bank1[] = {
+            (uint8_t)((readReg(AS7341_CONFIG) & ~0x03) | mode),
+            (uint8_t)((readReg(AS7341_LED) & AS7341_LED_LED_ACT) | drive)};
+        written += writeDirty(CONFIG_REGS_BANK1, bank1, sizeof(bank1));
+        setBank(0);
+    }
+
+    _measureMode = mode;
+    _currentGain = readReg(AS7341_CFG_1);
+    _currentATime = config.atime;
+    return written;
+}
+
+// Writes the registers whose shadow differs from 'values'. Dirty registers
+// at consecutive addresses go out as one auto-increment burst, bridging
+// clean ones in between with the value the device already holds.
+uint8_t AS7341::writeDirty(const uint8_t *regs, const uint8_t *values, uint8_t count)
+{
+    uint8_t written = 0;
+    uint8_t i = 0;
+    while (i < count)
+    {
+        if (shadowMatches(regs[i], values[i]))
+        {
+            i++;
+            continue;
+        }
+
+        // Extend the run over consecutive addresses up to the last dirty one
+        uint8_t last = i;
+        for (uint8_t j = i + 1; j < count && regs[j] == regs[j - 1] + 1; j++)
+        {
+            if (!shadowMatches(regs[j], values[j]))
+            {
+                last = j;
+            }
+        }
+
+        if (last == i)
+        {
+            writeByte(regs[i], values[i]);
+        }
+        else
+        {
+            writeBurst(regs[i], &values[i], last - i + 1);
+        }
+        written += last - i + 1;
+        i = last + 1;
+    }
+    return written;
 }
 
 void AS7341::startMeasure(const char *selection)
+{
+    BlockingScope scope(this);
+
+    beginMeasure(selection);
+
+    // SPM runs to completion here; in SYNS/SYND the integration waits for
+    // the sync input, so return once it is armed
+    while (true)
+    {
+        uint8_t state = poll();
+        if (state == AS7341_MEASURE_READY || state == AS7341_MEASURE_TIMEOUT || state == AS7341_MEASURE_IDLE)
+        {
+            break;
+        }
+        if (state == AS7341_MEASURE_WAIT_SYNC)
+        {
+            break;
+        }
+        sleepMicros(nextPollMicros());
+    }
+}
+
+// Non-blocking measurement
+//
+// beginMeasure() issues the SMUX command and returns. poll() advances
+// through SMUX completion and integration without waiting, touching the
+// bus only when a completion flag can actually have changed. result()
+// reads the channels once poll() has reported AS7341_MEASURE_READY.
+
+void AS7341::beginMeasure(const char *selection)
 {
     modifyReg(AS7341_CFG_0, AS7341_CFG_0_LOW_POWER, false);
     setSpectralMeasurement(false);
-    writeByte(AS7341_CFG_6, AS7341_CFG_6_SMUX_CMD_WRITE);
 
-    if (_measureMode == AS7341_MODE_SPM)
+    // The SMUX keeps its routing until the next command, so a selection
+    // that is still loaded only needs a new integration
+    const uint8_t *config = smuxConfig(selection);
+    if (config != NULL && config == _smuxLoaded)
     {
-        channelSelect(selection);
-        setSmux(true);
+        _smuxSkips++;
+        startIntegration();
+        return;
     }
-    else if (_measureMode == AS7341_MODE_SYNS)
+
+    writeReg(AS7341_CFG_6, AS7341_CFG_6_SMUX_CMD_WRITE);
+
+    _measureStart = micros();
+    channelSelect(selection);
+    // SMUXEN clears itself once the SMUX command has been executed
+    modifyReg(AS7341_ENABLE, AS7341_ENABLE_SMUXEN, true);
+    _measureState = AS7341_MEASURE_SMUX;
+    _nextPollAt = micros() + AS7341_SMUX_POLL_US;
+}
+
+uint8_t AS7341::poll()
+{
+    unsigned long now = micros();
+    if (_measureState != AS7341_MEASURE_SMUX && _measureState != AS7341_MEASURE_INTEGRATING &&
+        _measureState != AS7341_MEASURE_WAIT_SYNC)
     {
-        channelSelect(selection);
-        setSmux(true);
-        setGpioInput(true);
+        return _measureState;
+    }
+    bool woken = _interruptPin != AS7341_INT_PIN_NONE && _interruptPending;
+    if ((long)(now - _nextPollAt) < 0 && !(woken && _measureState != AS7341_MEASURE_SMUX))
+    {
+        return _measureState; // Nothing can have changed yet
     }
 
-    setSpectralMeasurement(true);
+    if (_measureState == AS7341_MEASURE_WAIT_SYNC)
+    {
+        bool completed;
+        if (_interruptPin != AS7341_INT_PIN_NONE)
+        {
+            completed = _interruptPending;
+            _interruptWakeups += completed ? 1 : 0;
+        }
+        else
+        {
+            // A short sync cycle may be over before we look, so AVALID first
+            completed = measurementCompleted();
+        }
+
+        if (completed)
+        {
+            _measureState = AS7341_MEASURE_READY;
+            timed(AS7341_TIMING_INTEGRATION, _measureStart);
+        }
+        else if (_interruptPin == AS7341_INT_PIN_NONE && !waitingForSync())
+        {
+            // The edge arrived some time since the previous poll
+            syncStarted(now - AS7341_SYNC_POLL_US);
+        }
+        else if (_syncTimeoutMs != 0 && now - _measureStart >= _syncTimeoutMs * 1000UL)
+        {
+            _measureState = AS7341_MEASURE_TIMEOUT;
+        }
+        else
+        {
+            _nextPollAt = now + AS7341_SYNC_POLL_US;
+        }
+        return _measureState;
+    }
 
-    if (_measureMode == AS7341_MODE_SPM)
+    if (_measureState == AS7341_MEASURE_SMUX)
     {
-        // Wait for measurement to complete
-        unsigned long startTime = millis();
-        while (!measurementCompleted() && (millis() - startTime < 1000))
+        if ((readByte(AS7341_ENABLE) & AS7341_ENABLE_SMUXEN) == 0)
+        {
+            timed(AS7341_TIMING_SMUX, _measureStart);
+            startIntegration();
+        }
+        else if (now - _measureStart >= AS7341_SMUX_TIMEOUT_MS * 1000UL)
+        {
+            _smuxLoaded = NULL;
+            _measureState = AS7341_MEASURE_TIMEOUT;
+        }
+        else
+        {
+            _nextPollAt = now + AS7341_SMUX_POLL_US;
+        }
+        return _measureState;
+    }
+
+    if (_measureMode == AS7341_MODE_SYND && _syncTriggerPin != AS7341_INT_PIN_NONE && _syncEdgesSeen < _syncEdges)
+    {
+        // SYND on our own pin: the next edge is due
+        triggerSync();
+        return _measureState;
+    }
+
+    // Integrating
+    uint32_t elapsed = now - _measureStart;
+    if (_interruptPin != AS7341_INT_PIN_NONE && !_interruptMissed)
+    {
+        if (_interruptPending)
+        {
+            _interruptWakeups++;
+            _measureState = AS7341_MEASURE_READY;
+            timed(AS7341_TIMING_INTEGRATION, _measureStart);
+        }
+        else if (elapsed >= _integrationUs + AS7341_AVALID_TIMEOUT_MS * 1000UL)
+        {
+            // INT never came (not wired, or missed): fall back to polling
+            _interruptTimeouts++;
+            _interruptMissed = true;
+            _measureStart = now;
+        }
+        else
         {
-            delay(10);
+            _nextPollAt = now + AS7341_IRQ_SPIN_US;
         }
+        return _measureState;
     }
+
+    if (measurementCompleted())
+    {
+        _measureState = AS7341_MEASURE_READY;
+        timed(AS7341_TIMING_INTEGRATION, _measureStart);
+    }
+    else if (elapsed >= _integrationUs + AS7341_AVALID_TIMEOUT_MS * 1000UL)
+    {
+        _measureState = AS7341_MEASURE_TIMEOUT;
+    }
+    else
+    {
+        _nextPollAt = now + AS7341_AVALID_POLL_US;
+    }
+    return _measureState;
+}
+
+uint32_t AS7341::nextPollMicros()
+{
+    long remaining = (long)(_nextPollAt - micros());
+    return remaining > 0 ? remaining : 0;
+}
+
+bool AS7341::result(uint16_t *data, uint8_t *astatus)
+{
+    if (_measureState != AS7341_MEASURE_READY)
+    {
+        return false;
+    }
+    TimingScope timing(this, AS7341_TIMING_READOUT);
+    uint8_t status = readAllChannels(data);
+    if (astatus != NULL)
+    {
+        *astatus = status;
+    }
+    if (_measureMode != AS7341_MODE_SPM)
+    {
+        _syncCaptures++;
+    }
+    if (_measureMode == AS7341_MODE_SYND)
+    {
+        // ITIME counts the edge-to-edge integration in 2.78 us steps
+        setBank(1);
+        uint32_t itime = readWord(AS7341_ITIME_L) | ((uint32_t)readByte(AS7341_ITIME_L + 2) << 16);
+        setBank(0);
+        _syncIntegrationUs = ((uint64_t)itime * 278) / 100;
+    }
+    _measureState = AS7341_MEASURE_IDLE;
+    return true;
+}
+
+void AS7341::continueMeasure()
+{
+    if (_interruptPin != AS7341_INT_PIN_NONE)
+    {
+        clearInterrupt();
+        _interruptPending = false;
+        _interruptMissed = false;
+    }
+
+    if (_measureMode != AS7341_MODE_SPM)
+    {
+        // The sensor re-arms by itself after each synced cycle
+        _measureStart = micros();
+        _syncEdgesSeen = 0;
+        _nextPollAt = _measureStart + AS7341_SYNC_POLL_US;
+        _measureState = AS7341_MEASURE_WAIT_SYNC;
+        return;
+    }
+
+    // SP_EN is still set: the next AVALID comes after the wait timer (when
+    // enabled) and one more integration
+    _integrationUs = integrationMicros();
+    if (readReg(AS7341_ENABLE) & AS7341_ENABLE_WEN)
+    {
+        _integrationUs += getWaitMicros();
+    }
+    _measureStart = micros();
+    _nextPollAt = _measureStart + _integrationUs;
+    _measureState = AS7341_MEASURE_INTEGRATING;
+}
+
+void AS7341::startIntegration()
+{
+    if (_measureMode != AS7341_MODE_SPM)
+    {
+        setGpioInput(true);
+    }
+
+    if (_interruptPin != AS7341_INT_PIN_NONE)
+    {
+        // Release INT from the previous cycle so the next falling edge is ours
+        clearInterrupt();
+        _interruptPending = false;
+        _interruptMissed = false;
+    }
+
+    setSpectralMeasurement(true);
+
+    _measureStart = micros();
+    if (_measureMode != AS7341_MODE_SPM)
+    {
+        // Armed: the integration starts with the next sync edge
+        _syncEdgesSeen = 0;
+        _nextPollAt = _measureStart + AS7341_SYNC_POLL_US;
+        _measureState = AS7341_MEASURE_WAIT_SYNC;
+        return;
+    }
+
+    // Nothing can be ready before the integration has run its course
+    _integrationUs = integrationMicros();
+    _nextPollAt = _measureStart + _integrationUs;
+    _measureState = AS7341_MEASURE_INTEGRATING;
+}
+
+void AS7341::syncStarted(unsigned long edgeAt)
+{
+    _measureStart = edgeAt;
+    _measureState = AS7341_MEASURE_INTEGRATING;
+    if (_measureMode == AS7341_MODE_SYNS)
+    {
+        _integrationUs = integrationMicros();
+        _nextPollAt = edgeAt + _integrationUs;
+        return;
+    }
+
+    // SYND ends on the n-th following edge. When we drive the edges
+    // ourselves, poll() issues them evenly over the programmed integration
+    // time; otherwise poll for AVALID.
+    if (_syncTriggerPin != AS7341_INT_PIN_NONE)
+    {
+        _integrationUs = integrationMicros();
+        _nextPollAt = edgeAt + _integrationUs / _syncEdges;
+        return;
+    }
+    _integrationUs = _syncTimeoutMs != 0 ? _syncTimeoutMs * 1000UL : 0x7FFFFFFFUL;
+    _nextPollAt = micros() + AS7341_AVALID_POLL_US;
 }
 
 uint16_t AS7341::getChannelData(uint8_t channel)
@@ -201,19 +615,7 @@ uint16_t AS7341::getChannelData(uint8_t channel)
 
 void AS7341::getSpectralData(uint16_t *data)
 {
-    // Add debug output
-    Serial.println("Reading spectral data from sensor...");
-
     readAllChannels(data);
-
-    // Debug the read values
-    Serial.println("Raw channel data:");
-    for (int i = 0; i < 6; i++)
-    {
-        Serial.print(i);
-        Serial.print(": ");
-        Serial.println(data[i]);
-    }
 }
 
 void AS7341::enableLED(bool enable)
@@ -233,23 +635,19 @@ void AS7341::enableLED(bool enable)
     setBank(0);
 }
 
-void AS7341::setLEDCurrent(uint8_t current)
+void AS7341::setLEDCurrent(uint16_t current)
 {
-    // Clamp current to valid range (4-258 mA)
-    if (current > 258)
-        current = 258;
-    if (current < 4)
-        current = 4;
+    // Clamp current to valid range (4-258 mA), as apply() does
+    current = current > 258 ? 258 : (current < 4 ? 4 : current);
 
     setBank(1);
     modifyReg(AS7341_CONFIG, AS7341_CONFIG_LED_SEL, true);
 
     // Set LED current (current - 4) / 2
     uint8_t ledValue = AS7341_LED_LED_ACT | ((current - 4) / 2);
-    writeByte(AS7341_LED, ledValue);
+    writeReg(AS7341_LED, ledValue);
 
     setBank(0);
-    delay(100);
 }
 
 void AS7341::setFlickerDetection(bool flag)
@@ -259,49 +657,28 @@ void AS7341::setFlickerDetection(bool flag)
 
 uint8_t AS7341::getFlickerFrequency()
 {
+    BlockingScope scope(this);
+
     modifyReg(AS7341_CFG_0, AS7341_CFG_0_LOW_POWER, false);
     setSpectralMeasurement(false);
-    writeByte(AS7341_CFG_6, AS7341_CFG_6_SMUX_CMD_WRITE);
+    writeReg(AS7341_CFG_6, AS7341_CFG_6_SMUX_CMD_WRITE);
     channelSelect("FD");
     setSmux(true);
     setSpectralMeasurement(true);
     setFlickerDetection(true);
 
     // Wait for measurement to complete
-    unsigned long startTime = millis();
-    bool measurementValid = false;
-
-    while ((millis() - startTime < 1000) && !measurementValid)
-    {
-        uint8_t fdStatus = readByte(AS7341_FD_STATUS);
-        if (fdStatus & AS7341_FD_STATUS_FD_MEAS_VALID)
-        {
-            measurementValid = true;
-        }
-        delay(10);
-    }
-
-    if (!measurementValid)
+    if (!waitForBits(AS7341_FD_STATUS, AS7341_FD_STATUS_FD_MEAS_VALID, true, 1000, AS7341_FD_POLL_US))
     {
         setFlickerDetection(false);
         return 0;
     }
 
     // Wait for calculation to complete
-    startTime = millis();
-    bool calculationValid = false;
     uint8_t fdStatus = 0;
-
-    while ((millis() - startTime < 1000) && !calculationValid)
-    {
-        fdStatus = readByte(AS7341_FD_STATUS);
-        if ((fdStatus & AS7341_FD_STATUS_FD_100_VALID) ||
-            (fdStatus & AS7341_FD_STATUS_FD_120_VALID))
-        {
-            calculationValid = true;
-        }
-        delay(10);
-    }
+    bool calculationValid = waitForBits(AS7341_FD_STATUS,
+                                        AS7341_FD_STATUS_FD_100_VALID | AS7341_FD_STATUS_FD_120_VALID,
+                                        true, 1000, AS7341_FD_POLL_US, &fdStatus);
 
     setFlickerDetection(false);
     writeByte(AS7341_FD_STATUS, 0x3C); // Clear all FD STATUS bits
@@ -325,6 +702,93 @@ uint8_t AS7341::getFlickerFrequency()
     return 0;
 }
 
+float AS7341::beginFlickerCapture(float sampleRateHz, uint8_t gain)
+{
+    BlockingScope scope(this);
+
+    uint32_t steps = 1;
+    if (sampleRateHz > 0.0f)
+    {
+        steps = (uint32_t)(1e9f / (sampleRateHz * AS7341_FD_TIME_STEP_NS) + 0.5f);
+    }
+    if (steps < 1)
+    {
+        steps = 1;
+    }
+    else if (steps > 2048)
+    {
+        steps = 2048; // FD_TIME is 11 bits
+    }
+    uint16_t fdTime = steps - 1;
+    if (gain > AS7341_FD_GAIN_MAX)
+    {
+        gain = AS7341_FD_GAIN_MAX;
+    }
+
+    modifyReg(AS7341_CFG_0, AS7341_CFG_0_LOW_POWER, false);
+    setSpectralMeasurement(false);
+    setFlickerDetection(false);
+    writeReg(AS7341_CFG_6, AS7341_CFG_6_SMUX_CMD_WRITE);
+    channelSelect("FD");
+    setSmux(true);
+
+    writeReg(AS7341_FD_TIME_1, fdTime & 0xFF);
+    writeReg(AS7341_FD_TIME_2, (gain << 3) | (fdTime >> 8));
+    writeReg(AS7341_FIFO_MAP, 0x00); // Only FD samples in the FIFO
+    writeReg(AS7341_FD_CFG0, AS7341_FD_CFG0_FIFO_WRITE_FD);
+    writeByte(AS7341_CONTROL, AS7341_CONTROL_CLEAR_FIFO);
+    setFlickerDetection(true);
+
+    return 1e9f / (steps * AS7341_FD_TIME_STEP_NS);
+}
+
+void AS7341::endFlickerCapture()
+{
+    setFlickerDetection(false);
+    writeReg(AS7341_FD_CFG0, 0x00);
+    writeByte(AS7341_CONTROL, AS7341_CONTROL_CLEAR_FIFO);
+    writeByte(AS7341_FD_STATUS, 0x3C); // Clear all FD STATUS bits
+}
+
+uint8_t AS7341::getFifoLevel()
+{
+    return readByte(AS7341_FIFO_LVL);
+}
+
+uint8_t AS7341::readFifo(uint16_t *data, uint8_t count)
+{
+    if (count > AS7341_FIFO_BURST)
+    {
+        count = AS7341_FIFO_BURST;
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // FDATA_L/H wrap onto each other, so one burst pops 'count' entries
+    TimingScope timing(this, AS7341_TIMING_REG_READ);
+    _wire->beginTransmission(_address);
+    _wire->write(AS7341_FDATA_L);
+    if (_wire->endTransmission() != 0)
+    {
+        return 0;
+    }
+    uint8_t bytes = _wire->requestFrom(_address, (uint8_t)(count * 2));
+    for (uint8_t i = 0; i < bytes / 2; i++)
+    {
+        uint16_t low = _wire->read();
+        uint16_t high = _wire->read();
+        data[i] = (high << 8) | low;
+    }
+    return bytes / 2;
+}
+
+bool AS7341::fifoOverflow()
+{
+    return (readByte(AS7341_STATUS_6) & AS7341_STATUS_6_FIFO_OV) != 0;
+}
+
 void AS7341::setGpioInput(bool enable)
 {
     uint8_t mask = AS7341_GPIO_2_GPIO_OUT;
@@ -332,11 +796,12 @@ void AS7341::setGpioInput(bool enable)
     {
         mask |= AS7341_GPIO_2_GPIO_IN_EN;
     }
-    writeByte(AS7341_GPIO_2, mask);
+    writeReg(AS7341_GPIO_2, mask);
 }
 
 bool AS7341::getGpioValue()
 {
+    // GPIO_IN follows the pin, so always go to the bus for it
     return (readByte(AS7341_GPIO_2) & AS7341_GPIO_2_GPIO_IN) != 0;
 }
 
@@ -347,7 +812,7 @@ void AS7341::setGpioOutput(bool inverted)
     {
         mask |= AS7341_GPIO_2_GPIO_INV;
     }
-    writeByte(AS7341_GPIO_2, mask);
+    writeReg(AS7341_GPIO_2, mask);
 }
 
 void AS7341::setGpioInverted(bool flag)
@@ -357,7 +822,7 @@ void AS7341::setGpioInverted(bool flag)
 
 void AS7341::setGpioMask(uint8_t mask)
 {
-    writeByte(AS7341_GPIO_2, mask);
+    writeReg(AS7341_GPIO_2, mask);
 }
 
 void AS7341::setWen(bool flag)
@@ -367,7 +832,114 @@ void AS7341::setWen(bool flag)
 
 void AS7341::setWtime(uint8_t code)
 {
-    writeByte(AS7341_WTIME, code);
+    writeReg(AS7341_WTIME, code);
+}
+
+// External sync
+//
+// In SYNS and SYND the sensor arms on SP_EN and sits in WAIT_SYNC until a
+// falling edge arrives on its GPIO pin. poll() reports that as
+// AS7341_MEASURE_WAIT_SYNC and moves on to the integration once STAT shows
+// the edge has been seen (or immediately when triggerSync() produced it).
+
+void AS7341::setSyncEdges(uint8_t edges)
+{
+    _syncEdges = edges > 0 ? edges : 1;
+    setBank(1);
+    writeReg(AS7341_EDGE, _syncEdges);
+    setBank(0);
+}
+
+void AS7341::setSyncTimeout(uint32_t ms)
+{
+    _syncTimeoutMs = ms;
+}
+
+void AS7341::setSyncTriggerPin(int pin)
+{
+    _syncTriggerPin = pin;
+    if (pin != AS7341_INT_PIN_NONE)
+    {
+        // Idle high; the sensor reacts to the falling edge
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, HIGH);
+    }
+}
+
+void AS7341::triggerSync()
+{
+    BlockingScope scope(this);
+
+    if (_syncTriggerPin == AS7341_INT_PIN_NONE)
+    {
+        return;
+    }
+    unsigned long edgeAt = micros();
+    digitalWrite(_syncTriggerPin, LOW);
+    sleepMicros(AS7341_SYNC_PULSE_US);
+    digitalWrite(_syncTriggerPin, HIGH);
+
+    if (_measureState == AS7341_MEASURE_WAIT_SYNC)
+    {
+        syncStarted(edgeAt);
+    }
+    else if (_measureState == AS7341_MEASURE_INTEGRATING && _measureMode == AS7341_MODE_SYND)
+    {
+        if (++_syncEdgesSeen >= _syncEdges)
+        {
+            _nextPollAt = micros(); // Closing edge: the result is due now
+        }
+        else
+        {
+            _nextPollAt = _measureStart + (uint64_t)_integrationUs * (_syncEdgesSeen + 1) / _syncEdges;
+        }
+    }
+}
+
+bool AS7341::waitingForSync()
+{
+    setBank(1);
+    bool waiting = (readByte(AS7341_STAT) & AS7341_STAT_WAIT_SYNC) != 0;
+    setBank(0);
+    return waiting;
+}
+
+uint32_t AS7341::getSyncIntegrationMicros()
+{
+    return _syncIntegrationUs;
+}
+
+uint32_t AS7341::getSyncCaptures()
+{
+    return _syncCaptures;
+}
+
+void AS7341::setWaitMicros(uint32_t us)
+{
+    // Wait = (WTIME + 1) * 2.78 ms, or 16x that with WLONG for waits
+    // beyond 711 ms
+    uint32_t steps = us / AS7341_WTIME_STEP_US;
+    bool wlong = steps > 256;
+    if (wlong)
+    {
+        steps /= 16;
+    }
+    if (steps > 256)
+    {
+        steps = 256;
+    }
+    setWtime(steps > 0 ? steps - 1 : 0);
+    modifyReg(AS7341_CFG_0, AS7341_CFG_0_WLONG, wlong);
+}
+
+uint32_t AS7341::getWaitMicros()
+{
+    uint32_t us = (readReg(AS7341_WTIME) + 1UL) * AS7341_WTIME_STEP_US;
+    if (readReg(AS7341_CFG_0) & AS7341_CFG_0_WLONG)
+    {
+        us *= 16;
+    }
+    return us;
 }
 
 void AS7341::checkInterrupt()
@@ -393,7 +965,7 @@ void AS7341::setInterruptPersistence(uint8_t value)
 {
     if (value <= 15)
     {
-        writeByte(AS7341_PERS, value);
+        writeReg(AS7341_PERS, value);
     }
 }
 
@@ -401,7 +973,7 @@ void AS7341::setSpectralThresholdChannel(uint8_t value)
 {
     if (value <= 4)
     {
-        writeByte(AS7341_CFG_12, value);
+        writeReg(AS7341_CFG_12, value);
     }
 }
 
@@ -411,14 +983,13 @@ void AS7341::setThresholds(uint16_t lo, uint16_t hi)
     {
         writeWord(AS7341_SP_TH_LOW, lo);
         writeWord(AS7341_SP_TH_HIGH, hi);
-        delay(20);
     }
 }
 
 void AS7341::getSynsInt()
 {
     setBank(1);
-    writeByte(AS7341_CONFIG, AS7341_CONFIG_INT_SEL | AS7341_CONFIG_INT_MODE_SYNS);
+    writeReg(AS7341_CONFIG, AS7341_CONFIG_INT_SEL | AS7341_CONFIG_INT_MODE_SYNS);
     setBank(0);
 }
 
@@ -426,6 +997,7 @@ void AS7341::getSynsInt()
 
 uint8_t AS7341::readByte(uint8_t reg)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_READ);
     _wire->beginTransmission(_address);
     _wire->write(reg);
     if (_wire->endTransmission() != 0)
@@ -438,11 +1010,14 @@ uint8_t AS7341::readByte(uint8_t reg)
         return 0; // Error
     }
 
-    return _wire->read();
+    uint8_t value = _wire->read();
+    updateShadow(reg, value);
+    return value;
 }
 
 uint16_t AS7341::readWord(uint8_t reg)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_READ);
     _wire->beginTransmission(_address);
     _wire->write(reg);
     if (_wire->endTransmission() != 0)
@@ -461,23 +1036,24 @@ uint16_t AS7341::readWord(uint8_t reg)
     return (high << 8) | low; // Little endian
 }
 
-void AS7341::readAllChannels(uint16_t *data)
+uint8_t AS7341::readAllChannels(uint16_t *data)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_READ);
     // Reading ASTATUS latches the channel counts
     _wire->beginTransmission(_address);
     _wire->write(AS7341_ASTATUS);
     if (_wire->endTransmission() != 0)
     {
-        return; // Error
+        return 0; // Error
     }
 
     if (_wire->requestFrom(_address, (uint8_t)13) != 13)
     {
-        return; // Error
+        return 0; // Error
     }
 
-    // Skip ASTATUS byte
-    _wire->read();
+    // ASTATUS: saturation flag and the gain the counts were taken with
+    uint8_t astatus = _wire->read();
 
     // Read 6 channels (12 bytes)
     for (int i = 0; i < 6; i++)
@@ -486,37 +1062,45 @@ void AS7341::readAllChannels(uint16_t *data)
         uint16_t high = _wire->read();
         data[i] = (high << 8) | low;
     }
+    return astatus;
 }
 
 bool AS7341::writeByte(uint8_t reg, uint8_t value)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_WRITE);
     _wire->beginTransmission(_address);
     _wire->write(reg);
     _wire->write(value);
     if (_wire->endTransmission() != 0)
     {
+        invalidateReg(reg);
         return false; // Error
     }
-    delay(10);
+    updateShadow(reg, value);
     return true;
 }
 
 bool AS7341::writeWord(uint8_t reg, uint16_t value)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_WRITE);
     _wire->beginTransmission(_address);
     _wire->write(reg);
     _wire->write(value & 0xFF);        // Low byte
     _wire->write((value >> 8) & 0xFF); // High byte
     if (_wire->endTransmission() != 0)
     {
+        invalidateReg(reg);
+        invalidateReg(reg + 1);
         return false; // Error
     }
-    delay(20);
+    updateShadow(reg, value & 0xFF);
+    updateShadow(reg + 1, (value >> 8) & 0xFF);
     return true;
 }
 
 bool AS7341::writeBurst(uint8_t reg, const uint8_t *data, uint8_t length)
 {
+    TimingScope timing(this, AS7341_TIMING_REG_WRITE);
     _wire->beginTransmission(_address);
     _wire->write(reg);
     for (uint8_t i = 0; i < length; i++)
@@ -525,15 +1109,22 @@ bool AS7341::writeBurst(uint8_t reg, const uint8_t *data, uint8_t length)
     }
     if (_wire->endTransmission() != 0)
     {
+        for (uint8_t i = 0; i < length; i++)
+        {
+            invalidateReg(reg + i);
+        }
         return false; // Error
     }
-    delay(100);
+    for (uint8_t i = 0; i < length; i++)
+    {
+        updateShadow(reg + i, data[i]);
+    }
     return true;
 }
 
 void AS7341::modifyReg(uint8_t reg, uint8_t mask, bool flag)
 {
-    uint8_t data = readByte(reg);
+    uint8_t data = readReg(reg);
     if (flag)
     {
         data |= mask; // Set the bit(s)
@@ -542,10 +1133,318 @@ void AS7341::modifyReg(uint8_t reg, uint8_t mask, bool flag)
     {
         data &= (~mask); // Reset the bit(s)
     }
-    writeByte(reg, data);
+    writeReg(reg, data);
 }
 
 void AS7341::setBank(uint8_t bank)
 {
+    // Free when the bank is already selected, one write otherwise
     modifyReg(AS7341_CFG_0, AS7341_CFG_0_REG_BANK, bank != 0);
 }
+
+// Register shadow cache
+//
+// Configuration registers only change when we write them, so their last
+// written (or read) value is kept here and read-modify-write cycles are
+// served without touching the bus. Status, data and FIFO registers are
+// never shadowed and always go to the device.
+
+void AS7341::invalidateCache()
+{
+    memset(_shadowValid, 0, sizeof(_shadowValid));
+    _smuxLoaded = NULL;
+}
+
+uint32_t AS7341::getSmuxSkips()
+{
+    return _smuxSkips;
+}
+
+bool AS7341::isShadowed(uint8_t reg)
+{
+    switch (reg)
+    {
+    case AS7341_CONFIG:
+    case AS7341_EDGE:
+    case AS7341_GPIO:
+    case AS7341_LED:
+    case AS7341_ENABLE:
+    case AS7341_ATIME:
+    case AS7341_WTIME:
+    case AS7341_SP_TH_L_LSB:
+    case AS7341_SP_TH_L_MSB:
+    case AS7341_SP_TH_H_LSB:
+    case AS7341_SP_TH_H_MSB:
+    case AS7341_CFG_0:
+    case AS7341_CFG_1:
+    case AS7341_CFG_3:
+    case AS7341_CFG_6:
+    case AS7341_CFG_8:
+    case AS7341_CFG_9:
+    case AS7341_CFG_10:
+    case AS7341_CFG_12:
+    case AS7341_PERS:
+    case AS7341_GPIO_2:
+    case AS7341_ASTEP_L:
+    case AS7341_ASTEP_H:
+    case AS7341_AGC_GAIN_MAX:
+    case AS7341_AZ_CONFIG:
+    case AS7341_FD_CFG0:
+    case AS7341_FD_TIME_1:
+    case AS7341_FD_TIME_2:
+    case AS7341_INTENAB:
+    case AS7341_FIFO_MAP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint8_t AS7341::volatileBits(uint8_t reg)
+{
+    // Bits the device changes on its own inside otherwise static registers
+    switch (reg)
+    {
+    case AS7341_ENABLE:
+        return AS7341_ENABLE_SMUXEN; // Self-clears when the SMUX command is done
+    case AS7341_GPIO_2:
+        return AS7341_GPIO_2_GPIO_IN; // Follows the pin level
+    default:
+        return 0x00;
+    }
+}
+
+void AS7341::updateShadow(uint8_t reg, uint8_t value)
+{
+    if (!isShadowed(reg))
+    {
+        return;
+    }
+    uint8_t index = reg - AS7341_SHADOW_BASE;
+    _shadow[index] = value & ~volatileBits(reg);
+    _shadowValid[index >> 3] |= (1 << (index & 0x07));
+}
+
+void AS7341::invalidateReg(uint8_t reg)
+{
+    if (!isShadowed(reg))
+    {
+        return;
+    }
+    uint8_t index = reg - AS7341_SHADOW_BASE;
+    _shadowValid[index >> 3] &= ~(1 << (index & 0x07));
+}
+
+bool AS7341::shadowKnown(uint8_t reg)
+{
+    if (!isShadowed(reg))
+    {
+        return false;
+    }
+    uint8_t index = reg - AS7341_SHADOW_BASE;
+    return (_shadowValid[index >> 3] & (1 << (index & 0x07))) != 0;
+}
+
+bool AS7341::shadowMatches(uint8_t reg, uint8_t value)
+{
+    // Writes that set a volatile bit (e.g. SMUXEN) are commands and never match
+    if (!isShadowed(reg) || (value & volatileBits(reg)) != 0)
+    {
+        return false;
+    }
+    uint8_t index = reg - AS7341_SHADOW_BASE;
+    return (_shadowValid[index >> 3] & (1 << (index & 0x07))) && _shadow[index] == value;
+}
+
+uint8_t AS7341::readReg(uint8_t reg)
+{
+    if (isShadowed(reg))
+    {
+        uint8_t index = reg - AS7341_SHADOW_BASE;
+        if (_shadowValid[index >> 3] & (1 << (index & 0x07)))
+        {
+            return _shadow[index];
+        }
+    }
+    return readByte(reg);
+}
+
+bool AS7341::writeReg(uint8_t reg, uint8_t value)
+{
+    // Skip the transaction when the device already holds this value
+    if (shadowMatches(reg, value))
+    {
+        return true;
+    }
+    return writeByte(reg, value);
+}
+
+// Timing layer
+//
+// The chip only needs time after power-on, for SMUX commands and for the
+// integration itself. Each of those is waited for on its completion flag
+// and the time actually spent blocked is accounted per public call.
+
+AS7341::BlockingScope::BlockingScope(AS7341 *device)
+{
+    _device = device;
+    if (_device->_callDepth++ == 0)
+    {
+        _device->_callBlockedUs = 0;
+    }
+}
+
+AS7341::BlockingScope::~BlockingScope()
+{
+    if (--_device->_callDepth == 0)
+    {
+        _device->_lastBlockedUs = _device->_callBlockedUs;
+    }
+}
+
+AS7341::TimingScope::TimingScope(AS7341 *device, uint8_t event)
+{
+    _device = device;
+    _event = event;
+    _start = device->_timing != NULL ? micros() : 0;
+}
+
+AS7341::TimingScope::~TimingScope()
+{
+    _device->timed(_event, _start);
+}
+
+void AS7341::setTimingCallback(AS7341TimingFn fn, void *arg)
+{
+    _timing = fn;
+    _timingArg = arg;
+}
+
+void AS7341::timed(uint8_t event, unsigned long start)
+{
+    if (_timing != NULL)
+    {
+        _timing(_timingArg, event, micros() - start);
+    }
+}
+
+uint32_t AS7341::getBusClock()
+{
+    return _wire->getClock();
+}
+
+uint32_t AS7341::getLastBlockedMicros()
+{
+    return _lastBlockedUs;
+}
+
+uint32_t AS7341::getTotalBlockedMicros()
+{
+    return _totalBlockedUs;
+}
+
+void AS7341::sleepMicros(uint32_t us)
+{
+    unsigned long start = micros();
+    if (us >= 1000)
+    {
+        delay(us / 1000); // Yield to other tasks for the bulk of the wait
+    }
+    if (us % 1000)
+    {
+        delayMicroseconds(us % 1000);
+    }
+    uint32_t elapsed = micros() - start;
+    _callBlockedUs += elapsed;
+    _totalBlockedUs += elapsed;
+}
+
+bool AS7341::waitForBits(uint8_t reg, uint8_t mask, bool set, uint32_t timeoutMs, uint32_t pollUs, uint8_t *value)
+{
+    unsigned long startTime = millis();
+    while (true)
+    {
+        uint8_t data = readByte(reg);
+        if (value != NULL)
+        {
+            *value = data;
+        }
+        if (((data & mask) != 0) == set)
+        {
+            return true;
+        }
+        if (millis() - startTime >= timeoutMs)
+        {
+            return false;
+        }
+        sleepMicros(pollUs);
+    }
+}
+
+bool AS7341::waitSmuxComplete()
+{
+    return waitForBits(AS7341_ENABLE, AS7341_ENABLE_SMUXEN, false, AS7341_SMUX_TIMEOUT_MS, AS7341_SMUX_POLL_US);
+}
+
+uint32_t AS7341::integrationMicros()
+{
+    // (ATIME + 1) * (ASTEP + 1) * 2.78 us, from the shadow rather than the bus
+    uint32_t astep = ((uint32_t)readReg(AS7341_ASTEP_H) << 8) | readReg(AS7341_ASTEP_L);
+    uint32_t atime = readReg(AS7341_ATIME);
+    return ((atime + 1) * (astep + 1) * 278UL) / 100;
+}
+
+// Completion interrupt
+//
+// With APERS = 0 and SP_IEN set the sensor pulls INT low at the end of
+// every spectral cycle. The ISR only raises a flag; the waiting code spins
+// on that flag (see poll()) without touching the bus.
+
+void IRAM_ATTR AS7341::onInterrupt(void *arg)
+{
+    ((AS7341 *)arg)->_interruptPending = true;
+}
+
+void AS7341::enableMeasurementInterrupt(int pin)
+{
+    _interruptPin = pin;
+    _interruptPending = false;
+    setInterruptPersistence(0); // Interrupt on every cycle
+    setSpectralInterrupt(true);
+    clearInterrupt();
+    pinMode(pin, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(pin), onInterrupt, this, FALLING);
+}
+
+void AS7341::disableMeasurementInterrupt()
+{
+    if (_interruptPin == AS7341_INT_PIN_NONE)
+    {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(_interruptPin));
+    setSpectralInterrupt(false);
+    clearInterrupt();
+    _interruptPin = AS7341_INT_PIN_NONE;
+    _interruptPending = false;
+}
+
+bool AS7341::interruptPending()
+{
+    return _interruptPending;
+}
+
+uint32_t AS7341::getInterruptWakeups()
+{
+    return _interruptWakeups;
+}
+
+uint32_t AS7341::getInterruptTimeouts()
+{
+    return _interruptTimeouts;
+}
+
+uint32_t AS7341::getCompletionPolls()
+{
+    return _completionPolls;
+}